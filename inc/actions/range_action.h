@@ -53,12 +53,18 @@ typedef struct RangeAction
   /** Action type. */
   RangeActionType type;
 
-  /** Selections before the action, starting from
-   * objects intersecting with the start position and
-   * ending in infinity. */
+  /**
+   * Selections before the action.
+   *
+   * Only contains the objects that get split,
+   * deleted or clamped by the action. All other
+   * objects after the range start are shifted in
+   * place by the range size and are not stored.
+   */
   TimelineSelections * sel_before;
 
-  /** Selections after the action. */
+  /** Selections after the action (the resulting
+   * parts of the objects in @ref sel_before). */
   TimelineSelections * sel_after;
 
   /** A copy of the transport at the start of the
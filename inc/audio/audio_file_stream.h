@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+/**
+ * \file
+ *
+ * Streaming playback of audio files.
+ */
+
+#ifndef __AUDIO_AUDIO_FILE_STREAM_H__
+#define __AUDIO_AUDIO_FILE_STREAM_H__
+
+#include <stdbool.h>
+
+#include "utils/types.h"
+
+#include "zix/ring.h"
+#include "zix/sem.h"
+#include "zix/thread.h"
+#include <samplerate.h>
+#include <sndfile.h>
+
+/**
+ * @addtogroup audio
+ *
+ * @{
+ */
+
+/**
+ * Number of frames decoded at a time.
+ */
+#define AUDIO_FILE_STREAM_CHUNK_FRAMES 4096
+
+/**
+ * Plays back an audio file without loading it into
+ * memory.
+ *
+ * A decoder thread reads the file in chunks,
+ * resamples it to the engine's sample rate and
+ * writes stereo frames to a ring buffer that the
+ * engine reads from, so memory usage does not
+ * depend on the length of the file.
+ */
+typedef struct AudioFileStream
+{
+  /** Absolute path of the file. */
+  char * abs_path;
+
+  SNDFILE * sndfile;
+  SF_INFO   sfinfo;
+
+  /** Resampler, if the sample rate differs from the
+   * engine's. */
+  SRC_STATE * src_state;
+
+  /** Output/input sample rate ratio. */
+  double src_ratio;
+
+  /** Number of frames the file will have in the
+   * engine's sample rate. */
+  unsigned_frame_t num_out_frames;
+
+  /** Interleaved stereo frames, written by the
+   * decoder and read by the engine. */
+  ZixRing * ring;
+
+  /** Posted by the engine after reading, and on
+   * free. */
+  ZixSem sem;
+
+  ZixThread thread;
+  bool      thread_started;
+
+  /** Decode buffers. */
+  float * file_buf;
+  float * stereo_buf;
+  float * out_buf;
+  size_t  out_buf_frames;
+
+  /** Frames at the start of stereo_buf that the
+   * resampler has not consumed yet. */
+  size_t num_pending_frames;
+
+  /** Set when the decoder thread should exit. */
+  volatile gint stop;
+
+  /** Set by the decoder thread when the whole file
+   * has been written to the ring. */
+  volatile gint decoded;
+} AudioFileStream;
+
+/**
+ * Opens the given file and starts decoding it.
+ *
+ * The first chunk is decoded synchronously so
+ * playback can start immediately.
+ *
+ * @return The stream or NULL if the file could not
+ *   be opened.
+ */
+AudioFileStream *
+audio_file_stream_new (
+  const char * abs_path,
+  samplerate_t samplerate,
+  GError **    error);
+
+/**
+ * Adds up to @p nframes stereo frames to the given
+ * buffers, multiplied by @p gain.
+ *
+ * Frames not yet decoded are left untouched.
+ *
+ * Realtime function.
+ *
+ * @return The number of frames added.
+ */
+HOT NONNULL nframes_t
+audio_file_stream_mix (
+  AudioFileStream * self,
+  float *           l,
+  float *           r,
+  const nframes_t   nframes,
+  const float       gain);
+
+/**
+ * Returns whether all frames have been read.
+ */
+NONNULL bool
+audio_file_stream_is_finished (AudioFileStream * self);
+
+/**
+ * Stops the decoder thread and frees the stream.
+ */
+NONNULL void
+audio_file_stream_free (AudioFileStream * self);
+
+/**
+ * @}
+ */
+
+#endif
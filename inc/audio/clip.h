@@ -12,6 +12,7 @@
 
 #include <stdbool.h>
 
+#include "audio/peak_cache.h"
 #include "utils/audio.h"
 #include "utils/types.h"
 #include "utils/yaml.h"
@@ -96,6 +97,25 @@ typedef struct AudioClip
    * @see AudioClip.frames_written.
    */
   gint64 last_write;
+
+  /**
+   * Min/max peaks of the frames, used for drawing.
+   *
+   * Built in the background, so it may be NULL.
+   *
+   * @see audio_clip_build_peaks().
+   */
+  PeakCache * peaks;
+
+  /** Number of peak builds queued or running. */
+  int num_peak_jobs;
+
+  /** Incremented when the peaks are invalidated,
+   * so that outdated builds are discarded. */
+  int peaks_generation;
+
+  /** Peak file for the current frames, if any. */
+  char * peaks_path;
 } AudioClip;
 
 static const cyaml_schema_field_t audio_clip_fields_schema[] = {
@@ -174,6 +194,45 @@ audio_clip_update_channel_caches (
   AudioClip * self,
   size_t      start_from);
 
+/**
+ * Loads the peak cache of the clip from its peak
+ * file, or starts building it in a background
+ * thread and saves it to the peak file, discarding
+ * the current one.
+ *
+ * Peak files are keyed by a hash of the frames, so
+ * they always match the frames they are loaded
+ * for.
+ *
+ * To be called when the clip's frames are loaded or
+ * changed.
+ */
+NONNULL void
+audio_clip_build_peaks (AudioClip * self);
+
+/**
+ * Waits for any peak builds to finish and frees
+ * the peak cache.
+ *
+ * To be called before freeing the clip's frames.
+ */
+NONNULL void
+audio_clip_free_peaks (AudioClip * self);
+
+/**
+ * Returns the peak cache of the clip, or NULL if it
+ * is not built yet.
+ *
+ * The cache stays valid until
+ * audio_clip_release_peaks() is called, which must
+ * be called even if NULL is returned.
+ */
+NONNULL PeakCache *
+audio_clip_acquire_peaks (AudioClip * self);
+
+NONNULL void
+audio_clip_release_peaks (AudioClip * self);
+
 /**
  * Shows a dialog with info on how to edit a file,
  * with an option to open an app launcher.
@@ -250,6 +250,21 @@ graph_on_reached_terminal_node (Graph * self);
 void
 graph_update_latencies (Graph * self, bool use_setup_nodes);
 
+/**
+ * Updates the latencies after the latency of the
+ * given plugins changed.
+ *
+ * Only the nodes of the given plugins and the
+ * nodes whose route latency changes as a result
+ * (the ones feeding into them) are visited.
+ *
+ * @param plugins Array of Plugin pointers.
+ */
+void
+graph_update_latencies_for_plugins (
+  Graph *     self,
+  GPtrArray * plugins);
+
 /*
  * Adds the graph nodes and connections, then
  * rechains.
@@ -57,8 +57,25 @@ typedef enum MeterAlgorithm
   METER_ALGORITHM_K,
 } MeterAlgorithm;
 
+/**
+ * Meter values of a processing cycle.
+ */
+typedef struct MeterSnapshot
+{
+  /** Current value (amplitude). */
+  float amp;
+
+  /** Max/peak value (amplitude). */
+  float max_amp;
+} MeterSnapshot;
+
 /**
  * A Meter used by a single GUI element.
+ *
+ * Audio and CV meters are subscribed to their port
+ * and processed by the audio thread at the end of
+ * each cycle, which publishes the result in
+ * Meter.snapshot. The GUI only reads the snapshot.
  */
 typedef struct Meter
 {
@@ -99,11 +116,63 @@ typedef struct Meter
 
   gint64 last_midi_trigger_time;
 
+  /** Values published by the audio thread. */
+  MeterSnapshot snapshot;
+
+  /**
+   * Sequence number of Meter.snapshot.
+   *
+   * Odd while the audio thread is writing the
+   * snapshot, and 0 if nothing was published
+   * yet.
+   */
+  volatile gint snapshot_seq;
+
+  /** Whether subscribed to the port. */
+  bool active;
+
+  /** Engine cycle the meter was last unsubscribed
+   * at. */
+  uint_fast64_t unsubscribed_cycle;
+
 } Meter;
 
+/**
+ * Creates a meter for the port and subscribes it
+ * to the port if audio or CV.
+ */
 Meter *
 meter_new_for_port (Port * port);
 
+/**
+ * Runs the meter DSP on the given frames and
+ * publishes the result.
+ *
+ * To be called by the audio thread only.
+ */
+HOT NONNULL void
+meter_process (
+  Meter *         self,
+  float *         buf,
+  const nframes_t nframes);
+
+/**
+ * Sets whether the meter should be processed.
+ *
+ * Inactive meters keep their last values and cost
+ * nothing on the audio thread.
+ */
+NONNULL void
+meter_set_active (Meter * self, bool active);
+
+/**
+ * Unsubscribes all meters from the port.
+ *
+ * To be called when freeing the port.
+ */
+NONNULL void
+meter_detach_all_from_port (Port * port);
+
 /**
  * Get the current meter value.
  *
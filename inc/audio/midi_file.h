@@ -27,15 +27,101 @@
 #define __AUDIO_MIDI_FILE_H__
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "ext/midilib/src/midifile.h"
 
+#include <glib.h>
+
 /**
  * @addtogroup audio
  *
  * @{
  */
 
+/**
+ * A note read from a MIDI file track.
+ */
+typedef struct MidiFileNote
+{
+  /** Start position in MIDI file ticks. */
+  int64_t start;
+
+  /** End position in MIDI file ticks, or -1 if the
+   * note was not ended. */
+  int64_t end;
+
+  int pitch;
+  int velocity;
+} MidiFileNote;
+
+/**
+ * The events of a MIDI file track.
+ */
+typedef struct MidiFileTrack
+{
+  /** Index of the track in the file. */
+  int idx;
+
+  /** Whether the track has any data (see
+   * midi_file_track_has_data()). */
+  bool has_data;
+
+  /** Track name, or NULL. */
+  char * name;
+
+  /** Notes in the order they were started. */
+  MidiFileNote * notes;
+  int            num_notes;
+  size_t         notes_size;
+
+  /** Position of the end of sequence event in MIDI
+   * file ticks, or -1 if there was none. */
+  int64_t end_pos;
+
+  /** Position of the last event in MIDI file
+   * ticks. */
+  int64_t last_event_pos;
+} MidiFileTrack;
+
+/**
+ * A MIDI file read in a single pass.
+ */
+typedef struct MidiFile
+{
+  /** Ticks per quarter note. */
+  int ppqn;
+
+  /** All tracks in the file. */
+  MidiFileTrack ** tracks;
+  int              num_tracks;
+} MidiFile;
+
+/**
+ * Reads all the tracks of the given MIDI file.
+ */
+MidiFile *
+midi_file_new (const char * abs_path, GError ** error);
+
+/**
+ * Returns the number of tracks with data.
+ */
+NONNULL int
+midi_file_get_num_nonempty_tracks (const MidiFile * self);
+
+/**
+ * Returns the track with data at the given index,
+ * counting only tracks with data, or NULL if there
+ * is no such track.
+ */
+NONNULL const MidiFileTrack *
+midi_file_get_nonempty_track (
+  const MidiFile * self,
+  int              idx);
+
+NONNULL void
+midi_file_free (MidiFile * self);
+
 /**
  * Returns whether the given track in the midi file
  * has data.
@@ -93,6 +93,42 @@ static const cyaml_schema_value_t
 };
 #endif
 
+/**
+ * An entry in a MidiMappingsTable.
+ */
+typedef struct MidiMappingsTableEntry
+{
+  MidiMapping * mapping;
+
+  /** Index of the next entry with the same key, or
+   * -1. */
+  int next;
+} MidiMappingsTableEntry;
+
+/**
+ * Lookup table from the status and data bytes of a
+ * MIDI message to the mappings bound to it.
+ *
+ * Entries with the same key are chained in mapping
+ * order.
+ */
+typedef struct MidiMappingsTable
+{
+  /**
+   * Index of the first entry for each data byte, per
+   * status byte (minus 0x80), or NULL if no mapping
+   * uses the status byte.
+   *
+   * The index is -1 if nothing is mapped to the
+   * data byte.
+   */
+  int * heads[128];
+
+  MidiMappingsTableEntry * entries;
+  int                      num_entries;
+  int                      entries_size;
+} MidiMappingsTable;
+
 /**
  * All MIDI mappings in Zrythm.
  */
@@ -103,6 +139,25 @@ typedef struct MidiMappings
   MidiMapping ** mappings;
   size_t         mappings_size;
   int            num_mappings;
+
+  /**
+   * Lookup table used by midi_mappings_apply().
+   *
+   * Mappings appended at the end are added to the
+   * table in place. Other changes build a new table
+   * and swap it in.
+   */
+  MidiMappingsTable * table;
+
+  /**
+   * Last controller received on each channel plus 1,
+   * or 0 if none (only used by
+   * midi_mappings_apply()).
+   */
+  midi_byte_t last_cc[16];
+
+  /** Value of MidiMappings.last_cc. */
+  midi_byte_t last_cc_value[16];
 } MidiMappings;
 
 static const cyaml_schema_field_t midi_mappings_fields_schema[] = {
@@ -152,6 +207,12 @@ midi_mappings_new (void);
  * @param buf The buffer used for matching at [0] and
  *   [1].
  * @param device_port Device port, if custom mapping.
+ *
+ * @note Inserting before the last mapping frees
+ *   the previous lookup table, so it must be done
+ *   while the engine is paused (see
+ *   engine_wait_for_pause()) if the mappings are
+ *   in use by the engine.
  */
 void
 midi_mappings_bind_at (
@@ -208,6 +269,14 @@ midi_mappings_apply_from_cc_events (
 
 /**
  * Applies the given buffer to the matching ports.
+ *
+ * Only the mappings bound to the status and data
+ * bytes of the message are visited.
+ *
+ * When the LSB of a 14-bit CC (controllers 32-63)
+ * immediately follows its MSB on the same channel,
+ * the combined 14-bit value is also applied to the
+ * non-toggle control ports mapped to the MSB.
  */
 void
 midi_mappings_apply (MidiMappings * self, midi_byte_t * buf);
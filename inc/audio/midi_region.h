@@ -23,6 +23,8 @@ typedef struct ZRegion         ZRegion;
 typedef struct MidiEvents      MidiEvents;
 typedef struct ChordDescriptor ChordDescriptor;
 typedef struct Velocity        Velocity;
+typedef struct MidiFile        MidiFile;
+typedef struct MidiFileTrack   MidiFileTrack;
 typedef ZRegion                MidiRegion;
 typedef void                   MIDI_FILE;
 
@@ -44,22 +46,21 @@ midi_region_new (
   int              idx_inside_lane);
 
 /**
- * Creates a MIDI region from the given MIDI
- * file path, starting at the given Position.
+ * Creates a MIDI region from the given track of a
+ * MIDI file, starting at the given Position.
  *
- * @param idx The index of this track, starting from
- *   0. This will be sequential, ie, if idx 1 is
- *   requested and the MIDI file only has tracks
- *   5 and 7, it will use track 7.
+ * The notes are created in bulk.
+ *
+ * @return The region, or NULL if the track is empty.
  */
-ZRegion *
-midi_region_new_from_midi_file (
-  const Position * start_pos,
-  const char *     abs_path,
-  unsigned int     track_name_hash,
-  int              lane_pos,
-  int              idx_inside_lane,
-  int              idx);
+NONNULL ZRegion *
+midi_region_new_from_midi_file_track (
+  const Position *      start_pos,
+  const MidiFile *      mf,
+  const MidiFileTrack * mf_track,
+  unsigned int          track_name_hash,
+  int                   lane_pos,
+  int                   idx_inside_lane);
 
 /**
  * Create a region from the chord descriptor.
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+/**
+ * \file
+ *
+ * Multi-resolution min/max peaks of audio.
+ */
+
+#ifndef __AUDIO_PEAK_CACHE_H__
+#define __AUDIO_PEAK_CACHE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "utils/types.h"
+
+#include <glib.h>
+
+/**
+ * @addtogroup audio
+ *
+ * @{
+ */
+
+/**
+ * Number of frames summarized by each peak of the
+ * finest level.
+ *
+ * Each following level summarizes twice as many
+ * frames.
+ */
+#define PEAK_CACHE_BASE_FRAMES 128
+
+/** Maximum number of levels. */
+#define PEAK_CACHE_MAX_LEVELS 24
+
+/**
+ * A level of the peak cache.
+ */
+typedef struct PeakCacheLevel
+{
+  /** Number of frames summarized by each peak. */
+  unsigned_frame_t frames_per_peak;
+
+  /** Number of peaks. */
+  size_t num_peaks;
+
+  /**
+   * Min and max of each peak, interleaved.
+   *
+   * Points into PeakCache.data.
+   */
+  float * peaks;
+} PeakCacheLevel;
+
+/**
+ * Min/max peaks of interleaved audio frames at
+ * power-of-two decimation levels, used to draw
+ * waveforms without scanning the whole audio.
+ *
+ * The peaks of all channels are merged.
+ */
+typedef struct PeakCache
+{
+  /** Number of frames (per channel) summarized. */
+  unsigned_frame_t num_frames;
+
+  PeakCacheLevel levels[PEAK_CACHE_MAX_LEVELS];
+  int            num_levels;
+
+  /** Storage for the peaks of all levels. */
+  float * data;
+
+  /** Number of floats in PeakCache.data. */
+  size_t data_size;
+
+  /**
+   * Mapped peak file PeakCache.data points into,
+   * if loaded from a file.
+   */
+  GMappedFile * mapped_file;
+} PeakCache;
+
+/**
+ * Builds a peak cache from the given interleaved
+ * frames.
+ *
+ * This may take a while for long audio, so it
+ * should be called from a background thread.
+ */
+PeakCache *
+peak_cache_new (
+  const float *          frames,
+  const unsigned_frame_t num_frames,
+  const channels_t       channels);
+
+/**
+ * Loads a peak cache written with
+ * peak_cache_write_to_file() by mapping the file
+ * into memory.
+ *
+ * @param num_frames Number of frames of the audio,
+ *   used to check that the file matches it.
+ *
+ * @return The peak cache, or NULL if the file could
+ *   not be read or does not match.
+ */
+PeakCache *
+peak_cache_new_from_file (
+  const char *           path,
+  const unsigned_frame_t num_frames,
+  GError **              error);
+
+/**
+ * Writes the peak cache to a file that can be
+ * mapped by peak_cache_new_from_file().
+ *
+ * @return Whether successful.
+ */
+NONNULL_ARGS (1, 2)
+bool
+peak_cache_write_to_file (
+  const PeakCache * self,
+  const char *      path,
+  GError **         error);
+
+/**
+ * Gets the min and max of the frames in the given
+ * range from the coarsest level whose peaks are not
+ * wider than the range.
+ *
+ * The result may include a few frames around the
+ * range.
+ *
+ * @param[out] min Will be set to the min if lower.
+ * @param[out] max Will be set to the max if higher.
+ *
+ * @return False if the range is narrower than the
+ *   peaks of the finest level, in which case the
+ *   frames should be scanned instead.
+ */
+HOT NONNULL bool
+peak_cache_get_min_max (
+  const PeakCache *      self,
+  const unsigned_frame_t start_frame,
+  const unsigned_frame_t end_frame,
+  float *                min,
+  float *                max);
+
+NONNULL void
+peak_cache_free (PeakCache * self);
+
+/**
+ * @}
+ */
+
+#endif
@@ -44,6 +44,7 @@ typedef struct AudioEngine             AudioEngine;
 typedef struct Track                   Track;
 typedef struct PortConnection          PortConnection;
 typedef struct TrackProcessor          TrackProcessor;
+typedef struct Meter                   Meter;
 typedef struct ModulatorMacroProcessor ModulatorMacroProcessor;
 typedef struct RtMidiDevice            RtMidiDevice;
 typedef struct RtAudioDevice           RtAudioDevice;
@@ -73,6 +74,9 @@ typedef enum PanLaw                    PanLaw;
 
 #define TIME_TO_RESET_PEAK 4800000
 
+/** Max number of meters subscribed to a port. */
+#define PORT_MAX_METERS 8
+
 /**
  * Special ID for owner_pl, owner_ch, etc. to indicate that
  * the port is not owned.
@@ -449,6 +453,15 @@ typedef struct Port
    */
   ZixRing * midi_ring;
 
+  /**
+   * Meters subscribed to this port, processed at
+   * the end of each cycle.
+   *
+   * Slots are set and cleared atomically by the
+   * UI thread.
+   */
+  Meter * meters[PORT_MAX_METERS];
+
   /** Max amplitude during processing, if audio
    * (fabsf). */
   float peak;
@@ -475,6 +488,12 @@ typedef struct Port
    * LV2 parameters. */
   LV2_URID value_type;
 
+  /** URID of the LV2 parameter, if property.
+   *
+   * Cached so it can be used in the realtime
+   * thread. */
+  LV2_URID property_urid;
+
   /** For MIDI ports, otherwise NULL. */
   LV2_Evbuf * evbuf;
 
@@ -519,6 +538,14 @@ typedef struct Port
    */
   float last_sent_control;
 
+  /**
+   * Set when the control value changed and the
+   * owner plugin has not received it yet.
+   *
+   * @seealso port_forward_control_change_event().
+   */
+  volatile gint plugin_change_pending;
+
   /** Whether this value was set via automation. */
   bool automating;
 
@@ -271,6 +271,21 @@ typedef struct ZRegion
    * are used). */
   ArrangerObject last_positions_obj;
 
+  /**
+   * Render nodes of the contents (MIDI notes or
+   * automation) of the main and lane counterparts,
+   * drawn at the full size of the region.
+   */
+  GskRenderNode * content_nodes[2];
+
+  /** Hash of the contents drawn in each content
+   * node. */
+  guint64 content_node_hashes[2];
+
+  /** Full size each content node was drawn at. */
+  int content_node_widths[2];
+  int content_node_heights[2];
+
   /* --- drawing caches end --- */
 
   int magic;
@@ -119,6 +119,20 @@ router_new (void);
 void
 router_recalc_graph (Router * self, bool soft);
 
+/**
+ * Updates the latencies of the routing graph after
+ * the latency of the given plugins changed.
+ *
+ * Cheaper than a soft recalculation, since only
+ * the affected routes are updated.
+ *
+ * @param plugins Array of Plugin pointers.
+ */
+void
+router_update_plugin_latencies (
+  Router *    self,
+  GPtrArray * plugins);
+
 /**
  * Starts a new cycle.
  */
@@ -16,6 +16,8 @@
 #include "utils/types.h"
 
 typedef enum MetronomeType   MetronomeType;
+typedef struct Track           Track;
+typedef struct AudioFileStream AudioFileStream;
 typedef struct SupportedFile SupportedFile;
 typedef struct Tracklist     Tracklist;
 typedef struct PluginSetting PluginSetting;
@@ -32,10 +34,47 @@ typedef struct ChordPreset   ChordPreset;
 
 #define SAMPLE_PROCESSOR (AUDIO_ENGINE->sample_processor)
 
+/** Maximum number of MIDI tracks per audition
+ * set. */
+#define SAMPLE_PROCESSOR_MAX_MIDI_TRACKS 64
+
 #define sample_processor_is_in_active_project(self) \
   (self->audio_engine \
    && engine_is_in_active_project (self->audio_engine))
 
+/**
+ * Auditioner tracks holding the material to
+ * audition.
+ *
+ * There are 2 of these so that new material can be
+ * prepared in one while the other one is played.
+ */
+typedef struct SampleProcessorAuditionSet
+{
+  /** Track for audio files that can't be
+   * streamed. */
+  Track * audio_track;
+
+  /** Stream for audio files. */
+  AudioFileStream * stream;
+
+  /** Tracks for MIDI files and chord presets,
+   * routed to the instrument track. */
+  Track * midi_tracks[SAMPLE_PROCESSOR_MAX_MIDI_TRACKS];
+  int     num_midi_tracks;
+
+  /** Number of MIDI tracks used by the current
+   * material. */
+  int num_used_midi_tracks;
+
+  /** Whether the audio track (instead of the
+   * stream) is used by the current material. */
+  bool has_audio;
+
+  /** Position the material ends at. */
+  Position file_end_pos;
+} SampleProcessorAuditionSet;
+
 /**
  * A processor to be used in the routing graph for
  * playing samples independent of the timeline.
@@ -56,6 +95,45 @@ typedef struct SampleProcessor
   /** Instrument for MIDI auditioning. */
   PluginSetting * instrument_setting;
 
+  /**
+   * Whether the auditioner tracks below have been
+   * created.
+   *
+   * The tracks and the instrument are created
+   * once and reused for every file auditioned.
+   */
+  bool audition_chain_built;
+
+  /** Instrument track with an instance of
+   * SampleProcessor.instrument_setting. */
+  Track * instrument_track;
+
+  /** Material sets (see SampleProcessorAuditionSet).
+   */
+  SampleProcessorAuditionSet audition_sets[2];
+
+  /**
+   * Playback request, written by the GUI thread and
+   * taken by the engine at the start of each cycle.
+   *
+   * Holds the index of the set to play (or -1 if
+   * stopped) together with a request counter, so
+   * that both are read at once.
+   */
+  volatile gint request;
+
+  /** Last request taken by the engine. */
+  volatile gint taken_request;
+
+  /** Signaled by the engine when it takes a
+   * request. */
+  GCond  request_cond;
+  GMutex request_lock;
+
+  /** Index of the set being played, or -1 if
+   * stopped (only used by the engine). */
+  int active_set;
+
   MidiEvents * midi_events;
 
   /** Fader connected to the main output. */
@@ -184,12 +262,40 @@ sample_processor_queue_chord_preset (
   SampleProcessor *   self,
   const ChordPreset * chord_pset);
 
+/**
+ * Creates the auditioner tracks and instantiates
+ * the instrument, if not already done.
+ *
+ * Calling this ahead of time avoids pausing the
+ * engine on the first audition.
+ */
+void
+sample_processor_prewarm (SampleProcessor * self);
+
+/**
+ * Frees the auditioner tracks and creates them
+ * again.
+ *
+ * To be called when
+ * SampleProcessor.instrument_setting changes.
+ */
+void
+sample_processor_rebuild_audition_chain (
+  SampleProcessor * self);
+
 /**
  * Stops playback of files (auditioning).
  */
 void
 sample_processor_stop_file_playback (SampleProcessor * self);
 
+/**
+ * Returns the index of the set last requested to
+ * play, or -1 if stopped.
+ */
+int
+sample_processor_get_requested_set (SampleProcessor * self);
+
 void
 sample_processor_disconnect (SampleProcessor * self);
 
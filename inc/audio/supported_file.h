@@ -14,6 +14,8 @@
 
 #include "utils/yaml.h"
 
+#include <audec/audec.h>
+
 typedef struct _WrappedObjectWithChangeSignal
   WrappedObjectWithChangeSignal;
 
@@ -176,6 +178,18 @@ char *
 supported_file_get_info_text_for_label (
   const SupportedFile * self);
 
+/**
+ * Returns a pango markup to be used in GTK labels.
+ *
+ * @param nfo Audio info to show for audio files, or
+ *   NULL to read it from the file.
+ */
+NONNULL_ARGS (1)
+char *
+supported_file_get_info_text_for_label_w_info (
+  const SupportedFile * self,
+  const AudecInfo *     nfo);
+
 /**
  * Frees the instance and all its members.
  */
@@ -487,6 +487,25 @@ arranger_object_get_object (ArrangerObject * self);
 void
 arranger_object_init (ArrangerObject * self);
 
+/**
+ * To be called when arranger objects are added to
+ * the project or their positions change, so that
+ * caches of object positions get invalidated.
+ *
+ * Creating, freeing and setting the positions of
+ * objects through the arranger_object_*() API
+ * already calls this.
+ */
+void
+arranger_object_positions_changed (void);
+
+/**
+ * Returns a number that changes every time
+ * arranger_object_positions_changed() is called.
+ */
+unsigned int
+arranger_object_get_positions_generation (void);
+
 /**
  * Initializes the object after loading a Project.
  */
@@ -13,12 +13,15 @@
 #ifndef __GUI_BACKEND_EVENT_MANAGER_H__
 #define __GUI_BACKEND_EVENT_MANAGER_H__
 
+#include <stdbool.h>
+
 #include "utils/backtrace.h"
 #include "utils/mpmc_queue.h"
 #include "utils/object_pool.h"
 
-typedef struct Zrythm Zrythm;
-typedef struct ZEvent ZEvent;
+typedef struct Zrythm  Zrythm;
+typedef struct ZEvent  ZEvent;
+typedef enum EventType EventType;
 
 /**
  * @addtogroup events
@@ -45,12 +48,33 @@ typedef struct EventManager
   /** ID of the event processing source func. */
   guint process_source_id;
 
-  /** A soft recalculation of the routing graph
-   * is pending. */
-  bool pending_soft_recalc;
+  /** ID of the source that updates the graph
+   * latencies once plugin latencies settle, if
+   * any. */
+  guint latency_update_source_id;
+
+  /** Time of the last plugin latency change. */
+  gint64 last_latency_change;
 
   /** Events array to use during processing. */
   GPtrArray * events_arr;
+
+  /** Set of the events in EventManager.events_arr,
+   * used to skip duplicates. */
+  GHashTable * events_set;
+
+  /**
+   * Table of the type and argument of queued
+   * events, packed in a word, used to skip pushing
+   * events identical to a queued one.
+   *
+   * Open addressing with
+   * EVENT_MANAGER_PENDING_SIZE slots, cleared after
+   * each time the queue is drained.
+   *
+   * @see event_manager_mark_pending().
+   */
+  gsize * pending_events;
 } EventManager;
 
 #define EVENT_MANAGER (ZRYTHM->event_manager)
@@ -60,6 +84,25 @@ typedef struct EventManager
 
 #define EVENT_MANAGER_MAX_EVENTS 4000
 
+/**
+ * Number of slots in EventManager.pending_events.
+ *
+ * Must be a power of 2.
+ */
+#define EVENT_MANAGER_PENDING_SIZE 8192
+
+/**
+ * Max slots to check when looking for a pending
+ * event.
+ */
+#define EVENT_MANAGER_PENDING_MAX_PROBES 16
+
+/**
+ * Time a plugin's latency must stay unchanged
+ * before the graph latencies are updated.
+ */
+#define EVENT_MANAGER_LATENCY_DEBOUNCE_MS 250
+
 #define event_queue_push_back_event(q, x) \
   mpmc_queue_push_back (q, (void *) x)
 
@@ -73,33 +116,49 @@ typedef struct EventManager
   if ( \
     ZRYTHM_HAVE_UI && EVENT_MANAGER && EVENT_QUEUE \
     && (!PROJECT || !AUDIO_ENGINE || !AUDIO_ENGINE->exporting) \
-    && EVENT_MANAGER->process_source_id) \
+    && EVENT_MANAGER->process_source_id \
+    && event_manager_mark_pending ( \
+      EVENT_MANAGER, (et), (void *) (_arg))) \
     { \
       ZEvent * _ev = (ZEvent *) object_pool_get ( \
         EVENT_MANAGER->obj_pool); \
-      _ev->file = __FILE__; \
-      _ev->func = __func__; \
-      _ev->lineno = __LINE__; \
-      _ev->type = (et); \
-      _ev->arg = (void *) (_arg); \
-      if ( \
-        zrythm_app->gtk_thread \
-          == g_thread_self () /* skip backtrace for now */ \
-        && false) \
+      if (_ev) \
         { \
-          _ev->backtrace = backtrace_get ("", 40, false); \
+          _ev->file = __FILE__; \
+          _ev->func = __func__; \
+          _ev->lineno = __LINE__; \
+          _ev->type = (et); \
+          _ev->arg = (void *) (_arg); \
+          /* skip backtrace for now */ \
+          if ( \
+            zrythm_app->gtk_thread == g_thread_self () \
+            && false) \
+            { \
+              _ev->backtrace = \
+                backtrace_get ("", 40, false); \
+            } \
+          /* don't print events that are called \
+           * continuously */ \
+          if ( \
+            (et) != ET_PLAYHEAD_POS_CHANGED \
+            && g_thread_self () == zrythm_app->gtk_thread) \
+            { \
+              g_debug ( \
+                "pushing UI event " #et " (%s:%d)", \
+                __func__, __LINE__); \
+            } \
         } \
-      /* don't print events that are called \
-       * continuously */ \
       if ( \
-        (et) != ET_PLAYHEAD_POS_CHANGED \
-        && g_thread_self () == zrythm_app->gtk_thread) \
+        !_ev \
+        || !event_queue_push_back_event (EVENT_QUEUE, _ev)) \
         { \
-          g_debug ( \
-            "pushing UI event " #et " (%s:%d)", __func__, \
-            __LINE__); \
+          /* let identical events be pushed again */ \
+          event_manager_unmark_pending ( \
+            EVENT_MANAGER, (et), (void *) (_arg)); \
+          if (_ev) \
+            object_pool_return ( \
+              EVENT_MANAGER->obj_pool, _ev); \
         } \
-      event_queue_push_back_event (EVENT_QUEUE, _ev); \
     }
 
 /* runs the event logic now */
@@ -133,6 +192,36 @@ typedef struct EventManager
       object_pool_return (EVENT_MANAGER->obj_pool, _ev); \
     }
 
+/**
+ * Marks an event with the given type and argument
+ * as queued.
+ *
+ * This is lock-free and realtime-safe, and takes
+ * constant time.
+ *
+ * @return Whether the event should be pushed, or
+ *   false if an identical event is already queued
+ *   and will be processed after this call.
+ */
+HOT NONNULL bool
+event_manager_mark_pending (
+  EventManager * self,
+  EventType      type,
+  void *         arg);
+
+/**
+ * Clears the mark made by
+ * event_manager_mark_pending(), for when the event
+ * could not be pushed after all.
+ *
+ * This is lock-free and realtime-safe.
+ */
+HOT NONNULL void
+event_manager_unmark_pending (
+  EventManager * self,
+  EventType      type,
+  void *         arg);
+
 /**
  * Creates the event queue and starts the event loop.
  *
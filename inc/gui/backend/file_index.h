@@ -0,0 +1,330 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+/**
+ * \file
+ *
+ * Background index of the files in the file browser
+ * locations.
+ */
+
+#ifndef __GUI_BACKEND_FILE_INDEX_H__
+#define __GUI_BACKEND_FILE_INDEX_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "audio/supported_file.h"
+#include "utils/yaml.h"
+
+#include <gio/gio.h>
+
+/**
+ * @addtogroup gui_backend
+ *
+ * @{
+ */
+
+#define FILE_INDEX_SCHEMA_VERSION 1
+
+/**
+ * Maximum number of directories to watch for
+ * changes.
+ *
+ * Directories beyond this are only re-indexed when
+ * visited or on the next start.
+ */
+#define FILE_INDEX_MAX_MONITORS 512
+
+/**
+ * An indexed file or directory.
+ */
+typedef struct FileIndexEntry
+{
+  /** Absolute path. */
+  char * abs_path;
+
+  ZFileType type;
+
+  /** Hidden or not. */
+  int hidden;
+
+  /** Last modification time in microseconds. */
+  int64_t mtime;
+
+  /** Size in bytes. */
+  int64_t size;
+
+  /** Whether the audio info below was read. */
+  int have_info;
+
+  int samplerate;
+  int channels;
+
+  /** Length in milliseconds. */
+  int64_t length;
+
+  float bpm;
+  int   bit_rate;
+  int   bit_depth;
+
+  /** Basename (not serialized). */
+  char * label;
+
+  /** Uppercase label used for searching (not
+   * serialized). */
+  char * search_key;
+} FileIndexEntry;
+
+static const cyaml_schema_field_t
+  file_index_entry_fields_schema[] = {
+    YAML_FIELD_STRING_PTR (FileIndexEntry, abs_path),
+    YAML_FIELD_ENUM (FileIndexEntry, type, file_type_strings),
+    YAML_FIELD_INT (FileIndexEntry, hidden),
+    YAML_FIELD_INT (FileIndexEntry, mtime),
+    YAML_FIELD_INT (FileIndexEntry, size),
+    YAML_FIELD_INT (FileIndexEntry, have_info),
+    YAML_FIELD_INT (FileIndexEntry, samplerate),
+    YAML_FIELD_INT (FileIndexEntry, channels),
+    YAML_FIELD_INT (FileIndexEntry, length),
+    YAML_FIELD_FLOAT (FileIndexEntry, bpm),
+    YAML_FIELD_INT (FileIndexEntry, bit_rate),
+    YAML_FIELD_INT (FileIndexEntry, bit_depth),
+
+    CYAML_FIELD_END
+  };
+
+static const cyaml_schema_value_t file_index_entry_schema = {
+  YAML_VALUE_PTR (
+    FileIndexEntry,
+    file_index_entry_fields_schema),
+};
+
+/**
+ * The listed children of a directory.
+ */
+typedef struct FileIndexDir
+{
+  /** Child entries sorted by label (not owned). */
+  GPtrArray * children;
+
+  /** Incremented when the children change. */
+  unsigned int generation;
+} FileIndexDir;
+
+/**
+ * Index of the files under the file browser
+ * locations.
+ *
+ * Directories are listed and audio files are probed
+ * in a background thread, so that the file browser
+ * and its search never touch the disk. Files whose
+ * modification time and size did not change are not
+ * probed again, and the index is saved to a file so
+ * that it is available immediately on the next
+ * start.
+ *
+ * Indexed directories are watched for changes and
+ * re-indexed when they change.
+ *
+ * Only the indexing thread modifies the index. Other
+ * threads must use the file_index_*() functions,
+ * which take FileIndex.lock and return copies.
+ */
+typedef struct FileIndex
+{
+  /** Version of the file. */
+  int schema_version;
+
+  /** Entries to serialize (only used while
+   * loading/saving). */
+  FileIndexEntry ** entries;
+  int               num_entries;
+  size_t            entries_size;
+
+  /** Path of the index file, or NULL to not persist
+   * the index. */
+  char * path;
+
+  /** Absolute path -> FileIndexEntry (owned). */
+  GHashTable * entries_ht;
+
+  /** Directory path -> FileIndexDir, for listed
+   * directories. */
+  GHashTable * dirs_ht;
+
+  /** Protects the index. */
+  GMutex lock;
+
+  /** Signaled when there are no pending jobs. */
+  GCond idle_cond;
+
+  /** Number of jobs queued or being processed. */
+  int num_pending_jobs;
+
+  /** Jobs for the indexing thread. */
+  GAsyncQueue * queue;
+
+  /** Directories in FileIndex.queue, to skip
+   * queueing them again. */
+  GHashTable * queued_dirs;
+
+  GThread * thread;
+
+  /** Set when the index is being freed. */
+  volatile gint stopping;
+
+  /** Locations that are indexed recursively. */
+  GPtrArray * recursive_locations;
+
+  /** Whether the index changed since it was
+   * saved. */
+  bool dirty;
+
+  /** Directories to start watching, added by the
+   * indexing thread. */
+  GPtrArray * dirs_to_watch;
+
+  /** Idle source creating the monitors for
+   * FileIndex.dirs_to_watch, or 0. */
+  guint watch_source_id;
+
+  /** Directory path -> GFileMonitor (main thread
+   * only). */
+  GHashTable * monitors;
+
+  /**
+   * File ID (device and inode) -> path of the
+   * directories queued for recursive indexing, so
+   * that symlink loops and directories linked from
+   * several places are only descended into once
+   * (indexing thread only).
+   */
+  GHashTable * recursed_dir_ids;
+} FileIndex;
+
+static const cyaml_schema_field_t
+  file_index_fields_schema[] = {
+    YAML_FIELD_INT (FileIndex, schema_version),
+    YAML_FIELD_DYN_PTR_ARRAY_VAR_COUNT_OPT (
+      FileIndex,
+      entries,
+      file_index_entry_schema),
+
+    CYAML_FIELD_END
+  };
+
+static const cyaml_schema_value_t file_index_schema = {
+  YAML_VALUE_PTR (FileIndex, file_index_fields_schema),
+};
+
+/**
+ * Creates the index and starts the indexing thread.
+ *
+ * Must be called from the main thread.
+ *
+ * @param path Path of the file to load the index
+ *   from and save it to, or NULL to not persist it.
+ */
+FileIndex *
+file_index_new (const char * path);
+
+/**
+ * Queues indexing a location.
+ *
+ * @param recursive Whether to also index all
+ *   non-hidden subdirectories.
+ */
+NONNULL void
+file_index_add_location (
+  FileIndex *  self,
+  const char * dir,
+  bool         recursive);
+
+/**
+ * Queues (re-)indexing the given directory before
+ * any other pending directory.
+ *
+ * Subdirectories are indexed too if the directory
+ * is inside a recursive location.
+ */
+NONNULL void
+file_index_index_dir (FileIndex * self, const char * dir);
+
+/**
+ * Appends copies of the child entries of the given
+ * directory to @p entries.
+ *
+ * @param[out] generation Set to the generation of
+ *   the directory's children, if non-NULL.
+ *
+ * @return Whether the directory was indexed.
+ */
+NONNULL_ARGS (1, 2, 3)
+bool
+file_index_get_dir_entries (
+  FileIndex *    self,
+  const char *   dir,
+  GPtrArray *    entries,
+  unsigned int * generation);
+
+/**
+ * Returns the generation of the children of the
+ * given directory, or 0 if it was not indexed.
+ */
+NONNULL unsigned int
+file_index_get_dir_generation (
+  FileIndex *  self,
+  const char * dir);
+
+/**
+ * Returns a copy of the entry for the given path, or
+ * NULL if it was not indexed.
+ */
+NONNULL FileIndexEntry *
+file_index_get_entry (FileIndex * self, const char * path);
+
+/**
+ * Appends copies of the entries whose label contains
+ * @p text (case-insensitive) to @p entries.
+ *
+ * Labels that equal @p text come first, then labels
+ * starting with it, then the rest, each sorted by
+ * label.
+ *
+ * @param max_results Maximum number of entries to
+ *   append, from all matches ranked as above.
+ */
+NONNULL void
+file_index_search (
+  FileIndex *  self,
+  const char * text,
+  GPtrArray *  entries,
+  guint        max_results);
+
+/**
+ * Waits until all queued directories are indexed.
+ */
+NONNULL void
+file_index_wait_until_idle (FileIndex * self);
+
+NONNULL FileIndexEntry *
+file_index_entry_clone (const FileIndexEntry * src);
+
+NONNULL void
+file_index_entry_free (FileIndexEntry * self);
+
+/**
+ * Stops the indexing thread, saves the index and
+ * frees it.
+ *
+ * Must be called from the main thread.
+ */
+NONNULL void
+file_index_free (FileIndex * self);
+
+/**
+ * @}
+ */
+
+#endif
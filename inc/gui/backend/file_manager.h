@@ -23,6 +23,7 @@
 #include <stdbool.h>
 
 typedef struct SupportedFile SupportedFile;
+typedef struct FileIndex     FileIndex;
 
 /**
  * @addtogroup gui_backend
@@ -67,6 +68,11 @@ typedef struct FileBrowserLocation
   FileManagerSpecialLocation special_location;
 } FileBrowserLocation;
 
+/**
+ * Maximum number of files to show when searching.
+ */
+#define FILE_MANAGER_MAX_SEARCH_RESULTS 2000
+
 /**
  * Current selection in the top window.
  */
@@ -109,6 +115,21 @@ typedef struct FileManager
    */
   FileBrowserLocation * selection;
 
+  /** Background index of the files in the
+   * locations. */
+  FileIndex * index;
+
+  /**
+   * Generation of the index listing the files were
+   * loaded from, or 0 if they were not loaded from
+   * the index.
+   */
+  unsigned int files_generation;
+
+  /** Whether FileManager.files are search
+   * results. */
+  bool showing_search_results;
+
 } FileManager;
 
 /**
@@ -123,6 +144,31 @@ file_manager_new (void);
 void
 file_manager_load_files (FileManager * self);
 
+/**
+ * Loads the files in all locations whose name
+ * contains the given text into FileManager.files.
+ */
+NONNULL void
+file_manager_load_search_results (
+  FileManager * self,
+  const char *  text);
+
+/**
+ * Returns whether the files under the current
+ * selection changed since they were loaded.
+ */
+NONNULL bool
+file_manager_files_changed (FileManager * self);
+
+/**
+ * Returns a pango markup describing the file, using
+ * the indexed info if available.
+ */
+NONNULL char *
+file_manager_get_file_info_text (
+  FileManager *         self,
+  const SupportedFile * file);
+
 /**
  * @param save_to_settings Whether to save this
  *   location to GSettings.
@@ -51,6 +51,7 @@ typedef struct _GtkEventControllerMotion
 typedef struct ArrangerObject     ArrangerObject;
 typedef struct ArrangerSelections ArrangerSelections;
 typedef struct EditorSettings     EditorSettings;
+typedef struct IntervalTree       IntervalTree;
 typedef struct ObjectPool         ObjectPool;
 typedef struct _RulerWidget       RulerWidget;
 typedef enum ArrangerObjectType   ArrangerObjectType;
@@ -459,6 +460,25 @@ typedef struct _ArrangerWidget
    */
   GPtrArray * hit_objs_to_draw;
 
+  /**
+   * Index of the regions or MIDI notes by position,
+   * used to find the ones in a range without
+   * checking every object.
+   *
+   * Rebuilt lazily when arranger object positions
+   * change.
+   */
+  IntervalTree * hit_index;
+
+  /** Value of
+   * arranger_object_get_positions_generation() when
+   * the hit index was built. */
+  unsigned int hit_index_generation;
+
+  /** Region whose objects are in the hit index, in
+   * editors. */
+  ZRegion * hit_index_region;
+
   /** Popover to be reused for context menus. */
   GtkPopoverMenu * popover_menu;
 } ArrangerWidget;
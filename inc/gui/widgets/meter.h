@@ -23,6 +23,8 @@
 #ifndef __GUI_WIDGETS_METER_H__
 #define __GUI_WIDGETS_METER_H__
 
+#include <stdbool.h>
+
 #include "utils/general.h"
 
 #include <gtk/gtk.h>
@@ -64,6 +66,9 @@ typedef struct _MeterWidget
   /** ID of the source function. */
   guint     source_id;
   GSource * timeout_source;
+
+  /** ID of the tick callback, or 0 if inactive. */
+  guint tick_cb_id;
 } MeterWidget;
 
 /**
@@ -75,4 +80,13 @@ typedef struct _MeterWidget
 void
 meter_widget_setup (MeterWidget * self, Port * port, int width);
 
+/**
+ * Sets whether the meter should be updated.
+ *
+ * Inactive meters are not processed and not
+ * redrawn.
+ */
+void
+meter_widget_set_active (MeterWidget * self, bool active);
+
 #endif
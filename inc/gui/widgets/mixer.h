@@ -53,6 +53,32 @@ G_DECLARE_FINAL_TYPE (
 
 #define MW_MIXER MW_BOT_DOCK_EDGE->mixer
 
+/** Width of strips not measured yet. */
+#define MIXER_STRIP_DEFAULT_WIDTH 80
+
+/**
+ * A strip (channel or folder channel) in the mixer.
+ *
+ * The widget of the strip is only created while the
+ * strip is in or near the visible part of the
+ * mixer.
+ */
+typedef struct MixerStrip
+{
+  Track * track;
+
+  /** Whether this is the folder channel of the
+   * track instead of its channel. */
+  bool is_folder;
+
+  /** Placeholder box in MixerWidget.channels_box
+   * holding the widget, if any. */
+  GtkBox * box;
+
+  /** Last known width of the widget. */
+  int width;
+} MixerStrip;
+
 typedef struct _MixerWidget
 {
   GtkBox parent_instance;
@@ -65,6 +91,17 @@ typedef struct _MixerWidget
    */
   GtkBox * channels_box;
 
+  /** Scrolled window of MixerWidget.channels_box. */
+  GtkScrolledWindow * channels_scroll;
+
+  /** MixerStrip's in MixerWidget.channels_box. */
+  GPtrArray * strips;
+
+  /** Last measured width of channel and folder
+   * channel strips. */
+  int last_strip_width;
+  int last_folder_strip_width;
+
   /**
    * The track where dnd originated from.
    *
@@ -99,6 +136,14 @@ mixer_widget_setup (MixerWidget * self, Channel * master);
 void
 mixer_widget_hard_refresh (MixerWidget * self);
 
+/**
+ * Creates the widgets of the strips in or near view
+ * and destroys the widgets of the strips far from
+ * view.
+ */
+void
+mixer_widget_update_strips_in_view (MixerWidget * self);
+
 /**
  * Calls refresh on each channel.
  */
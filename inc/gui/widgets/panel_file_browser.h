@@ -71,6 +71,10 @@ typedef struct _PanelFileBrowserWidget
 
   /** Popover to be reused for context menus. */
   GtkPopoverMenu * popover_menu;
+
+  /** Source reloading the files when they are
+   * re-indexed. */
+  guint files_changed_source_id;
 } PanelFileBrowserWidget;
 
 void
@@ -11,6 +11,7 @@
 #define __GUI_WIDGETS_PLUGIN_BROWSER_H__
 
 #include "plugins/plugin.h"
+#include "utils/search_index.h"
 #include "utils/symap.h"
 
 #include <gtk/gtk.h>
@@ -178,6 +179,10 @@ typedef struct _PluginBrowserWidget
   /** Symbol map for string interning. */
   Symap * symap;
 
+  /** Index of the name, author and category of the
+   * plugin descriptors, for searching. */
+  SearchIndex * search_index;
+
   /** Popover to be reused for context menus. */
   GtkPopoverMenu * popover_menu;
 } PluginBrowserWidget;
@@ -254,6 +254,21 @@ typedef struct _TrackWidget
   MeterWidget * meter_l;
   MeterWidget * meter_r;
 
+  /** Whether the meters were set up. */
+  bool meters_set_up;
+
+  /**
+   * Whether the track is in the visible part of the
+   * tracklist.
+   *
+   * Meters and animations only run while in view.
+   */
+  bool in_view;
+
+  /** ID of the tick callback, or 0 if not in
+   * view. */
+  guint tick_cb_id;
+
   /**
    * Current tooltip text.
    */
@@ -371,6 +386,17 @@ track_widget_get_local_y (
   ArrangerWidget * arranger,
   int              arranger_y);
 
+/**
+ * Sets whether the track is in the visible part of
+ * the tracklist, which starts or stops the meters
+ * and animations.
+ *
+ * Meters are set up the first time the track comes
+ * into view.
+ */
+void
+track_widget_set_in_view (TrackWidget * self, bool in_view);
+
 /**
  * Causes a redraw of the meters only.
  */
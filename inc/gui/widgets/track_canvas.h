@@ -49,4 +49,13 @@ track_canvas_widget_setup (
   TrackCanvasWidget * self,
   TrackWidget *       parent);
 
+/**
+ * Returns a hash of everything the canvas draws
+ * apart from its size, to be passed to
+ * z_gtk_widget_queue_draw_if_changed().
+ */
+guint64
+track_canvas_widget_get_draw_version (
+  TrackCanvasWidget * self);
+
 #endif
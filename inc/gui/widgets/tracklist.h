@@ -74,6 +74,14 @@ typedef struct _TracklistWidget
   /** Cache. */
   GdkRectangle last_allocation;
 
+  /** Tick callback that updates the tracks in view
+   * after the tracks are allocated, or 0. */
+  guint in_view_tick_cb_id;
+
+  /** Number of ticks to run the tick callback
+   * above for. */
+  int in_view_ticks_left;
+
   bool setup;
 
   double hover_y;
@@ -93,6 +101,15 @@ tracklist_widget_setup (
 void
 tracklist_widget_tear_down (TracklistWidget * self);
 
+/**
+ * Starts the meters and animations of the tracks in
+ * the visible part of the tracklist and stops the
+ * others.
+ */
+void
+tracklist_widget_update_tracks_in_view (
+  TracklistWidget * self);
+
 /**
  * Makes sure all the tracks for channels marked as
  * visible are visible.
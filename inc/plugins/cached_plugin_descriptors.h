@@ -35,7 +35,45 @@
  * @{
  */
 
-#define CACHED_PLUGIN_DESCRIPTORS_SCHEMA_VERSION 3
+#define CACHED_PLUGIN_DESCRIPTORS_SCHEMA_VERSION 4
+
+/**
+ * Modification stamp of a plugin file or bundle,
+ * used to detect whether a cached descriptor is
+ * stale.
+ */
+typedef struct PluginFileStamp
+{
+  /** Plugin URI for LV2, path otherwise. */
+  char * key;
+
+  /** Last modification time in microseconds
+   * (for LV2 bundles, the latest of the bundle
+   * directory and its manifest).
+   *
+   * On Windows, this only has a resolution of one
+   * second. */
+  int64_t mtime;
+
+  /** Size in bytes (for LV2 bundles, the size of
+   * the manifest). */
+  int64_t size;
+} PluginFileStamp;
+
+static const cyaml_schema_field_t
+  plugin_file_stamp_fields_schema[] = {
+    YAML_FIELD_STRING_PTR (PluginFileStamp, key),
+    YAML_FIELD_INT (PluginFileStamp, mtime),
+    YAML_FIELD_INT (PluginFileStamp, size),
+
+    CYAML_FIELD_END
+  };
+
+static const cyaml_schema_value_t plugin_file_stamp_schema = {
+  YAML_VALUE_PTR (
+    PluginFileStamp,
+    plugin_file_stamp_fields_schema),
+};
 
 /**
  * Descriptors to be cached.
@@ -53,6 +91,21 @@ typedef struct CachedPluginDescriptors
    * when scanning */
   PluginDescriptor * blacklisted[90000];
   int                num_blacklisted;
+
+  /** File stamps of the plugins above. */
+  PluginFileStamp ** stamps;
+  int                num_stamps;
+  size_t             stamps_size;
+
+  /** Plugin URI (LV2) or path -> GPtrArray of valid
+   * descriptors (not owned). */
+  GHashTable * descriptors_ht;
+
+  /** Path -> blacklisted descriptor (not owned). */
+  GHashTable * blacklisted_ht;
+
+  /** Key -> PluginFileStamp (not owned). */
+  GHashTable * stamps_ht;
 } CachedPluginDescriptors;
 
 static const cyaml_schema_field_t
@@ -66,6 +119,10 @@ static const cyaml_schema_field_t
       CachedPluginDescriptors,
       blacklisted,
       plugin_descriptor_schema),
+    YAML_FIELD_DYN_PTR_ARRAY_VAR_COUNT_OPT (
+      CachedPluginDescriptors,
+      stamps,
+      plugin_file_stamp_schema),
 
     CYAML_FIELD_END
   };
@@ -114,10 +171,39 @@ cached_plugin_descriptors_find (
   bool                      check_valid,
   bool                      check_blacklisted);
 
+/**
+ * Returns the cached descriptor for the given LV2
+ * plugin URI if the bundle at @p bundle_path has
+ * not changed since it was cached.
+ *
+ * This allows skipping
+ * lv2_plugin_create_descriptor_from_lilv() for
+ * unchanged bundles.
+ *
+ * @return The cached descriptor (not to be free'd)
+ *   or NULL.
+ */
+const PluginDescriptor *
+cached_plugin_descriptors_get_lv2 (
+  CachedPluginDescriptors * self,
+  const char *              uri,
+  const char *              bundle_path);
+
+/**
+ * Stores the current modification stamp of the
+ * given LV2 bundle for the given plugin URI.
+ */
+void
+cached_plugin_descriptors_stamp_lv2 (
+  CachedPluginDescriptors * self,
+  const char *              uri,
+  const char *              bundle_path);
+
 /**
  * Returns the PluginDescriptor's corresponding to
  * the .so/.dll file at the given path, if it
- * exists and the MD5 hash matches.
+ * exists and has not been modified since it was
+ * cached.
  *
  * @note The returned array must be free'd but not
  *   the descriptors.
@@ -168,6 +254,24 @@ cached_plugin_descriptors_add (
   const PluginDescriptor *  descr,
   int                       _serialize);
 
+/**
+ * Removes the descriptors, blacklisted entries and
+ * stamps whose key (URI for LV2, path otherwise) is
+ * not in @p found_keys.
+ *
+ * This is used after a scan to forget plugins that
+ * were removed.
+ *
+ * @param found_keys Set of the URIs/paths of the
+ *   plugins found in the scan.
+ *
+ * @return Whether anything was removed.
+ */
+bool
+cached_plugin_descriptors_remove_missing (
+  CachedPluginDescriptors * self,
+  GHashTable *              found_keys);
+
 /**
  * Clears the descriptors and removes the cache file.
  */
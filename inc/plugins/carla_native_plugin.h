@@ -28,6 +28,8 @@
 #ifndef __PLUGINS_CARLA_NATIVE_PLUGIN_H__
 #  define __PLUGINS_CARLA_NATIVE_PLUGIN_H__
 
+#  include <stdatomic.h>
+
 #  ifdef HAVE_CARLA
 #    include <CarlaNativePlugin.h>
 #    include <CarlaUtils.h>
@@ -65,6 +67,28 @@ typedef struct CarlaPatchbayPortInfo
   char *       port_name;
 } CarlaPatchbayPortInfo;
 
+/**
+ * Processing cost of a plugin.
+ *
+ * For bridged plugins this is the round trip to the
+ * bridge process.
+ */
+typedef struct CarlaNativePluginProcessStats
+{
+  /** Number of cycles measured. */
+  gint num_cycles;
+
+  /** Average time per cycle, in microseconds. */
+  double avg_us;
+
+  /** Longest cycle, in microseconds. */
+  gint max_us;
+
+  /** Number of cycles that took longer than the
+   * time available for an engine block. */
+  gint num_overruns;
+} CarlaNativePluginProcessStats;
+
 typedef struct CarlaNativePlugin
 {
 #  ifdef HAVE_CARLA
@@ -136,6 +160,28 @@ typedef struct CarlaNativePlugin
   unsigned int max_variant_midi_ins;
   unsigned int max_variant_midi_outs;
 
+  /**
+   * Processing time measurements, updated by the
+   * realtime thread.
+   *
+   * Only measured for bridged plugins. The sum is
+   * 64-bit on all platforms so that it does not
+   * overflow.
+   *
+   * @see carla_native_plugin_get_process_stats().
+   */
+  atomic_int_least64_t process_time_sum_us;
+  volatile gint        process_time_max_us;
+  volatile gint        num_processed_cycles;
+  volatile gint        num_overruns;
+
+  /** Directory the state was last written to. */
+  char * saved_state_dir;
+
+  /** Hash of the state last written to
+   * #CarlaNativePlugin.saved_state_dir. */
+  uint32_t saved_state_hash;
+
 } CarlaNativePlugin;
 
 #  ifdef HAVE_CARLA
@@ -301,6 +347,19 @@ bool
 carla_native_plugin_has_custom_ui (
   const PluginDescriptor * descr);
 
+/**
+ * Fills in the processing cost of the plugin
+ * measured so far.
+ *
+ * For bridged plugins this is the per-cycle round
+ * trip cost of exchanging buffers with the bridge
+ * process.
+ */
+NONNULL void
+carla_native_plugin_get_process_stats (
+  CarlaNativePlugin *             self,
+  CarlaNativePluginProcessStats * stats);
+
 /**
  * Returns the latency in samples.
  */
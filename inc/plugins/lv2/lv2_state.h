@@ -91,6 +91,39 @@ NONNULL
 void
 lv2_state_apply_state (Lv2Plugin * plugin, LilvState * state);
 
+/**
+ * Takes a snapshot of the plugin state.
+ *
+ * This calls the plugin's save() and must not be
+ * called while the plugin is processing.
+ *
+ * Must be free'd with lilv_state_free().
+ */
+NONNULL
+LilvState *
+lv2_state_snapshot (Lv2Plugin * pl, bool is_backup);
+
+/**
+ * Writes a snapshot taken with lv2_state_snapshot()
+ * to the plugin's state dir, unless it equals the
+ * snapshot last written there.
+ *
+ * The written snapshot is kept to compare later
+ * snapshots with, so this takes ownership of
+ * @p state.
+ *
+ * This may be called from any thread. Writes of the
+ * same plugin are serialized.
+ *
+ * @return Whether successful.
+ */
+NONNULL
+bool
+lv2_state_write_snapshot (
+  Lv2Plugin * pl,
+  LilvState * state,
+  bool        is_backup);
+
 /**
  * Saves the plugin state to the filesystem and
  * returns the state.
@@ -111,6 +111,25 @@ lv2_ui_send_control_val_event_from_plugin_to_ui (
   Lv2Plugin * lv2_plugin,
   Port *      port);
 
+/**
+ * Passes the current value of the given control
+ * port to the plugin UI directly.
+ *
+ * Lv2Plugin.plugin_to_ui_events is only written by
+ * the realtime thread, so the GTK thread uses this
+ * instead.
+ *
+ * For property ports, a patch:Set of the property
+ * is sent instead (on the control input port).
+ *
+ * @note Must be called from the GTK thread.
+ */
+NONNULL
+void
+lv2_ui_update_control_val (
+  Lv2Plugin * lv2_plugin,
+  Port *      port);
+
 /**
  * @}
  */
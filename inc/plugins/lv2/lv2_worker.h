@@ -17,6 +17,8 @@
 #ifndef __PLUGINS_LV2_WORKER_H__
 #define __PLUGINS_LV2_WORKER_H__
 
+#include "utils/mpmc_queue.h"
+
 #include "lv2/worker/worker.h"
 #include "zix/ring.h"
 #include "zix/sem.h"
@@ -25,24 +27,145 @@
 
 typedef struct Lv2Plugin Lv2Plugin;
 
+/**
+ * Statistics of a Lv2WorkerPool.
+ */
+typedef struct Lv2WorkerPoolStats
+{
+  /** Requests scheduled but not yet serviced. */
+  int queue_depth;
+
+  /** Total number of requests serviced. */
+  gint64 num_serviced;
+
+  /** Average time between scheduling a request and
+   * servicing it, in microseconds. */
+  gint64 avg_latency_us;
+
+  /** Maximum time between scheduling a request and
+   * servicing it, in microseconds. */
+  gint64 max_latency_us;
+
+  /** Number of times a worker could not be queued
+   * because the queue was full (its requests are
+   * queued again on a later cycle). */
+  int num_dropped;
+} Lv2WorkerPoolStats;
+
+/**
+ * A fixed set of threads that service the
+ * threaded workers of all LV2 plugin instances.
+ *
+ * Workers with pending requests are pushed to a
+ * shared queue. A worker is queued at most once at
+ * a time so only one thread services a given
+ * plugin instance at a time, which preserves the
+ * order of its requests.
+ */
+typedef struct Lv2WorkerPool
+{
+  ZixThread * threads;
+  int         num_threads;
+
+  /** Workers (Lv2Worker) with pending requests. */
+  MPMCQueue * queue;
+
+  /** Posted once per queued worker. */
+  ZixSem sem;
+
+  /** Set when the pool is being freed. */
+  volatile gint exit;
+
+  /** Number of requests not yet serviced. */
+  volatile gint queue_depth;
+
+  /** Number of times a worker could not be queued
+   * because the queue was full (incremented from
+   * realtime threads). */
+  volatile gint num_dropped;
+
+  /** Value of num_dropped last reported by a pool
+   * thread. */
+  volatile gint num_dropped_reported;
+
+  /** Lock for the stats below. */
+  ZixSem stats_lock;
+  gint64 num_serviced;
+  gint64 total_latency_us;
+  gint64 max_latency_us;
+} Lv2WorkerPool;
+
 typedef struct
 {
   Lv2Plugin * plugin;    ///< Pointer back to the plugin
   ZixRing *   requests;  ///< Requests to the worker
   ZixRing *   responses; ///< Responses from the worker
   void *      response;  ///< Worker response buffer
-  ZixSem      sem;       ///< Worker semaphore
-  ZixThread   thread;    ///< Worker thread
   const LV2_Worker_Interface *
        iface;    ///< Plugin worker interface
   bool threaded; ///< Run work in another thread
+
+  /** Pool servicing this worker (if threaded). */
+  Lv2WorkerPool * pool;
+
+  /** Whether the worker is in the pool queue or is
+   * being serviced by a pool thread. */
+  volatile gint scheduled;
+
+  /** Held by the pool thread while servicing this
+   * worker. */
+  ZixSem service_lock;
+
+  /** Set by lv2_worker_finish() before waiting for
+   * the pool. */
+  volatile gint finishing;
+
+  /** Posted by the pool thread after servicing the
+   * worker if it is finishing. */
+  ZixSem finished;
 } Lv2Worker;
 
+/**
+ * Creates a worker pool with the given number of
+ * threads.
+ *
+ * @param num_threads Number of threads, or 0 to
+ *   use the ZRYTHM_LV2_WORKER_THREADS environment
+ *   variable (or a default based on the number of
+ *   CPU cores).
+ */
+Lv2WorkerPool *
+lv2_worker_pool_new (int num_threads);
+
+/**
+ * Fills in the current statistics of the pool.
+ */
+void
+lv2_worker_pool_get_stats (
+  Lv2WorkerPool *      self,
+  Lv2WorkerPoolStats * stats);
+
+/**
+ * Stops the pool threads and frees the pool.
+ *
+ * All workers using the pool must be finished
+ * before calling this.
+ */
+void
+lv2_worker_pool_free (Lv2WorkerPool * self);
+
+/**
+ * Initializes the worker.
+ *
+ * @param pool Pool to service the worker with if
+ *   @p threaded is true.
+ */
 void
 lv2_worker_init (
   Lv2Plugin *                  plugin,
   Lv2Worker *                  worker,
   const LV2_Worker_Interface * iface,
+  Lv2WorkerPool *              pool,
   bool                         threaded);
 
 /**
@@ -67,6 +190,10 @@ lv2_worker_schedule (
  *
  * Internally calls work_response in
  * https://lv2plug.in/doc/html/group__worker.html.
+ *
+ * This also queues the worker again if its
+ * requests could not be queued because the pool
+ * queue was full.
  */
 void
 lv2_worker_emit_responses (
@@ -236,6 +236,22 @@ typedef struct Lv2Plugin
    */
   char * temp_dir;
 
+  /** State last written to saved_state_dir, used
+   * to skip rewriting unchanged states. */
+  LilvState * saved_state;
+
+  /** Absolute path of the dir the state was last
+   * written to. */
+  char * saved_state_dir;
+
+  /** World the states of this plugin are written
+   * with, so that states of different plugins can
+   * be written in parallel. */
+  LilvWorld * state_world;
+
+  /** Serializes state writes of this plugin. */
+  GMutex state_lock;
+
   /** Frames since last update sent to UI. */
   uint32_t event_delta_t;
   uint32_t
@@ -565,6 +581,20 @@ lv2_plugin_set_control (
   LV2_URID     type,
   const void * body);
 
+/**
+ * Forges a patch:Set of the given numeric property
+ * port's current value into @p buf.
+ *
+ * @return The forged atom (at the start of @p buf).
+ */
+NONNULL
+const LV2_Atom *
+lv2_plugin_forge_property_set (
+  LV2_Atom_Forge * forge,
+  Port *           port,
+  uint8_t *        buf,
+  uint32_t         buf_size);
+
 /**
  * Returns the property port matching the given
  * property URID.
@@ -207,6 +207,11 @@ typedef struct Plugin
    * deleted. */
   bool deleting;
 
+  /** Whether the state was just saved by
+   * plugin_write_state_snapshots(), so cloning does
+   * not need to save it again. */
+  bool state_saved;
+
   /** Active preset item, if wrapped or generic
    * UI. */
   GtkWidget * active_preset_item;
@@ -268,6 +273,32 @@ typedef struct Plugin
    */
   int state_changed_event_sent;
 
+  /**
+   * Set when a control port changed since the last
+   * cycle.
+   *
+   * All such changes are delivered to the plugin
+   * in one batch at the start of the next cycle.
+   */
+  volatile gint control_changes_pending;
+
+  /**
+   * Set when a control port changed since the last
+   * UI refresh.
+   *
+   * The UI is notified of the latest value of each
+   * changed port on its next refresh.
+   */
+  volatile gint ui_control_changes_pending;
+
+  /**
+   * Set by the realtime thread when the latency
+   * reported by the plugin changed.
+   *
+   * @seealso router_update_plugin_latencies().
+   */
+  volatile gint latency_changed;
+
   /** Whether the plugin is used for functions. */
   bool is_function;
 
@@ -601,6 +632,39 @@ plugin_get_all (
   GPtrArray * arr,
   bool        check_undo_manager);
 
+/**
+ * Takes snapshots of the states of the given
+ * plugins, to be written with
+ * plugin_write_state_snapshots().
+ *
+ * Only LV2 states are snapshotted here. Carla
+ * plugins save their state when the snapshots are
+ * written.
+ *
+ * The snapshotted plugins are marked with
+ * Plugin.state_saved, which the caller must clear
+ * when done.
+ *
+ * @note The engine must be paused.
+ *
+ * @return An opaque array of snapshots.
+ */
+NONNULL
+GPtrArray *
+plugin_snapshot_states (GPtrArray * plugins, bool is_backup);
+
+/**
+ * Writes the snapshots taken with
+ * plugin_snapshot_states() in parallel worker
+ * threads and frees them.
+ *
+ * Unchanged state files are not rewritten. The
+ * engine does not need to be paused.
+ */
+NONNULL
+void
+plugin_write_state_snapshots (GPtrArray * snapshots);
+
 NONNULL
 Channel *
 plugin_get_channel (Plugin * self);
@@ -19,6 +19,7 @@
 
 typedef struct CachedPluginDescriptors CachedPluginDescriptors;
 typedef struct PluginCollections       PluginCollections;
+typedef struct Lv2WorkerPool           Lv2WorkerPool;
 
 /**
  * @addtogroup plugins
@@ -83,6 +84,10 @@ typedef struct PluginManager
 
   char * lv2_path;
 
+  /** Threads servicing the workers of all LV2
+   * plugin instances. */
+  Lv2WorkerPool * lv2_worker_pool;
+
   /** Whether the plugin manager has been set up
    * already. */
   bool setup;
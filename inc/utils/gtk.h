@@ -759,6 +759,38 @@ z_gtk_list_box_remove_all_children (GtkListBox * list_box);
 void
 z_graphene_rect_print (const graphene_rect_t * rect);
 
+/**
+ * Queues a redraw of the widget if \p version is
+ * different from the version passed the last time.
+ *
+ * This is meant to be called from tick callbacks
+ * instead of redrawing on every frame, with a
+ * version that changes whenever anything the widget
+ * draws changes (a counter or a hash of the drawn
+ * state).
+ *
+ * @return Whether a redraw was queued.
+ */
+bool
+z_gtk_widget_queue_draw_if_changed (
+  GtkWidget * widget,
+  guint64     version);
+
+/**
+ * Counts the redraws of the widget and draws the
+ * number of redraws in the last second on top of
+ * it.
+ *
+ * Does nothing unless the ZRYTHM_DEBUG_REDRAWS
+ * environment variable is set to 1.
+ *
+ * To be called at the end of snapshot functions.
+ */
+void
+z_gtk_widget_snapshot_redraw_count (
+  GtkWidget *   widget,
+  GtkSnapshot * snapshot);
+
 /**
  * @}
  */
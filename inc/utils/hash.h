@@ -10,6 +10,7 @@
 #ifndef __UTILS_HASH_H__
 #define __UTILS_HASH_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <xxhash.h>
@@ -47,6 +48,26 @@ hash_get_for_struct_full (
 uint32_t
 hash_get_for_struct (const void * const obj, size_t size);
 
+/** Initial hash to pass to hash_fnv1a(). */
+#define HASH_FNV1A_INIT 0xcbf29ce484222325ULL
+
+/**
+ * Hashes the given variable into \p hash with
+ * hash_fnv1a().
+ */
+#define HASH_FNV1A_VAL(hash, val) \
+  hash = hash_fnv1a (hash, &(val), sizeof (val))
+
+/**
+ * FNV-1a hash of the bytes, continuing from the
+ * given hash.
+ *
+ * This is cheap enough to hash small amounts of
+ * state on every frame.
+ */
+uint64_t
+hash_fnv1a (uint64_t hash, const void * data, size_t size);
+
 /**
  * @}
  */
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+/**
+ * \file
+ *
+ * Interval tree for overlap queries.
+ */
+
+#ifndef __UTILS_INTERVAL_TREE_H__
+#define __UTILS_INTERVAL_TREE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <glib.h>
+
+/**
+ * @addtogroup utils
+ *
+ * @{
+ */
+
+/**
+ * An interval with its data.
+ */
+typedef struct IntervalTreeEntry
+{
+  double start;
+  double end;
+
+  /** Index in the order the entry was added. */
+  size_t idx;
+
+  void * data;
+} IntervalTreeEntry;
+
+/**
+ * Static interval tree.
+ *
+ * Intervals are added first and the tree is built
+ * on the first query, after which finding the
+ * intervals that overlap a range takes
+ * O(log n + k) time.
+ *
+ * The tree is stored implicitly in an array sorted
+ * by start, where the middle entry of each range is
+ * the root of the range and also stores the max end
+ * of the range.
+ */
+typedef struct IntervalTree
+{
+  IntervalTreeEntry * entries;
+  size_t              num_entries;
+  size_t              entries_size;
+
+  /** Max end of the subtree rooted at each entry. */
+  double * max_ends;
+
+  /** Whether the tree needs to be built before
+   * querying. */
+  bool needs_build;
+} IntervalTree;
+
+IntervalTree *
+interval_tree_new (void);
+
+/**
+ * Adds an interval.
+ *
+ * @param start Start of the interval (inclusive).
+ * @param end End of the interval (inclusive). Must
+ *   not be before @p start.
+ */
+NONNULL_ARGS (1)
+void
+interval_tree_add (
+  IntervalTree * self,
+  double         start,
+  double         end,
+  void *         data);
+
+/**
+ * Appends the data of the intervals that overlap
+ * the given range to @p arr, in the order they were
+ * added.
+ */
+NONNULL void
+interval_tree_query (
+  IntervalTree * self,
+  double         start,
+  double         end,
+  GPtrArray *    arr);
+
+/**
+ * Removes all intervals.
+ */
+NONNULL void
+interval_tree_clear (IntervalTree * self);
+
+NONNULL void
+interval_tree_free (IntervalTree * self);
+
+/**
+ * @}
+ */
+
+#endif
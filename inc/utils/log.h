@@ -5,6 +5,7 @@
 #define __UTILS_LOG_H__
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include <gtk/gtk.h>
 
@@ -20,6 +21,69 @@ typedef struct ObjectPool       ObjectPool;
 
 #define LOG (zlog)
 
+/**
+ * Maximum number of threads that can log with
+ * log_rt() at the same time.
+ */
+#define LOG_RT_MAX_THREADS 32
+
+/** Number of records in each LogRtRing (power of
+ * 2). */
+#define LOG_RT_RING_SIZE 128
+
+/** Maximum number of arguments to log_rt(). */
+#define LOG_RT_MAX_ARGS 8
+
+/** Space for the string arguments of a record. */
+#define LOG_RT_STRS_SIZE 128
+
+typedef enum LogRtArgType
+{
+  LOG_RT_ARG_INT,
+  LOG_RT_ARG_UINT,
+  LOG_RT_ARG_DOUBLE,
+  LOG_RT_ARG_PTR,
+  LOG_RT_ARG_STR,
+} LogRtArgType;
+
+/**
+ * A raw argument to log_rt().
+ */
+typedef struct LogRtArg
+{
+  LogRtArgType type;
+  union
+  {
+    int64_t      i;
+    uint64_t     u;
+    double       d;
+    const void * p;
+
+    /** The string when passed to log_rt_push(),
+     * then its offset in LogRtRecord.strs. */
+    const char * s;
+    size_t       str_offset;
+  } val;
+} LogRtArg;
+
+/**
+ * An unformatted message logged with log_rt().
+ */
+typedef struct LogRtRecord
+{
+  GLogLevelFlags log_level;
+
+  /** Format string (must be a literal). */
+  const char * fmt;
+
+  LogRtArg args[LOG_RT_MAX_ARGS];
+  int      num_args;
+
+  /** Copies of the string arguments, truncated if
+   * they don't fit. */
+  char strs[LOG_RT_STRS_SIZE];
+} LogRtRecord;
+
 typedef struct Log
 {
   FILE * logfile;
@@ -75,8 +139,168 @@ typedef struct Log
    * popups at once.
    */
   gint64 last_bt_time;
+
+  /** Messages dropped because all rings were
+   * claimed, or because the event pool was
+   * exhausted off the GTK thread. */
+  volatile guint rt_num_dropped;
+
+  /** Dropped messages already reported (log thread
+   * only). */
+  guint rt_num_dropped_reported;
+
+  /** Thread formatting the log_rt() messages. */
+  GThread * rt_thread;
+
+  /** Set to stop Log.rt_thread. */
+  volatile gint rt_thread_stop;
 } Log;
 
+static inline LogRtArg
+log_rt_arg_int (int64_t val)
+{
+  return (LogRtArg){ .type = LOG_RT_ARG_INT, .val.i = val };
+}
+
+static inline LogRtArg
+log_rt_arg_uint (uint64_t val)
+{
+  return (LogRtArg){ .type = LOG_RT_ARG_UINT, .val.u = val };
+}
+
+static inline LogRtArg
+log_rt_arg_double (double val)
+{
+  return (LogRtArg){
+    .type = LOG_RT_ARG_DOUBLE, .val.d = val
+  };
+}
+
+static inline LogRtArg
+log_rt_arg_ptr (const void * val)
+{
+  return (LogRtArg){ .type = LOG_RT_ARG_PTR, .val.p = val };
+}
+
+static inline LogRtArg
+log_rt_arg_str (const char * val)
+{
+  return (LogRtArg){ .type = LOG_RT_ARG_STR, .val.s = val };
+}
+
+#define LOG_RT_ARG(x) \
+  _Generic ( \
+    (x), \
+    char *: log_rt_arg_str, \
+    const char *: log_rt_arg_str, \
+    float: log_rt_arg_double, \
+    double: log_rt_arg_double, \
+    _Bool: log_rt_arg_int, \
+    char: log_rt_arg_int, \
+    signed char: log_rt_arg_int, \
+    short: log_rt_arg_int, \
+    int: log_rt_arg_int, \
+    long: log_rt_arg_int, \
+    long long: log_rt_arg_int, \
+    unsigned char: log_rt_arg_uint, \
+    unsigned short: log_rt_arg_uint, \
+    unsigned int: log_rt_arg_uint, \
+    unsigned long: log_rt_arg_uint, \
+    unsigned long long: log_rt_arg_uint, \
+    default: log_rt_arg_ptr) (x)
+
+#define LOG_RT_NUM_ARGS(...) \
+  LOG_RT_NUM_ARGS_ ( \
+    __VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, _)
+#define LOG_RT_NUM_ARGS_( \
+  fmt, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) \
+  n
+
+#define LOG_RT_ARGS_0(fmt)
+#define LOG_RT_ARGS_1(fmt, a) LOG_RT_ARG (a),
+#define LOG_RT_ARGS_2(fmt, a, ...) \
+  LOG_RT_ARG (a), LOG_RT_ARGS_1 (fmt, __VA_ARGS__)
+#define LOG_RT_ARGS_3(fmt, a, ...) \
+  LOG_RT_ARG (a), LOG_RT_ARGS_2 (fmt, __VA_ARGS__)
+#define LOG_RT_ARGS_4(fmt, a, ...) \
+  LOG_RT_ARG (a), LOG_RT_ARGS_3 (fmt, __VA_ARGS__)
+#define LOG_RT_ARGS_5(fmt, a, ...) \
+  LOG_RT_ARG (a), LOG_RT_ARGS_4 (fmt, __VA_ARGS__)
+#define LOG_RT_ARGS_6(fmt, a, ...) \
+  LOG_RT_ARG (a), LOG_RT_ARGS_5 (fmt, __VA_ARGS__)
+#define LOG_RT_ARGS_7(fmt, a, ...) \
+  LOG_RT_ARG (a), LOG_RT_ARGS_6 (fmt, __VA_ARGS__)
+#define LOG_RT_ARGS_8(fmt, a, ...) \
+  LOG_RT_ARG (a), LOG_RT_ARGS_7 (fmt, __VA_ARGS__)
+#define LOG_RT_CONCAT(a, b) LOG_RT_CONCAT_ (a, b)
+#define LOG_RT_CONCAT_(a, b) a##b
+#define LOG_RT_FMT(fmt, ...) fmt
+
+/**
+ * Logs a message from a real-time thread.
+ *
+ * The format string and the raw arguments are
+ * copied to a ring owned by the calling thread and
+ * formatted later by the log thread, so this
+ * never allocates, locks or does I/O. Up to
+ * \ref LOG_RT_MAX_ARGS arguments are supported.
+ *
+ * The format string must be a literal, since only
+ * its pointer is stored. String arguments are
+ * copied (truncated if needed). Field widths and
+ * precisions given with '*' are not supported.
+ *
+ * Messages are dropped (and the number of dropped
+ * messages logged later) if the ring is full.
+ */
+#define log_rt(log_level, ...) \
+  log_rt_push ( \
+    LOG, log_level, LOG_RT_FMT (__VA_ARGS__, _), \
+    (const LogRtArg[]){ LOG_RT_CONCAT ( \
+      LOG_RT_ARGS_, LOG_RT_NUM_ARGS (__VA_ARGS__)) ( \
+      __VA_ARGS__) { 0 } }, \
+    LOG_RT_NUM_ARGS (__VA_ARGS__))
+
+#define log_rt_message(...) \
+  log_rt (G_LOG_LEVEL_MESSAGE, __VA_ARGS__)
+#define log_rt_warning(...) \
+  log_rt (G_LOG_LEVEL_WARNING, __VA_ARGS__)
+
+/**
+ * Pushes a message to the ring of the calling
+ * thread.
+ *
+ * Use log_rt() instead.
+ *
+ * @param self The Log, or NULL to drop the
+ *   message.
+ */
+void
+log_rt_push (
+  Log *            self,
+  GLogLevelFlags   log_level,
+  const char *     fmt,
+  const LogRtArg * args,
+  int              num_args);
+
+/**
+ * Marks the current thread as a real-time thread.
+ *
+ * The regular log writer never flushes its queue
+ * from marked threads. This is only a thread-local
+ * store, so it can be called every cycle.
+ */
+void
+log_rt_mark_thread (void);
+
+/**
+ * Formats the given record into @p buf.
+ */
+NONNULL void
+log_rt_record_format (
+  const LogRtRecord * rec,
+  GString *           buf);
+
 /** Global variable, available to all files. */
 extern Log * zlog;
 
@@ -95,6 +95,18 @@ mpmc_queue_clear (MPMCQueue * self);
 HOT NONNULL int
 mpmc_queue_push_back (MPMCQueue * self, void * const data);
 
+/**
+ * Same as mpmc_queue_push_back() but returns 0
+ * without logging if the queue is full.
+ *
+ * To be used from realtime threads, where logging
+ * is not allowed.
+ */
+HOT NONNULL int
+mpmc_queue_try_push_back (
+  MPMCQueue * self,
+  void * const data);
+
 HOT NONNULL int
 mpmc_queue_dequeue (MPMCQueue * self, void ** data);
 
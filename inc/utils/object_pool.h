@@ -26,7 +26,7 @@
 #ifndef __UTILS_OBJECT_POOL_H__
 #define __UTILS_OBJECT_POOL_H__
 
-#include "zix/sem.h"
+#include "utils/mpmc_queue.h"
 
 /**
  * Function to call to create the objects in the
@@ -40,19 +40,25 @@ typedef void * (*ObjectCreatorFunc) (void);
  */
 typedef void (*ObjectFreeFunc) (void *);
 
+/**
+ * Pool of preallocated objects.
+ *
+ * Getting and returning objects is lock-free, so it
+ * can be done from the realtime thread.
+ */
 typedef struct ObjectPool
 {
   int max_objects;
 
-  /** Available objects. */
-  void ** obj_available;
-  int     num_obj_available;
+  /** Queue of available objects. */
+  MPMCQueue * obj_available;
+
+  /** Number of objects in
+   * ObjectPool.obj_available. */
+  volatile gint num_obj_available;
 
   /** Object free func. */
   ObjectFreeFunc free_func;
-
-  /** Semaphore for atomic operations. */
-  ZixSem access_sem;
 } ObjectPool;
 
 /**
@@ -65,7 +71,8 @@ object_pool_new (
   int               max_objects);
 
 /**
- * Returns an available object.
+ * Returns an available object, or NULL if all
+ * objects are in use.
  */
 void *
 object_pool_get (ObjectPool * self);
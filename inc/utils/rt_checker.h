@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+/**
+ * \file
+ *
+ * Detector for allocations, locks and file I/O in
+ * the processing threads.
+ */
+
+#ifndef __UTILS_RT_CHECKER_H__
+#define __UTILS_RT_CHECKER_H__
+
+#include <stdbool.h>
+
+/**
+ * @addtogroup utils
+ *
+ * @{
+ */
+
+/** Maximum number of violations recorded. */
+#define RT_CHECKER_MAX_VIOLATIONS 64
+
+/** Maximum number of backtrace frames per
+ * violation. */
+#define RT_CHECKER_MAX_FRAMES 32
+
+typedef enum RtCheckerViolationType
+{
+  RT_CHECKER_VIOLATION_ALLOC,
+  RT_CHECKER_VIOLATION_FREE,
+  RT_CHECKER_VIOLATION_LOCK,
+  RT_CHECKER_VIOLATION_FILE_IO,
+} RtCheckerViolationType;
+
+/**
+ * A call made from a real-time section.
+ */
+typedef struct RtCheckerViolation
+{
+  RtCheckerViolationType type;
+
+  /** Name of the interposed function. */
+  const char * func;
+
+  void * frames[RT_CHECKER_MAX_FRAMES];
+  int    num_frames;
+} RtCheckerViolation;
+
+/**
+ * Marks the start of a real-time section in the
+ * current thread.
+ *
+ * Sections can be nested. When zrythm is built with
+ * the \c rt_checker option, malloc()/free(), mutex
+ * and semaphore waits and file I/O inside a section
+ * are recorded as violations.
+ */
+void
+rt_checker_enter (void);
+
+/**
+ * Marks the end of a real-time section.
+ */
+void
+rt_checker_leave (void);
+
+/**
+ * Starts a part of a real-time section where
+ * blocking is intended (such as waiting for the
+ * graph threads).
+ */
+void
+rt_checker_allow_begin (void);
+
+void
+rt_checker_allow_end (void);
+
+/**
+ * Returns whether the current thread is in a
+ * real-time section (and not in an allowed part).
+ */
+bool
+rt_checker_is_active (void);
+
+/**
+ * Records a violation with a backtrace of the
+ * current thread.
+ *
+ * Called by the interposed functions.
+ */
+void
+rt_checker_record (
+  RtCheckerViolationType type,
+  const char *           func);
+
+/**
+ * Returns whether the interposed functions are
+ * compiled in.
+ */
+bool
+rt_checker_is_available (void);
+
+/**
+ * Returns the number of violations since the last
+ * call to rt_checker_clear(), including the ones
+ * that were not recorded.
+ */
+int
+rt_checker_get_num_violations (void);
+
+/**
+ * Returns a newly allocated report of the recorded
+ * violations with symbolized backtraces.
+ *
+ * Must not be called from a real-time section.
+ */
+char *
+rt_checker_get_report (void);
+
+/**
+ * Forgets the recorded violations.
+ */
+void
+rt_checker_clear (void);
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+/**
+ * \file
+ *
+ * Trigram index for incremental text search.
+ */
+
+#ifndef __UTILS_SEARCH_INDEX_H__
+#define __UTILS_SEARCH_INDEX_H__
+
+#include <stdbool.h>
+
+#include <glib.h>
+
+/**
+ * @addtogroup utils
+ *
+ * @{
+ */
+
+/**
+ * How the matches changed after setting a query.
+ */
+typedef enum SearchIndexChange
+{
+  /** Same matches as before. */
+  SEARCH_INDEX_CHANGE_NONE,
+
+  /** The matches are a subset of the previous
+   * matches. */
+  SEARCH_INDEX_CHANGE_MORE_STRICT,
+
+  /** The matches are a superset of the previous
+   * matches. */
+  SEARCH_INDEX_CHANGE_LESS_STRICT,
+
+  /** The matches may be completely different. */
+  SEARCH_INDEX_CHANGE_DIFFERENT,
+} SearchIndexChange;
+
+/**
+ * Index of the case-folded texts of a set of items.
+ *
+ * An item matches a query if its text contains every
+ * whitespace-separated token of the query. Candidates
+ * are taken from the shortest list of items containing
+ * one of the trigrams of the query, or from the
+ * previous matches when the query was only extended,
+ * so only a few items are checked per keystroke.
+ */
+typedef struct SearchIndex
+{
+  /** Data of each item. */
+  GPtrArray * items;
+
+  /** Case-folded text of each item. */
+  GPtrArray * texts;
+
+  /** Item data -> item index + 1. */
+  GHashTable * item_indices;
+
+  /** Trigram -> GArray of the indices of the items
+   * containing it, in ascending order. */
+  GHashTable * trigrams;
+
+  /** Case-folded current query, or NULL if there is
+   * no query. */
+  char * query;
+
+  /** Tokens of SearchIndex.query. */
+  char ** tokens;
+
+  /** Whether each item matches the current query. */
+  GByteArray * matches;
+
+  /** Indices of the items matching the current
+   * query. */
+  GArray * match_indices;
+} SearchIndex;
+
+SearchIndex *
+search_index_new (void);
+
+/**
+ * Adds an item.
+ *
+ * @param text Text to search in. Separate fields with
+ *   newlines so that tokens don't match across them.
+ */
+NONNULL_ARGS (1, 3)
+void
+search_index_add (
+  SearchIndex * self,
+  void *        data,
+  const char *  text);
+
+/**
+ * Sets the query and updates the matches.
+ *
+ * @param text Query, or NULL or an empty string to
+ *   match all items.
+ */
+NONNULL_ARGS (1)
+SearchIndexChange
+search_index_set_query (
+  SearchIndex * self,
+  const char *  text);
+
+/**
+ * Returns whether the item with the given data
+ * matches the current query.
+ */
+NONNULL_ARGS (1)
+bool
+search_index_matches (SearchIndex * self, const void * data);
+
+NONNULL void
+search_index_free (SearchIndex * self);
+
+/**
+ * @}
+ */
+
+#endif
@@ -173,6 +173,10 @@ typedef enum ZrythmDirType
   /** Backtraces. */
   ZRYTHM_DIR_USER_BACKTRACE,
 
+  /** Waveform peak files, keyed by audio file
+   * hash. */
+  ZRYTHM_DIR_USER_PEAKS,
+
 } ZrythmDirType;
 
 /**
@@ -2259,6 +2259,7 @@ do_or_undo_edit (
                   }
                   break;
                 case ARRANGER_SELECTIONS_ACTION_EDIT_POS:
+                  arranger_object_positions_changed ();
                   obj->pos = own_dest_obj->pos;
                   obj->end_pos = own_dest_obj->end_pos;
                   obj->clip_start_pos =
@@ -34,6 +34,125 @@ range_action_init_loaded (RangeAction * self)
   transport_init_loaded (self->transport, NULL, NULL);
 }
 
+/**
+ * Returns whether the given project object needs to
+ * be split, deleted or clamped by the action (as
+ * opposed to simply shifted in place).
+ */
+static bool
+is_affected (
+  const RangeAction *    self,
+  const ArrangerObject * prj_obj)
+{
+  /* objects starting before the range and ending
+   * after the range start are always split */
+  if (
+    arranger_object_is_hit (prj_obj, &self->start_pos, NULL)
+    && position_is_before (&prj_obj->pos, &self->start_pos))
+    return true;
+
+  switch (self->type)
+    {
+    case RANGE_ACTION_INSERT_SILENCE:
+      return false;
+    case RANGE_ACTION_REMOVE:
+      return position_is_before (
+               &prj_obj->pos, &self->end_pos)
+             || (arranger_object_is_hit (
+                   prj_obj, &self->end_pos, NULL)
+                 && position_is_after (
+                   &prj_obj->end_pos, &self->end_pos));
+    default:
+      break;
+    }
+  g_return_val_if_reached (true);
+}
+
+/**
+ * Moves all project objects starting at or after
+ * @p from by @p ticks in place, without cloning.
+ *
+ * @param skip_affected Whether to skip objects that
+ *   will be split or deleted (only needed on the
+ *   first run, before those are processed).
+ */
+static void
+shift_objects (
+  RangeAction * self,
+  Position *    from,
+  double        ticks,
+  bool          skip_affected)
+{
+  Position inf;
+  position_set_to_bar (&inf, POSITION_MAX_BAR);
+  TimelineSelections * sel = timeline_selections_new_for_range (
+    from, &inf, F_NO_CLONE);
+  GPtrArray * objs = g_ptr_array_new ();
+  arranger_selections_get_all_objects (
+    (ArrangerSelections *) sel, objs);
+
+  int num_shifted = 0;
+  for (size_t i = 0; i < objs->len; i++)
+    {
+      ArrangerObject * obj =
+        (ArrangerObject *) g_ptr_array_index (objs, i);
+      if (
+        position_is_before (&obj->pos, from)
+        || (skip_affected && is_affected (self, obj)))
+        continue;
+
+      arranger_object_move (obj, ticks);
+      num_shifted++;
+    }
+  g_debug (
+    "shifted %d objects by %f ticks", num_shifted, ticks);
+
+  g_ptr_array_unref (objs);
+  arranger_selections_free ((ArrangerSelections *) sel);
+}
+
+/**
+ * Removes the project counterparts of
+ * @p objs_to_remove, shifts the remaining objects
+ * and adds clones of @p objs_to_add.
+ *
+ * Used when redoing/undoing, where only the
+ * split/deleted objects are stored.
+ */
+static void
+swap_objects_and_shift (
+  RangeAction * self,
+  GPtrArray *   objs_to_remove,
+  GPtrArray *   objs_to_add,
+  Position *    shift_from,
+  double        shift_ticks)
+{
+  /* remove all matching project objects */
+  for (int i = (int) objs_to_remove->len - 1; i >= 0; i--)
+    {
+      ArrangerObject * obj = (ArrangerObject *)
+        g_ptr_array_index (objs_to_remove, i);
+
+      /* get project object and remove it from
+       * the project */
+      ArrangerObject * prj_obj = arranger_object_find (obj);
+      arranger_object_remove_from_project (prj_obj);
+    }
+
+  shift_objects (self, shift_from, shift_ticks, false);
+
+  /* add clones of all objects in order */
+  for (size_t i = 0; i < objs_to_add->len; i++)
+    {
+      ArrangerObject * obj = (ArrangerObject *)
+        g_ptr_array_index (objs_to_add, i);
+
+      /* clone object and add to project */
+      ArrangerObject * prj_obj = arranger_object_clone (obj);
+      arranger_object_insert_to_project (prj_obj);
+    }
+}
+
 /**
  * Creates a new action.
  *
@@ -61,11 +180,33 @@ range_action_new (
   self->end_pos = *end_pos;
   self->first_run = true;
 
-  /* create selections for overlapping objects */
+  /* only clone objects that will be split or
+   * deleted - the rest are shifted in place by the
+   * range size */
   Position inf;
   position_set_to_bar (&inf, POSITION_MAX_BAR);
-  self->sel_before = timeline_selections_new_for_range (
-    start_pos, &inf, F_CLONE);
+  TimelineSelections * range_sel =
+    timeline_selections_new_for_range (
+      start_pos, &inf, F_NO_CLONE);
+  GPtrArray * range_objs = g_ptr_array_new ();
+  arranger_selections_get_all_objects (
+    (ArrangerSelections *) range_sel, range_objs);
+  self->sel_before = (TimelineSelections *)
+    arranger_selections_new (ARRANGER_SELECTIONS_TYPE_TIMELINE);
+  for (size_t i = 0; i < range_objs->len; i++)
+    {
+      ArrangerObject * prj_obj = (ArrangerObject *)
+        g_ptr_array_index (range_objs, i);
+      if (!is_affected (self, prj_obj))
+        continue;
+
+      ArrangerObject * clone =
+        arranger_object_clone (prj_obj);
+      arranger_selections_add_object (
+        (ArrangerSelections *) self->sel_before, clone);
+    }
+  g_ptr_array_unref (range_objs);
+  arranger_selections_free ((ArrangerSelections *) range_sel);
   self->sel_after = (TimelineSelections *)
     arranger_selections_new (ARRANGER_SELECTIONS_TYPE_TIMELINE);
 
@@ -183,11 +324,12 @@ range_action_do (RangeAction * self, GError ** error)
 
   /* temporary place to store project objects, so
    * we can get their final identifiers at the end */
-  ArrangerObject * prj_objs[before_objs_arr->len * 2];
+  ArrangerObject * prj_objs[before_objs_arr->len * 2 + 1];
   int              num_prj_objs = 0;
 
   /* after objects corresponding to the above */
-  ArrangerObject * after_objs_for_prj[before_objs_arr->len * 2];
+  ArrangerObject *
+    after_objs_for_prj[before_objs_arr->len * 2 + 1];
 
 #define ADD_AFTER(_prj_obj, _after_obj) \
   add_to_sel_after ( \
@@ -199,6 +341,13 @@ range_action_do (RangeAction * self, GError ** error)
     case RANGE_ACTION_INSERT_SILENCE:
       if (self->first_run)
         {
+          /* move all unaffected objects starting at
+           * or after the range start */
+          shift_objects (
+            self, &self->start_pos, range_size_ticks, true);
+
+          /* split the objects intersecting with the
+           * range start */
           for (int i = (int) before_objs_arr->len - 1; i >= 0;
                i--)
             {
@@ -216,97 +365,45 @@ range_action_do (RangeAction * self, GError ** error)
               ArrangerObject * prj_obj =
                 arranger_object_find (obj);
 
-              /* object starts before the range and
-               * ends after the range start -
-               * split at range start */
-              if (
-                arranger_object_is_hit (
-                  prj_obj, &self->start_pos, NULL)
-                && position_is_before (
-                  &prj_obj->pos, &self->start_pos))
-                {
-                  /* split at range start */
-                  ArrangerObject *part1, *part2;
-                  arranger_object_split (
-                    obj, &self->start_pos, false, &part1,
-                    &part2, false);
-
-                  /* move part2 by the range
-                   * amount */
-                  arranger_object_move (
-                    part2, range_size_ticks);
-
-                  /* remove previous object */
-                  arranger_object_remove_from_project (
-                    prj_obj);
-
-                  /* create clones and add to
-                   * project */
-                  ArrangerObject * prj_part1 =
-                    arranger_object_clone (part1);
-                  arranger_object_add_to_project (
-                    prj_part1, F_NO_PUBLISH_EVENTS);
+              /* split at range start */
+              ArrangerObject *part1, *part2;
+              arranger_object_split (
+                obj, &self->start_pos, false, &part1, &part2,
+                false);
 
-                  ArrangerObject * prj_part2 =
-                    arranger_object_clone (part2);
-                  arranger_object_add_to_project (
-                    prj_part2, F_NO_PUBLISH_EVENTS);
+              /* move part2 by the range amount */
+              arranger_object_move (part2, range_size_ticks);
 
-                  g_message (
-                    "object split and moved into the"
-                    " following objects");
-                  arranger_object_print (prj_part1);
-                  arranger_object_print (prj_part2);
+              /* remove previous object */
+              arranger_object_remove_from_project (prj_obj);
 
-                  ADD_AFTER (prj_part1, part1);
-                  ADD_AFTER (prj_part2, part2);
-                }
-              /* object starts at or after range
-               * start - only needs a move */
-              else
-                {
-                  arranger_object_move (
-                    prj_obj, range_size_ticks);
+              /* create clones and add to project */
+              ArrangerObject * prj_part1 =
+                arranger_object_clone (part1);
+              arranger_object_add_to_project (
+                prj_part1, F_NO_PUBLISH_EVENTS);
 
-                  /* clone and add to sel_after */
-                  ArrangerObject * obj_clone =
-                    arranger_object_clone (prj_obj);
+              ArrangerObject * prj_part2 =
+                arranger_object_clone (part2);
+              arranger_object_add_to_project (
+                prj_part2, F_NO_PUBLISH_EVENTS);
 
-                  g_message ("moved to object:");
-                  arranger_object_print (prj_obj);
+              g_message (
+                "object split and moved into the"
+                " following objects");
+              arranger_object_print (prj_part1);
+              arranger_object_print (prj_part2);
 
-                  ADD_AFTER (prj_obj, obj_clone);
-                }
+              ADD_AFTER (prj_part1, part1);
+              ADD_AFTER (prj_part2, part2);
             }
           self->first_run = false;
         }
       else /* not first run */
         {
-          /* remove all matching project objects
-           * from sel_before */
-          for (int i = (int) before_objs_arr->len - 1; i >= 0;
-               i--)
-            {
-              ArrangerObject * obj = (ArrangerObject *)
-                g_ptr_array_index (before_objs_arr, i);
-
-              /* get project object and remove it
-               * from the project */
-              ArrangerObject * prj_obj =
-                arranger_object_find (obj);
-              arranger_object_remove_from_project (prj_obj);
-            }
-          /* add all objects from sel_after */
-          for (size_t i = 0; i < after_objs_arr->len; i++)
-            {
-              ArrangerObject * obj =
-                g_ptr_array_index (after_objs_arr, i);
-
-              /* clone object and add to project */
-              ArrangerObject * prj_obj =
-                arranger_object_clone (obj);
-              arranger_object_insert_to_project (prj_obj);
-            }
+          swap_objects_and_shift (
+            self, before_objs_arr, after_objs_arr,
+            &self->start_pos, range_size_ticks);
         }
 
       /* move transport markers */
@@ -315,6 +412,11 @@ range_action_do (RangeAction * self, GError ** error)
     case RANGE_ACTION_REMOVE:
       if (self->first_run)
         {
+          /* move back all unaffected objects starting
+           * at or after the range end */
+          shift_objects (
+            self, &self->end_pos, -range_size_ticks, true);
+
           for (int i = (int) before_objs_arr->len - 1; i >= 0;
                i--)
             {
@@ -487,8 +589,10 @@ range_action_do (RangeAction * self, GError ** error)
                   arranger_object_remove_from_project (
                     prj_obj);
                 }
-              /* object starts at or after range
-               * start - only needs a move */
+              /* object starts inside the range and
+               * is kept (start/end markers, objects
+               * ending exactly at the range end) -
+               * move and clamp */
               else
                 {
                   arranger_object_move (
@@ -519,31 +623,9 @@ range_action_do (RangeAction * self, GError ** error)
         }
       else /* not first run */
         {
-          /* remove all matching project objects
-           * from sel_before */
-          for (int i = (int) before_objs_arr->len - 1; i >= 0;
-               i--)
-            {
-              ArrangerObject * obj = (ArrangerObject *)
-                g_ptr_array_index (before_objs_arr, i);
-
-              /* get project object and remove it
-               * from the project */
-              ArrangerObject * prj_obj =
-                arranger_object_find (obj);
-              arranger_object_remove_from_project (prj_obj);
-            }
-          /* add all objects from sel_after */
-          for (size_t i = 0; i < after_objs_arr->len; i++)
-            {
-              ArrangerObject * obj =
-                g_ptr_array_index (after_objs_arr, i);
-
-              /* clone object and add to project */
-              ArrangerObject * prj_obj =
-                arranger_object_clone (obj);
-              arranger_object_insert_to_project (prj_obj);
-            }
+          swap_objects_and_shift (
+            self, before_objs_arr, after_objs_arr,
+            &self->end_pos, -range_size_ticks);
         }
 
       /* move transport markers */
@@ -590,44 +672,25 @@ range_action_undo (RangeAction * self, GError ** error)
     position_to_ticks (&self->end_pos)
     - position_to_ticks (&self->start_pos);
 
-  /* remove all matching project objects from
-   * sel_after */
-  for (int i = (int) after_objs_arr->len - 1; i >= 0; i--)
-    {
-      ArrangerObject * obj = (ArrangerObject *)
-        g_ptr_array_index (after_objs_arr, i);
-
-      /* get project object and remove it from
-       * the project */
-      ArrangerObject * prj_obj = arranger_object_find (obj);
-      arranger_object_remove_from_project (prj_obj);
-
-      g_message ("removing");
-      arranger_object_print (obj);
-    }
-  /* add all objects from sel_before */
-  for (size_t i = 0; i < before_objs_arr->len; i++)
-    {
-      ArrangerObject * obj = (ArrangerObject *)
-        g_ptr_array_index (before_objs_arr, i);
-
-      /* clone object and add to project */
-      ArrangerObject * prj_obj = arranger_object_clone (obj);
-      arranger_object_insert_to_project (prj_obj);
-
-      g_message ("adding");
-      arranger_object_print (obj);
-      g_message ("after adding");
-      arranger_object_print (prj_obj);
-    }
-
-  /* move transport markers */
+  /* remove the objects in sel_after, shift the
+   * unaffected objects back and re-add the objects
+   * in sel_before */
   switch (self->type)
     {
     case RANGE_ACTION_INSERT_SILENCE:
+      swap_objects_and_shift (
+        self, after_objs_arr, before_objs_arr,
+        &self->start_pos, -range_size_ticks);
+
+      /* move transport markers */
       UNMOVE_TRANSPORT_MARKERS (false);
       break;
     case RANGE_ACTION_REMOVE:
+      swap_objects_and_shift (
+        self, after_objs_arr, before_objs_arr,
+        &self->start_pos, range_size_ticks);
+
+      /* move transport markers */
       MOVE_TRANSPORT_MARKERS (false);
       break;
     default:
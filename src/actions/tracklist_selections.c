@@ -6,6 +6,7 @@
 #include "audio/foldable_track.h"
 #include "audio/group_target_track.h"
 #include "audio/midi_file.h"
+#include "audio/midi_region.h"
 #include "audio/router.h"
 #include "audio/supported_file.h"
 #include "audio/track.h"
@@ -673,10 +674,57 @@ tracklist_selections_action_perform_set_direct_out (
     }
 }
 
+/**
+ * Reads the MIDI file stored in the action.
+ */
+static MidiFile *
+load_midi_file (
+  TracklistSelectionsAction * self,
+  GError **                   error)
+{
+  /* create a temporary midi file */
+  GError * err = NULL;
+  char *   dir =
+    g_dir_make_tmp ("zrythm_tmp_midi_XXXXXX", &err);
+  if (!dir)
+    {
+      PROPAGATE_PREFIXED_ERROR (
+        error, err, "%s", _ ("Failed creating tmpdir"));
+      return NULL;
+    }
+  char * full_path =
+    g_build_filename (dir, "data.MID", NULL);
+  size_t     len;
+  uint8_t *  data = g_base64_decode (self->base64_midi, &len);
+  MidiFile * mf = NULL;
+  if (g_file_set_contents (
+        full_path, (const gchar *) data, (gssize) len, &err))
+    {
+      mf = midi_file_new (full_path, &err);
+    }
+  if (!mf)
+    {
+      PROPAGATE_PREFIXED_ERROR (
+        error, err, _ ("Failed reading MIDI file %s"),
+        self->file_basename);
+    }
+
+  /* remove temporary data */
+  io_remove (full_path);
+  io_rmdir (dir, Z_F_NO_FORCE);
+  g_free (dir);
+  g_free (full_path);
+  g_free (data);
+
+  return mf;
+}
+
 /**
  * @param add_to_project Used when the track to
  *   create is meant to be used in the project (ie
  *   not one of the tracks in the action).
+ * @param mf MIDI file to create the regions from, if
+ *   creating MIDI tracks from a file.
  *
  * @return Non-zero if error.
  */
@@ -684,6 +732,7 @@ static int
 create_track (
   TracklistSelectionsAction * self,
   int                         idx,
+  const MidiFile *            mf,
   GError **                   error)
 {
   Track * track;
@@ -797,41 +846,18 @@ create_track (
             track, ar, NULL, 0, F_GEN_NAME,
             F_NO_PUBLISH_EVENTS);
         }
-      else if (
-        self->track_type == TRACK_TYPE_MIDI
-        && self->base64_midi && self->file_basename)
+      else if (self->track_type == TRACK_TYPE_MIDI && mf)
         {
-          /* create a temporary midi file */
-          GError * err = NULL;
-          char *   dir =
-            g_dir_make_tmp ("zrythm_tmp_midi_XXXXXX", &err);
-          if (!dir)
-            {
-              g_critical (
-                "failed creating tmpdir: %s", err->message);
-              return -1;
-            }
-          char * full_path =
-            g_build_filename (dir, "data.MID", NULL);
-          size_t    len;
-          uint8_t * data =
-            g_base64_decode (self->base64_midi, &len);
-          err = NULL;
-          if (!g_file_set_contents (
-                full_path, (const gchar *) data, (gssize) len,
-                &err))
-            {
-              PROPAGATE_PREFIXED_ERROR (
-                error, err, _ ("Failed saving file %s"),
-                full_path);
-              return -1;
-            }
-
           /* create a MIDI region from the MIDI
            * file & add to track */
-          ZRegion * mr = midi_region_new_from_midi_file (
-            &start_pos, full_path,
-            track_get_name_hash (track), 0, 0, idx);
+          const MidiFileTrack * mf_track =
+            midi_file_get_nonempty_track (mf, idx);
+          ZRegion * mr =
+            mf_track
+              ? midi_region_new_from_midi_file_track (
+                &start_pos, mf, mf_track,
+                track_get_name_hash (track), 0, 0)
+              : NULL;
           if (mr)
             {
               track_add_region (
@@ -847,16 +873,9 @@ create_track (
             {
               g_message (
                 "Failed to create MIDI region from "
-                "file %s",
-                full_path);
+                "track %d of %s",
+                idx, self->file_basename);
             }
-
-          /* remove temporary data */
-          io_remove (full_path);
-          io_rmdir (dir, Z_F_NO_FORCE);
-          g_free (dir);
-          g_free (full_path);
-          g_free (data);
         }
 
       if (pl)
@@ -903,10 +922,22 @@ do_or_undo_create_or_delete (
     {
       if (create)
         {
+          /* read the MIDI file once for all the
+           * tracks */
+          MidiFile * mf = NULL;
+          if (
+            self->track_type == TRACK_TYPE_MIDI
+            && self->base64_midi && self->file_basename)
+            {
+              mf = load_midi_file (self, error);
+              if (!mf)
+                return -1;
+            }
+
           for (int i = 0; i < self->num_tracks; i++)
             {
               GError * err = NULL;
-              int      ret = create_track (self, i, &err);
+              int      ret = create_track (self, i, mf, &err);
               if (ret != 0)
                 {
                   PROPAGATE_PREFIXED_ERROR (
@@ -914,12 +945,15 @@ do_or_undo_create_or_delete (
                     _ ("Failed to create track "
                        "at %d"),
                     i);
+                  object_free_w_func_and_null (
+                    midi_file_free, mf);
                   return ret;
                 }
 
               /* TODO select each plugin that was
                * selected */
             }
+          object_free_w_func_and_null (midi_file_free, mf);
 
           /* disable given track, if any (eg when
            * bouncing) */
@@ -0,0 +1,291 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-config.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "audio/audio_file_stream.h"
+#include "utils/objects.h"
+
+#include <glib.h>
+#include <glib/gi18n.h>
+
+typedef enum
+{
+  Z_AUDIO_AUDIO_FILE_STREAM_ERROR_FAILED,
+} ZAudioAudioFileStreamError;
+
+#define Z_AUDIO_AUDIO_FILE_STREAM_ERROR \
+  z_audio_audio_file_stream_error_quark ()
+GQuark
+z_audio_audio_file_stream_error_quark (void);
+G_DEFINE_QUARK (
+  z - audio - audio - file - stream - error - quark,
+  z_audio_audio_file_stream_error)
+
+/** Size of a stereo frame in the ring. */
+#define FRAME_SIZE (2 * sizeof (float))
+
+/**
+ * Decodes the next chunk and writes it to the
+ * ring.
+ *
+ * Input frames that the resampler did not consume
+ * are kept at the start of the stereo buffer and
+ * resampled in the next call.
+ *
+ * The ring must have space for a full chunk.
+ *
+ * @return Whether there is more to decode.
+ */
+static bool
+decode_chunk (AudioFileStream * self)
+{
+  const size_t     pending = self->num_pending_frames;
+  const sf_count_t to_read =
+    (sf_count_t) (AUDIO_FILE_STREAM_CHUNK_FRAMES - pending);
+  sf_count_t num_read = 0;
+  if (to_read > 0)
+    {
+      num_read = sf_readf_float (
+        self->sndfile, self->file_buf, to_read);
+    }
+  const bool end_of_input = num_read < to_read;
+
+  /* convert to stereo after the pending frames */
+  const int ch = self->sfinfo.channels;
+  float *   stereo = &self->stereo_buf[pending * 2];
+  for (sf_count_t i = 0; i < num_read; i++)
+    {
+      float * in = &self->file_buf[i * ch];
+      stereo[i * 2] = in[0];
+      stereo[i * 2 + 1] = ch > 1 ? in[1] : in[0];
+    }
+  const long num_in = (long) pending + (long) num_read;
+
+  if (!self->src_state)
+    {
+      zix_ring_write (
+        self->ring, (const char *) self->stereo_buf,
+        (uint32_t) ((size_t) num_in * FRAME_SIZE));
+      return !end_of_input;
+    }
+
+  SRC_DATA data = {
+    .data_in = self->stereo_buf,
+    .input_frames = num_in,
+    .data_out = self->out_buf,
+    .output_frames = (long) self->out_buf_frames,
+    .end_of_input = end_of_input,
+    .src_ratio = self->src_ratio,
+  };
+  int err = src_process (self->src_state, &data);
+  if (err)
+    {
+      g_warning (
+        "resampling failed: %s", src_strerror (err));
+      return false;
+    }
+
+  /* keep the unconsumed input for the next call */
+  self->num_pending_frames =
+    (size_t) (num_in - data.input_frames_used);
+  if (self->num_pending_frames > 0)
+    {
+      memmove (
+        self->stereo_buf,
+        &self->stereo_buf[data.input_frames_used * 2],
+        self->num_pending_frames * FRAME_SIZE);
+    }
+
+  zix_ring_write (
+    self->ring, (const char *) self->out_buf,
+    (uint32_t) ((size_t) data.output_frames_gen
+                * FRAME_SIZE));
+
+  /* at the end of the input, keep going until the
+   * resampler is flushed */
+  return !end_of_input || self->num_pending_frames > 0
+         || data.output_frames_gen > 0;
+}
+
+/**
+ * Returns the number of bytes a decoded chunk
+ * can take in the ring.
+ */
+static uint32_t
+get_max_chunk_size (AudioFileStream * self)
+{
+  return (uint32_t) (self->out_buf_frames * FRAME_SIZE);
+}
+
+static void *
+decoder_thread_func (void * data)
+{
+  AudioFileStream * self = (AudioFileStream *) data;
+  bool              more = true;
+  while (more && !g_atomic_int_get (&self->stop))
+    {
+      if (
+        zix_ring_write_space (self->ring)
+        < get_max_chunk_size (self))
+        {
+          /* wait for the engine to read */
+          zix_sem_wait (&self->sem);
+          continue;
+        }
+
+      more = decode_chunk (self);
+    }
+
+  g_atomic_int_set (&self->decoded, 1);
+  return NULL;
+}
+
+AudioFileStream *
+audio_file_stream_new (
+  const char * abs_path,
+  samplerate_t samplerate,
+  GError **    error)
+{
+  AudioFileStream * self = object_new (AudioFileStream);
+  self->abs_path = g_strdup (abs_path);
+
+  self->sndfile =
+    sf_open (abs_path, SFM_READ, &self->sfinfo);
+  if (!self->sndfile || self->sfinfo.channels < 1)
+    {
+      g_set_error (
+        error, Z_AUDIO_AUDIO_FILE_STREAM_ERROR,
+        Z_AUDIO_AUDIO_FILE_STREAM_ERROR_FAILED,
+        _ ("Failed to open %s: %s"), abs_path,
+        sf_strerror (self->sndfile));
+      audio_file_stream_free (self);
+      return NULL;
+    }
+
+  self->src_ratio =
+    (double) samplerate / (double) self->sfinfo.samplerate;
+  self->num_out_frames = (unsigned_frame_t) ceil (
+    (double) self->sfinfo.frames * self->src_ratio);
+  self->out_buf_frames = (size_t) ceil (
+    AUDIO_FILE_STREAM_CHUNK_FRAMES * self->src_ratio);
+  if (self->sfinfo.samplerate != (int) samplerate)
+    {
+      int err = 0;
+      self->src_state = src_new (SRC_SINC_FASTEST, 2, &err);
+      if (!self->src_state)
+        {
+          g_set_error (
+            error, Z_AUDIO_AUDIO_FILE_STREAM_ERROR,
+            Z_AUDIO_AUDIO_FILE_STREAM_ERROR_FAILED,
+            _ ("Failed to create resampler: %s"),
+            src_strerror (err));
+          audio_file_stream_free (self);
+          return NULL;
+        }
+    }
+
+  self->file_buf = object_new_n (
+    (size_t) (AUDIO_FILE_STREAM_CHUNK_FRAMES
+              * self->sfinfo.channels),
+    float);
+  self->stereo_buf =
+    object_new_n (AUDIO_FILE_STREAM_CHUNK_FRAMES * 2, float);
+  self->out_buf =
+    object_new_n (self->out_buf_frames * 2, float);
+
+  /* about a second of audio, and at least a few
+   * chunks */
+  size_t ring_size = MAX (
+    (size_t) samplerate * FRAME_SIZE,
+    get_max_chunk_size (self) * 4);
+  self->ring = zix_ring_new (
+    zix_default_allocator (), (uint32_t) ring_size);
+  zix_ring_mlock (self->ring);
+  zix_sem_init (&self->sem, 0);
+
+  /* decode the first chunk now so that playback can
+   * start right away */
+  if (!decode_chunk (self))
+    {
+      g_atomic_int_set (&self->decoded, 1);
+    }
+  else
+    {
+      zix_thread_create (
+        &self->thread, 64000, decoder_thread_func, self);
+      self->thread_started = true;
+    }
+
+  return self;
+}
+
+nframes_t
+audio_file_stream_mix (
+  AudioFileStream * self,
+  float *           l,
+  float *           r,
+  const nframes_t   nframes,
+  const float       gain)
+{
+  float     buf[256 * 2];
+  nframes_t frames_left = MIN (
+    nframes, (nframes_t) (zix_ring_read_space (self->ring)
+                          / FRAME_SIZE));
+  nframes_t offset = 0;
+  while (frames_left > 0)
+    {
+      nframes_t frames = MIN (frames_left, 256);
+      zix_ring_read (
+        self->ring, (char *) buf,
+        (uint32_t) (frames * FRAME_SIZE));
+      for (nframes_t i = 0; i < frames; i++)
+        {
+          l[offset + i] += buf[i * 2] * gain;
+          r[offset + i] += buf[i * 2 + 1] * gain;
+        }
+      offset += frames;
+      frames_left -= frames;
+    }
+
+  if (offset > 0 && !g_atomic_int_get (&self->decoded))
+    zix_sem_post (&self->sem);
+
+  return offset;
+}
+
+bool
+audio_file_stream_is_finished (AudioFileStream * self)
+{
+  return g_atomic_int_get (&self->decoded)
+         && zix_ring_read_space (self->ring) < FRAME_SIZE;
+}
+
+void
+audio_file_stream_free (AudioFileStream * self)
+{
+  if (self->ring)
+    {
+      g_atomic_int_set (&self->stop, 1);
+      zix_sem_post (&self->sem);
+      if (self->thread_started)
+        zix_thread_join (self->thread, NULL);
+      zix_ring_free (self->ring);
+      zix_sem_destroy (&self->sem);
+    }
+
+  if (self->sndfile)
+    sf_close (self->sndfile);
+  object_free_w_func_and_null (src_delete, self->src_state);
+
+  free (self->file_buf);
+  free (self->stereo_buf);
+  free (self->out_buf);
+  g_free_and_null (self->abs_path);
+
+  object_zero_and_free (self);
+}
@@ -23,6 +23,7 @@
 #include "utils/dsp.h"
 #include "utils/flags.h"
 #include "utils/io.h"
+#include "utils/log.h"
 #include "utils/math.h"
 #include "utils/objects.h"
 #include "zrythm_app.h"
@@ -226,6 +227,7 @@ audio_region_replace_frames (
   audio_clip_update_channel_caches (clip, start_frame);
 
   audio_clip_write_to_pool (clip, false, F_NOT_BACKUP);
+  audio_clip_build_peaks (clip);
 
   self->last_clip_change = g_get_monotonic_time ();
 }
@@ -324,7 +326,7 @@ audio_region_fill_stereo_ports (
       needs_rt_timestretch = true;
       timestretch_ratio =
         (double) cur_bpm / (double) clip->bpm;
-      g_message (
+      log_rt_message (
         "timestretching: "
         "(cur bpm %f clip bpm %f) %f",
         (double) cur_bpm, (double) clip->bpm,
@@ -412,9 +414,9 @@ audio_region_fill_stereo_ports (
             (ssize_t) (buff_index * timestretch_ratio);
           if (buff_index < (ssize_t) buff_index_start)
             {
-              g_message (
+              log_rt_message (
                 "buff index (%zd) < "
-                "buff index start (%zd)",
+                "buff index start (%zu)",
                 buff_index, buff_index_start);
               /* set the start point (
                * used when
@@ -425,7 +427,8 @@ audio_region_fill_stereo_ports (
                * up to this point */
               if (buff_size > 0)
                 {
-                  g_message ("buff size (%zd) > 0", buff_size);
+                  log_rt_message (
+                    "buff size (%zu) > 0", buff_size);
                   STRETCH;
                   prev_offset = current_local_frame;
                 }
@@ -20,11 +20,117 @@
 #include "utils/math.h"
 #include "utils/objects.h"
 #include "utils/string.h"
+#include "zrythm.h"
 #include "zrythm_app.h"
 
 #include <glib/gi18n.h>
 #include <gtk/gtk.h>
 
+#include <xxhash.h>
+
+/** Protects the peak caches of all clips. */
+static GMutex peaks_lock;
+static GCond  peaks_cond;
+
+/** Thread pool building the peak caches. */
+static GThreadPool * peaks_pool = NULL;
+
+typedef struct BuildPeaksJob
+{
+  AudioClip * clip;
+
+  /** Path to save the peaks to, or NULL. */
+  char * peaks_path;
+} BuildPeaksJob;
+
+/**
+ * Returns the path of the peak file for the clip's
+ * frames, or NULL if the clip has no frames.
+ *
+ * Peak files are shared between projects and keyed
+ * by a hash of the frames, so they are only
+ * regenerated when the audio changes, and frames
+ * that were edited but not written to the pool yet
+ * never get the peaks of the file.
+ */
+static char *
+get_peaks_path (AudioClip * self)
+{
+  if (!self->frames || self->num_frames == 0)
+    return NULL;
+
+  XXH64_hash_t hash = XXH3_64bits (
+    self->frames,
+    (size_t) self->num_frames * self->channels
+      * sizeof (float));
+  char * peaks_dir = zrythm_get_dir (ZRYTHM_DIR_USER_PEAKS);
+  char * filename = g_strdup_printf (
+    "%016" G_GINT64_MODIFIER "x-%u.peaks", (guint64) hash,
+    self->channels);
+  char * peaks_path =
+    g_build_filename (peaks_dir, filename, NULL);
+  g_free (peaks_dir);
+  g_free (filename);
+
+  return peaks_path;
+}
+
+static void
+save_peaks (PeakCache * peaks, const char * peaks_path)
+{
+  char * peaks_dir = g_path_get_dirname (peaks_path);
+  io_mkdir (peaks_dir);
+  g_free (peaks_dir);
+
+  GError * err = NULL;
+  if (!peak_cache_write_to_file (peaks, peaks_path, &err))
+    {
+      g_warning (
+        "failed to save peaks: %s", err->message);
+      g_error_free (err);
+    }
+}
+
+static void
+build_peaks_job_func (gpointer data, gpointer user_data)
+{
+  BuildPeaksJob * job = (BuildPeaksJob *) data;
+  AudioClip *     self = job->clip;
+
+  g_mutex_lock (&peaks_lock);
+  int generation = self->peaks_generation;
+  g_mutex_unlock (&peaks_lock);
+
+  PeakCache * peaks = NULL;
+  if (self->frames && self->num_frames > 0)
+    {
+      peaks = peak_cache_new (
+        self->frames, self->num_frames, self->channels);
+      if (
+        job->peaks_path
+        && generation
+             == g_atomic_int_get (&self->peaks_generation))
+        {
+          save_peaks (peaks, job->peaks_path);
+        }
+    }
+  g_free_and_null (job->peaks_path);
+  object_zero_and_free (job);
+
+  g_mutex_lock (&peaks_lock);
+  /* discard if the frames changed meanwhile */
+  if (generation == self->peaks_generation)
+    {
+      PeakCache * prev_peaks = self->peaks;
+      self->peaks = peaks;
+      peaks = prev_peaks;
+    }
+  object_free_w_func_and_null (peak_cache_free, peaks);
+  self->num_peak_jobs--;
+  g_cond_broadcast (&peaks_cond);
+  g_mutex_unlock (&peaks_lock);
+}
+
 static AudioClip *
 _create (void)
 {
@@ -65,6 +171,83 @@ audio_clip_update_channel_caches (
     }
 }
 
+void
+audio_clip_build_peaks (AudioClip * self)
+{
+  if (!ZRYTHM_HAVE_UI)
+    return;
+
+  /* map previously saved peaks if any, which is
+   * quick enough to do right away */
+  char *      peaks_path = get_peaks_path (self);
+  PeakCache * saved_peaks = NULL;
+  if (peaks_path && file_exists (peaks_path))
+    {
+      GError * err = NULL;
+      saved_peaks = peak_cache_new_from_file (
+        peaks_path, self->num_frames, &err);
+      if (!saved_peaks)
+        {
+          g_message (
+            "regenerating peaks: %s", err->message);
+          g_error_free (err);
+        }
+    }
+
+  g_mutex_lock (&peaks_lock);
+  if (!peaks_pool)
+    {
+      peaks_pool = g_thread_pool_new (
+        build_peaks_job_func, NULL,
+        (int) MAX (g_get_num_processors () / 2, 1), false,
+        NULL);
+    }
+  self->peaks_generation++;
+  object_free_w_func_and_null (peak_cache_free, self->peaks);
+  g_free (self->peaks_path);
+  self->peaks_path = g_strdup (peaks_path);
+  if (saved_peaks)
+    {
+      self->peaks = saved_peaks;
+      g_mutex_unlock (&peaks_lock);
+      g_free (peaks_path);
+      return;
+    }
+  self->num_peak_jobs++;
+  g_mutex_unlock (&peaks_lock);
+
+  BuildPeaksJob * job = object_new (BuildPeaksJob);
+  job->clip = self;
+  job->peaks_path = peaks_path;
+  g_thread_pool_push (peaks_pool, job, NULL);
+}
+
+void
+audio_clip_free_peaks (AudioClip * self)
+{
+  g_mutex_lock (&peaks_lock);
+  self->peaks_generation++;
+  while (self->num_peak_jobs > 0)
+    {
+      g_cond_wait (&peaks_cond, &peaks_lock);
+    }
+  object_free_w_func_and_null (peak_cache_free, self->peaks);
+  g_mutex_unlock (&peaks_lock);
+}
+
+PeakCache *
+audio_clip_acquire_peaks (AudioClip * self)
+{
+  g_mutex_lock (&peaks_lock);
+  return self->peaks;
+}
+
+void
+audio_clip_release_peaks (AudioClip * self)
+{
+  g_mutex_unlock (&peaks_lock);
+}
+
 static void
 audio_clip_init_from_file (
   AudioClip *  self,
@@ -75,6 +258,9 @@ audio_clip_init_from_file (
   self->samplerate = (int) AUDIO_ENGINE->sample_rate;
   g_return_if_fail (self->samplerate > 0);
 
+  /* the frames are about to be replaced */
+  audio_clip_free_peaks (self);
+
   AudioEncoder * enc = audio_encoder_new_from_file (full_path);
   audio_encoder_decode (
     enc, self->samplerate, F_SHOW_PROGRESS);
@@ -113,6 +299,7 @@ audio_clip_init_from_file (
   /*g_message (*/
   /*"\n\n num frames %ld \n\n", self->num_frames);*/
   audio_clip_update_channel_caches (self, 0);
+  audio_clip_build_peaks (self);
 
   audio_encoder_free (enc);
 }
@@ -183,6 +370,7 @@ audio_clip_new_from_float_array (
     self->frames, arr, (size_t) nframes * (size_t) channels);
   self->bpm = tempo_track_get_current_bpm (P_TEMPO_TRACK);
   audio_clip_update_channel_caches (self, 0);
+  audio_clip_build_peaks (self);
 
   return self;
 }
@@ -655,6 +843,14 @@ audio_clip_remove_and_free (AudioClip * self, bool backup)
   g_message ("removing clip at %s", path);
   g_return_if_fail (path);
   io_remove (path);
+  g_free (path);
+
+  /* remove the peak file too (unmapped first) */
+  audio_clip_free_peaks (self);
+  if (self->peaks_path && file_exists (self->peaks_path))
+    {
+      io_remove (self->peaks_path);
+    }
 
   audio_clip_free (self);
 }
@@ -682,6 +878,7 @@ audio_clip_clone (AudioClip * src)
 void
 audio_clip_free (AudioClip * self)
 {
+  audio_clip_free_peaks (self);
   object_zero_and_free (self->frames);
   for (unsigned int i = 0; i < self->channels; i++)
     {
@@ -689,6 +886,7 @@ audio_clip_free (AudioClip * self)
     }
   g_free_and_null (self->name);
   g_free_and_null (self->file_hash);
+  g_free_and_null (self->peaks_path);
 
   object_zero_and_free (self);
 }
@@ -75,9 +75,11 @@
 #include "utils/arrays.h"
 #include "utils/dsp.h"
 #include "utils/flags.h"
+#include "utils/log.h"
 #include "utils/mpmc_queue.h"
 #include "utils/object_pool.h"
 #include "utils/objects.h"
+#include "utils/rt_checker.h"
 #include "utils/string.h"
 #include "utils/ui.h"
 #include "zrythm.h"
@@ -1349,7 +1351,7 @@ engine_process_prepare (AudioEngine * self, nframes_t nframes)
   if (self->transport->play_state == PLAYSTATE_PAUSE_REQUESTED)
     {
       if (ZRYTHM_TESTING)
-        g_message ("pause requested handled");
+        log_rt_message ("pause requested handled");
       self->transport->play_state = PLAYSTATE_PAUSED;
       /*zix_sem_post (&TRANSPORT->paused);*/
 #ifdef HAVE_JACK
@@ -1409,7 +1411,7 @@ engine_process_prepare (AudioEngine * self, nframes_t nframes)
   if (!lock_acquired && !self->exporting)
     {
       if (ZRYTHM_TESTING)
-        g_message (
+        log_rt_message (
           "port operation lock is busy, skipping "
           "cycle...");
       return true;
@@ -1476,6 +1478,8 @@ engine_process (
   AudioEngine *   self,
   const nframes_t total_frames_to_process)
 {
+  log_rt_mark_thread ();
+
   if (ZRYTHM_TESTING)
     {
       /*g_debug (*/
@@ -1485,6 +1489,8 @@ engine_process (
 
   g_return_val_if_fail (total_frames_to_process > 0, -1);
 
+  rt_checker_enter ();
+
   /*g_message ("processing...");*/
   g_atomic_int_set (&self->cycle_running, 1);
 
@@ -1501,6 +1507,7 @@ engine_process (
       /*g_message ("skipping processing...");*/
       clear_output_buffers (self, total_frames_to_process);
       g_atomic_int_set (&self->cycle_running, 0);
+      rt_checker_leave ();
       return 0;
     }
 
@@ -1515,6 +1522,7 @@ engine_process (
     {
       clear_output_buffers (self, total_frames_to_process);
       g_atomic_int_set (&self->cycle_running, 0);
+      rt_checker_leave ();
       return 0;
     }
 
@@ -1545,7 +1553,7 @@ engine_process (
         {
           if (num_preroll_frames > 0)
             {
-              g_message (
+              log_rt_message (
                 "prerolling for %u frames",
                 num_preroll_frames);
             }
@@ -1710,6 +1718,8 @@ finalize_processing:
   self->last_timestamp_start = self->timestamp_start;
   self->last_timestamp_end = g_get_monotonic_time ();
 
+  rt_checker_leave ();
+
   /*
    * processing finished, return 0 (OK)
    */
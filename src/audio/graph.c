@@ -570,6 +570,70 @@ graph_update_latencies (Graph * self, bool use_setup_nodes)
     0);
 }
 
+void
+graph_update_latencies_for_plugins (
+  Graph *     self,
+  GPtrArray * plugins)
+{
+  /* nodes whose route latency must be
+   * recalculated */
+  GQueue       queue = G_QUEUE_INIT;
+  GHashTable * queued =
+    g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  for (size_t i = 0; i < plugins->len; i++)
+    {
+      Plugin *    pl = g_ptr_array_index (plugins, i);
+      GraphNode * node = (GraphNode *) g_hash_table_lookup (
+        self->graph_nodes, pl);
+      if (!node || node->type != ROUTE_NODE_TYPE_PLUGIN)
+        continue;
+
+      node->playback_latency =
+        graph_node_get_single_playback_latency (node);
+      if (g_hash_table_add (queued, node))
+        g_queue_push_tail (&queue, node);
+    }
+
+  /* the route latency of a node is the largest
+   * latency of the node and its downstream nodes,
+   * so only parents of nodes whose route latency
+   * changed need to be recalculated */
+  int         num_visited = 0;
+  GraphNode * node;
+  while ((node = g_queue_pop_head (&queue)))
+    {
+      g_hash_table_remove (queued, node);
+      num_visited++;
+
+      nframes_t route_latency = node->playback_latency;
+      for (int i = 0; i < node->n_childnodes; i++)
+        {
+          route_latency = MAX (
+            route_latency,
+            node->childnodes[i]->route_playback_latency);
+        }
+      if (route_latency == node->route_playback_latency)
+        continue;
+
+      node->route_playback_latency = route_latency;
+      for (int i = 0; i < node->init_refcount; i++)
+        {
+          GraphNode * parent = node->parentnodes[i];
+          if (g_hash_table_add (queued, parent))
+            g_queue_push_tail (&queue, parent);
+        }
+    }
+
+  g_hash_table_unref (queued);
+
+  g_message (
+    "updated latencies of %u plugin(s) (%d nodes "
+    "visited) - total playback latency: %u",
+    plugins->len, num_visited,
+    graph_get_max_route_playback_latency (self, false));
+}
+
 /*
  * Adds the graph nodes and connections, then
  * rechains.
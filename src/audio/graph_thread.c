@@ -69,8 +69,10 @@
 #include "audio/router.h"
 #include "gui/widgets/main_window.h"
 #include "project.h"
+#include "utils/log.h"
 #include "utils/mpmc_queue.h"
 #include "utils/objects.h"
+#include "utils/rt_checker.h"
 #include "utils/ui.h"
 #include "zrythm_app.h"
 
@@ -99,6 +101,8 @@ worker_thread (void * arg)
     "WORKER THREAD %d created (num threads %d)", thread->id,
     graph->num_threads);
 
+  log_rt_mark_thread ();
+
   /* wait for all threads to get created */
   if (thread->id < graph->num_threads - 1)
     {
@@ -214,7 +218,9 @@ worker_thread (void * arg)
 #ifdef DEBUG_THREADS
       g_message ("[%d]: running node", thread->id);
 #endif
+      rt_checker_enter ();
       graph_node_process (to_run, graph->router->time_nfo);
+      rt_checker_leave ();
     }
 
 terminate_thread:
@@ -30,80 +30,44 @@ meter_get_value (
   float *          max)
 {
   Port * port = self->port;
-  g_return_if_fail (IS_PORT_AND_NONNULL (port));
+
+  /* port was freed */
+  if (!port)
+    {
+      *val = 1e-20f;
+      *max = 1e-20f;
+      return;
+    }
+  g_return_if_fail (IS_PORT (port));
 
   /* get amplitude */
   float amp = -1.f;
   float max_amp = -1.f;
   if (port->id.type == TYPE_AUDIO || port->id.type == TYPE_CV)
     {
-      g_return_if_fail (port->audio_ring);
-      int    num_cycles = 4;
-      size_t read_space_avail =
-        zix_ring_read_space (port->audio_ring);
-      size_t size =
-        sizeof (float) * (size_t) AUDIO_ENGINE->block_length;
-      size_t blocks_to_read =
-        size == 0 ? 0 : read_space_avail / size;
-      /* if no blocks available, skip */
-      if (blocks_to_read == 0)
+      /* read the last snapshot published by the
+       * audio thread */
+      MeterSnapshot snapshot;
+      gint          seq;
+      do
         {
-          *val = 1e-20f;
-          *max = 1e-20f;
-          return;
+          seq = g_atomic_int_get (&self->snapshot_seq);
+          snapshot = self->snapshot;
         }
+      while (
+        seq % 2 == 1
+        || seq != g_atomic_int_get (&self->snapshot_seq));
 
-      float  buf[read_space_avail];
-      size_t blocks_read = zix_ring_peek (
-        port->audio_ring, &buf[0], read_space_avail);
-      blocks_read /= size;
-      num_cycles = MIN (num_cycles, (int) blocks_read);
-      size_t start_index =
-        (blocks_read - (size_t) num_cycles)
-        * AUDIO_ENGINE->block_length;
-      g_return_if_fail (IS_PORT_AND_NONNULL (port));
-      if (blocks_read == 0)
+      /* if nothing processed yet, skip */
+      if (seq == 0)
         {
-          g_message (
-            "%s: blocks read for port %s is 0", __func__,
-            port->id.label);
           *val = 1e-20f;
           *max = 1e-20f;
           return;
         }
 
-      switch (self->algorithm)
-        {
-        case METER_ALGORITHM_RMS:
-          /* not used */
-          g_warn_if_reached ();
-          amp = math_calculate_rms_amp (
-            &buf[start_index],
-            (size_t) num_cycles * AUDIO_ENGINE->block_length);
-          break;
-        case METER_ALGORITHM_TRUE_PEAK:
-          true_peak_dsp_process (
-            self->true_peak_processor, &port->buf[0],
-            (int) AUDIO_ENGINE->block_length);
-          amp =
-            true_peak_dsp_read_f (self->true_peak_processor);
-          break;
-        case METER_ALGORITHM_K:
-          kmeter_dsp_process (
-            self->kmeter_processor, &port->buf[0],
-            (int) AUDIO_ENGINE->block_length);
-          kmeter_dsp_read (
-            self->kmeter_processor, &amp, &max_amp);
-          break;
-        case METER_ALGORITHM_DIGITAL_PEAK:
-          peak_dsp_process (
-            self->peak_processor, &port->buf[0],
-            (int) AUDIO_ENGINE->block_length);
-          peak_dsp_read (self->peak_processor, &amp, &max_amp);
-          break;
-        default:
-          break;
-        }
+      amp = snapshot.amp;
+      max_amp = snapshot.max_amp;
     }
   else if (port->id.type == TYPE_EVENT)
     {
@@ -176,6 +140,8 @@ meter_get_value (
   switch (format)
     {
     case AUDIO_VALUE_AMPLITUDE:
+      *val = amp;
+      *max = max_amp;
       break;
     case AUDIO_VALUE_DBFS:
       *val = math_amp_to_dbfs (amp);
@@ -190,6 +156,161 @@ meter_get_value (
     }
 }
 
+/**
+ * Runs the meter DSP on the given frames and
+ * publishes the result.
+ *
+ * To be called by the audio thread only.
+ */
+void
+meter_process (
+  Meter *         self,
+  float *         buf,
+  const nframes_t nframes)
+{
+  float amp = -1.f;
+  float max_amp = -1.f;
+  switch (self->algorithm)
+    {
+    case METER_ALGORITHM_RMS:
+      amp = math_calculate_rms_amp (buf, nframes);
+      break;
+    case METER_ALGORITHM_TRUE_PEAK:
+      true_peak_dsp_process (
+        self->true_peak_processor, buf, (int) nframes);
+      amp = true_peak_dsp_read_f (self->true_peak_processor);
+      break;
+    case METER_ALGORITHM_K:
+      kmeter_dsp_process (
+        self->kmeter_processor, buf, (int) nframes);
+      kmeter_dsp_read (
+        self->kmeter_processor, &amp, &max_amp);
+      break;
+    case METER_ALGORITHM_DIGITAL_PEAK:
+      peak_dsp_process (
+        self->peak_processor, buf, (int) nframes);
+      peak_dsp_read (self->peak_processor, &amp, &max_amp);
+      break;
+    default:
+      break;
+    }
+
+  /* an odd sequence number tells readers that the
+   * snapshot is being written */
+  g_atomic_int_inc (&self->snapshot_seq);
+  self->snapshot.amp = amp;
+  self->snapshot.max_amp = max_amp;
+  g_atomic_int_inc (&self->snapshot_seq);
+}
+
+/**
+ * Subscribes the meter to its port so that it gets
+ * processed by the audio thread.
+ */
+static void
+subscribe (Meter * self)
+{
+  Port * port = self->port;
+  for (int i = 0; i < PORT_MAX_METERS; i++)
+    {
+      if (g_atomic_pointer_compare_and_exchange (
+            &port->meters[i], NULL, self))
+        return;
+    }
+
+  g_warning (
+    "too many meters for port %s", port->id.label);
+}
+
+/**
+ * Unsubscribes the meter from its port.
+ *
+ * The audio thread may still process the meter
+ * until the current cycle ends.
+ */
+static void
+unsubscribe (Meter * self)
+{
+  Port * port = self->port;
+  for (int i = 0; i < PORT_MAX_METERS; i++)
+    {
+      if (g_atomic_pointer_compare_and_exchange (
+            &port->meters[i], self, NULL))
+        break;
+    }
+
+  if (AUDIO_ENGINE)
+    {
+      self->unsubscribed_cycle = AUDIO_ENGINE->cycle;
+    }
+}
+
+/**
+ * Waits until the cycle that was running when the
+ * meter was unsubscribed ends.
+ */
+static void
+wait_until_unused (Meter * self)
+{
+  if (!AUDIO_ENGINE)
+    return;
+
+  while (
+    g_atomic_int_get (&AUDIO_ENGINE->cycle_running)
+    && AUDIO_ENGINE->cycle == self->unsubscribed_cycle)
+    {
+      g_usleep (12);
+    }
+}
+
+/**
+ * Sets whether the meter should be processed.
+ *
+ * Inactive meters keep their last values and cost
+ * nothing on the audio thread.
+ */
+void
+meter_set_active (Meter * self, bool active)
+{
+  if (
+    !self->port
+    || !(
+      self->port->id.type == TYPE_AUDIO
+      || self->port->id.type == TYPE_CV)
+    || self->active == active)
+    return;
+
+  if (active)
+    {
+      subscribe (self);
+    }
+  else
+    {
+      unsubscribe (self);
+    }
+  self->active = active;
+}
+
+/**
+ * Unsubscribes all meters from the port.
+ *
+ * To be called when freeing the port.
+ */
+void
+meter_detach_all_from_port (Port * port)
+{
+  for (int i = 0; i < PORT_MAX_METERS; i++)
+    {
+      Meter * meter = port->meters[i];
+      if (!meter)
+        continue;
+
+      meter_set_active (meter, false);
+      wait_until_unused (meter);
+      meter->port = NULL;
+    }
+}
+
 Meter *
 meter_new_for_port (Port * port)
 {
@@ -197,6 +318,9 @@ meter_new_for_port (Port * port)
 
   self->port = port;
 
+  /* never unsubscribed */
+  self->unsubscribed_cycle = UINT_FAST64_MAX;
+
   /* master */
   if (port->id.type == TYPE_AUDIO || port->id.type == TYPE_CV)
     {
@@ -224,6 +348,8 @@ meter_new_for_port (Port * port)
           peak_dsp_init (
             self->peak_processor, AUDIO_ENGINE->sample_rate);
         }
+
+      meter_set_active (self, true);
     }
   else if (port->id.type == TYPE_EVENT)
     {
@@ -235,6 +361,12 @@ meter_new_for_port (Port * port)
 void
 meter_free (Meter * self)
 {
+  if (self->port)
+    {
+      meter_set_active (self, false);
+      wait_until_unused (self);
+    }
+
 #define FREE_DSP(x, name) \
   if (self->x) \
     { \
@@ -1,65 +1,90 @@
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 /*
- * Copyright (C) 2020-2021 Alexandros Theodotou <alex at zrythm dot org>
+ * Copyright (C) 2020-2022 Alexandros Theodotou <alex at zrythm dot org>
  */
 
 #include "audio/midi_file.h"
+#include "utils/objects.h"
 
 #include <gtk/gtk.h>
 
+#include <glib/gi18n.h>
+
 #include <ext/midilib/src/midifile.h>
 
+typedef enum
+{
+  Z_AUDIO_MIDI_FILE_ERROR_FAILED,
+} ZAudioMidiFileError;
+
+#define Z_AUDIO_MIDI_FILE_ERROR \
+  z_audio_midi_file_error_quark ()
+GQuark
+z_audio_midi_file_error_quark (void);
+G_DEFINE_QUARK (
+  z - audio - midi - file - error - quark,
+  z_audio_midi_file_error)
+
 /**
- * Returns whether the given track in the midi file
- * has data.
+ * Returns whether the given MIDI message type counts
+ * as track data.
  */
-bool
-midi_file_track_has_data (const char * abs_path, int track_idx)
+static bool
+is_data_event (int ev)
 {
-  MIDI_FILE * mf = midiFileOpen (abs_path);
-  g_return_val_if_fail (mf, false);
+  switch (ev)
+    {
+    case msgNoteOn:
+    case msgNoteKeyPressure:
+    case msgSetParameter:
+    case msgSetProgram:
+    case msgChangePressure:
+    case msgSetPitchWheel:
+    case msgSysEx1:
+    case msgSysEx2:
+      return true;
+    default:
+      return false;
+    }
+}
+
+static int
+get_event_type (const MIDI_MSG * msg)
+{
+  return msg->bImpliedMsg ? msg->iImpliedMsg : msg->iType;
+}
 
+static bool
+track_has_data (MIDI_FILE * mf, int track_idx)
+{
   MIDI_MSG msg;
   midiReadInitMessage (&msg);
 
-  int ev;
-  g_debug ("reading MIDI Track %d", track_idx);
   bool have_data = false;
-  while (midiReadGetNextMessage (mf, track_idx, &msg))
+  while (
+    !have_data
+    && midiReadGetNextMessage (mf, track_idx, &msg))
     {
-      if (msg.bImpliedMsg)
-        {
-          ev = msg.iImpliedMsg;
-        }
-      else
-        {
-          ev = msg.iType;
-        }
-
-      switch (ev)
-        {
-        case msgNoteOff:
-        case msgMetaEvent:
-          break;
-        case msgNoteOn:
-        case msgNoteKeyPressure:
-        case msgSetParameter:
-        case msgSetProgram:
-        case msgChangePressure:
-        case msgSetPitchWheel:
-        case msgSysEx1:
-        case msgSysEx2:
-          have_data = true;
-          break;
-        }
-
-      if (have_data)
-        {
-          break;
-        }
+      have_data = is_data_event (get_event_type (&msg));
     }
 
   midiReadFreeMessage (&msg);
+
+  return have_data;
+}
+
+/**
+ * Returns whether the given track in the midi file
+ * has data.
+ */
+bool
+midi_file_track_has_data (const char * abs_path, int track_idx)
+{
+  MIDI_FILE * mf = midiFileOpen (abs_path);
+  g_return_val_if_fail (mf, false);
+
+  bool have_data = track_has_data (mf, track_idx);
+
   midiFileClose (mf);
 
   return have_data;
@@ -76,8 +101,6 @@ midi_file_get_num_tracks (
   MIDI_FILE * mf = midiFileOpen (abs_path);
   g_return_val_if_fail (mf, -1);
 
-  int actual_num = 0;
-
   int num = midiReadGetNumTracks (mf);
   g_debug ("%s: num tracks = %d", abs_path, num);
 
@@ -87,9 +110,10 @@ midi_file_get_num_tracks (
       return num;
     }
 
+  int actual_num = 0;
   for (int i = 0; i < num; i++)
     {
-      if (midi_file_track_has_data (abs_path, i))
+      if (track_has_data (mf, i))
         {
           actual_num++;
         }
@@ -99,3 +123,201 @@ midi_file_get_num_tracks (
 
   return actual_num;
 }
+
+/**
+ * Ends the first unended note with the given pitch.
+ */
+static void
+end_note (
+  MidiFileTrack * self,
+  GArray *        unended,
+  int             pitch,
+  int64_t         pos)
+{
+  for (guint i = 0; i < unended->len; i++)
+    {
+      MidiFileNote * note =
+        &self->notes[g_array_index (unended, int, i)];
+      if (note->pitch == pitch)
+        {
+          note->end = pos;
+          g_array_remove_index (unended, i);
+          return;
+        }
+    }
+
+  g_message (
+    "Found a Note off event without a corresponding "
+    "Note on. Skipping...");
+}
+
+static void
+read_track (MIDI_FILE * mf, MidiFileTrack * self)
+{
+  MIDI_MSG msg;
+  midiReadInitMessage (&msg);
+
+  /* indices of the notes that were not ended yet */
+  GArray * unended = g_array_new (false, false, sizeof (int));
+
+  while (midiReadGetNextMessage (mf, self->idx, &msg))
+    {
+      int64_t pos = (int64_t) msg.dwAbsPos;
+      int     ev = get_event_type (&msg);
+      self->last_event_pos = MAX (self->last_event_pos, pos);
+      self->has_data = self->has_data || is_data_event (ev);
+
+      switch (ev)
+        {
+        case msgNoteOff:
+          end_note (
+            self, unended, msg.MsgData.NoteOff.iNote, pos);
+          break;
+        case msgNoteOn:
+          /* 0 velocity is a note off */
+          if (msg.MsgData.NoteOn.iVolume == 0)
+            {
+              end_note (
+                self, unended, msg.MsgData.NoteOn.iNote, pos);
+              break;
+            }
+
+          if ((size_t) self->num_notes == self->notes_size)
+            {
+              self->notes_size =
+                MAX (self->notes_size * 2, 64);
+              self->notes = g_realloc_n (
+                self->notes, self->notes_size,
+                sizeof (MidiFileNote));
+            }
+          MidiFileNote * note = &self->notes[self->num_notes];
+          note->start = pos;
+          note->end = -1;
+          note->pitch = msg.MsgData.NoteOn.iNote;
+          note->velocity = msg.MsgData.NoteOn.iVolume;
+          g_array_append_val (unended, self->num_notes);
+          self->num_notes++;
+          break;
+        case msgMetaEvent:
+          switch (msg.MsgData.MetaEvent.iType)
+            {
+            case metaTrackName:
+              g_free (self->name);
+              self->name = g_strndup (
+                (char *)
+                  msg.MsgData.MetaEvent.Data.Text.pData,
+                (gsize) MAX (msg.iMsgSize - 3, 0));
+              break;
+            case metaEndSequence:
+              self->end_pos = pos;
+              break;
+            default:
+              break;
+            }
+          break;
+        default:
+          break;
+        }
+    }
+
+  g_array_free (unended, true);
+  midiReadFreeMessage (&msg);
+}
+
+/**
+ * Reads all the tracks of the given MIDI file.
+ */
+MidiFile *
+midi_file_new (const char * abs_path, GError ** error)
+{
+  MIDI_FILE * mf = midiFileOpen (abs_path);
+  if (!mf)
+    {
+      g_set_error (
+        error, Z_AUDIO_MIDI_FILE_ERROR,
+        Z_AUDIO_MIDI_FILE_ERROR_FAILED,
+        _ ("Failed to open MIDI file %s"), abs_path);
+      return NULL;
+    }
+
+  MidiFile * self = object_new (MidiFile);
+  self->ppqn = midiFileGetPPQN (mf);
+  self->num_tracks = MAX (midiReadGetNumTracks (mf), 0);
+  self->tracks =
+    object_new_n ((size_t) self->num_tracks, MidiFileTrack *);
+  for (int i = 0; i < self->num_tracks; i++)
+    {
+      MidiFileTrack * track = object_new (MidiFileTrack);
+      track->idx = i;
+      track->end_pos = -1;
+      read_track (mf, track);
+      self->tracks[i] = track;
+    }
+
+  midiFileClose (mf);
+
+  return self;
+}
+
+/**
+ * Returns the number of tracks with data.
+ */
+int
+midi_file_get_num_nonempty_tracks (const MidiFile * self)
+{
+  int num = 0;
+  for (int i = 0; i < self->num_tracks; i++)
+    {
+      if (self->tracks[i]->has_data)
+        num++;
+    }
+
+  return num;
+}
+
+/**
+ * Returns the track with data at the given index,
+ * counting only tracks with data, or NULL if there
+ * is no such track.
+ */
+const MidiFileTrack *
+midi_file_get_nonempty_track (
+  const MidiFile * self,
+  int              idx)
+{
+  int cur_idx = 0;
+  for (int i = 0; i < self->num_tracks; i++)
+    {
+      MidiFileTrack * track = self->tracks[i];
+      if (!track->has_data)
+        continue;
+
+      if (cur_idx == idx)
+        return track;
+
+      cur_idx++;
+    }
+
+  return NULL;
+}
+
+static void
+midi_file_track_free (MidiFileTrack * self)
+{
+  g_free_and_null (self->name);
+  g_free_and_null (self->notes);
+
+  object_zero_and_free (self);
+}
+
+void
+midi_file_free (MidiFile * self)
+{
+  for (int i = 0; i < self->num_tracks; i++)
+    {
+      midi_file_track_free (self->tracks[i]);
+    }
+  g_free_and_null (self->tracks);
+
+  object_zero_and_free (self);
+}
@@ -27,6 +27,121 @@ create_midi_mapping (void)
   return self;
 }
 
+static MidiMappingsTable *
+table_new (int entries_size)
+{
+  MidiMappingsTable * self = object_new (MidiMappingsTable);
+
+  self->entries_size = MAX (entries_size, 16);
+  self->entries = object_new_n (
+    (size_t) self->entries_size, MidiMappingsTableEntry);
+
+  return self;
+}
+
+static void
+table_free (MidiMappingsTable * self)
+{
+  for (int i = 0; i < 128; i++)
+    {
+      g_free_and_null (self->heads[i]);
+    }
+  g_free_and_null (self->entries);
+
+  object_zero_and_free (self);
+}
+
+/**
+ * Adds the mapping at the end of the chain for its
+ * key.
+ *
+ * The entry is filled in before it is linked, so
+ * midi_mappings_apply() never sees it half-added.
+ */
+static void
+table_append (MidiMappingsTable * self, MidiMapping * mapping)
+{
+  g_return_if_fail (self->num_entries < self->entries_size);
+
+  /* can never match a message */
+  if (mapping->key[0] < 0x80 || mapping->key[1] >= 0x80)
+    return;
+
+  int                      idx = self->num_entries++;
+  MidiMappingsTableEntry * entry = &self->entries[idx];
+  entry->mapping = mapping;
+  entry->next = -1;
+
+  int   status = mapping->key[0] - 0x80;
+  int * heads = self->heads[status];
+  if (!heads)
+    {
+      heads = g_new (int, 128);
+      for (int i = 0; i < 128; i++)
+        {
+          heads[i] = -1;
+        }
+      g_atomic_pointer_set (&self->heads[status], heads);
+    }
+
+  int * link = &heads[mapping->key[1]];
+  while (*link >= 0)
+    {
+      link = &self->entries[*link].next;
+    }
+  g_atomic_int_set (link, idx);
+}
+
+static inline int
+table_get_head (
+  MidiMappingsTable * self,
+  midi_byte_t         status,
+  midi_byte_t         data)
+{
+  int * heads = (int *) g_atomic_pointer_get (
+    &self->heads[status - 0x80]);
+  if (!heads)
+    return -1;
+
+  return g_atomic_int_get (&heads[data]);
+}
+
+/**
+ * Updates the lookup table after the mappings
+ * changed.
+ *
+ * @param appended Whether the only change is a
+ *   mapping added at the end.
+ */
+static void
+update_table (MidiMappings * self, bool appended)
+{
+  MidiMappingsTable * table = self->table;
+  if (
+    appended && table
+    && table->num_entries < table->entries_size)
+    {
+      table_append (
+        table, self->mappings[self->num_mappings - 1]);
+      return;
+    }
+
+  MidiMappingsTable * new_table =
+    table_new (self->num_mappings * 2);
+  for (int i = 0; i < self->num_mappings; i++)
+    {
+      table_append (new_table, self->mappings[i]);
+    }
+
+  /* mappings in use by the engine are only changed
+   * from undoable actions, which pause the engine
+   * first (see engine_wait_for_pause() in
+   * undoable_action_do()), so the old table can be
+   * freed right away */
+  g_atomic_pointer_set (&self->table, new_table);
+  object_free_w_func_and_null (table_free, table);
+}
+
 /**
  * Initializes the MidiMappings after a Project
  * is loaded.
@@ -44,6 +159,8 @@ midi_mappings_init_loaded (MidiMappings * self)
       mapping->dest =
         port_find_from_identifier (&mapping->dest_id);
     }
+
+  update_table (self, false);
 }
 
 /**
@@ -89,6 +206,8 @@ midi_mappings_bind_at (
   mapping->dest = dest_port;
   g_atomic_int_set (&mapping->enabled, (guint) true);
 
+  update_table (self, idx == self->num_mappings - 1);
+
   char str[100];
   midi_ctrl_change_get_ch_and_description (buf, str);
 
@@ -127,6 +246,8 @@ midi_mappings_unbind (
     }
   self->num_mappings--;
 
+  update_table (self, false);
+
   object_free_w_func_and_null (
     midi_mapping_free, mapping_before);
 
@@ -251,6 +372,27 @@ apply_mapping (MidiMapping * mapping, midi_byte_t * buf)
     }
 }
 
+/**
+ * Applies the value of a 14-bit CC.
+ */
+static void
+apply_mapping_14bit (
+  MidiMapping * mapping,
+  float         normalized_val)
+{
+  g_return_if_fail (mapping->dest);
+
+  Port * dest = mapping->dest;
+  if (
+    dest->id.type == TYPE_CONTROL
+    && !(dest->id.flags & PORT_FLAG_TOGGLE))
+    {
+      port_set_control_value (
+        dest, normalized_val, F_NORMALIZED,
+        F_PUBLISH_EVENTS);
+    }
+}
+
 /**
  * Applies the events to the appropriate mapping.
  *
@@ -292,14 +434,49 @@ midi_mappings_apply_from_cc_events (
 void
 midi_mappings_apply (MidiMappings * self, midi_byte_t * buf)
 {
-  for (int i = 0; i < self->num_mappings; i++)
+  MidiMappingsTable * table =
+    (MidiMappingsTable *) g_atomic_pointer_get (&self->table);
+  if (!table || buf[0] < 0x80 || buf[1] >= 0x80)
+    return;
+
+  if ((buf[0] & 0xf0) == MIDI_CH1_CTRL_CHANGE)
     {
-      MidiMapping * mapping = self->mappings[i];
+      int         ch = buf[0] & 0xf;
+      midi_byte_t controller = buf[1];
 
+      /* LSB following its MSB */
       if (
-        g_atomic_int_get (&mapping->enabled)
-        && mapping->key[0] == buf[0]
-        && mapping->key[1] == buf[1])
+        controller >= 32 && controller < 64
+        && self->last_cc[ch] == controller - 31)
+        {
+          int val =
+            (self->last_cc_value[ch] << 7) | buf[2];
+          float normalized_val = (float) val / 16383.f;
+          midi_byte_t msb = (midi_byte_t) (controller - 32);
+          for (int i = table_get_head (table, buf[0], msb);
+               i >= 0;
+               i = g_atomic_int_get (&table->entries[i].next))
+            {
+              MidiMapping * mapping =
+                table->entries[i].mapping;
+              if (g_atomic_int_get (&mapping->enabled))
+                {
+                  apply_mapping_14bit (
+                    mapping, normalized_val);
+                }
+            }
+        }
+
+      self->last_cc[ch] = (midi_byte_t) (controller + 1);
+      self->last_cc_value[ch] = buf[2];
+    }
+
+  for (int i = table_get_head (table, buf[0], buf[1]);
+       i >= 0;
+       i = g_atomic_int_get (&table->entries[i].next))
+    {
+      MidiMapping * mapping = table->entries[i].mapping;
+      if (g_atomic_int_get (&mapping->enabled))
         {
           apply_mapping (mapping, buf);
         }
@@ -369,6 +546,8 @@ midi_mappings_clone (const MidiMappings * src)
     }
   self->num_mappings = src->num_mappings;
 
+  update_table (self, false);
+
   return self;
 }
 
@@ -381,6 +560,7 @@ midi_mappings_free (MidiMappings * self)
         midi_mapping_free, self->mappings[i]);
     }
   object_zero_and_free (self->mappings);
+  object_free_w_func_and_null (table_free, self->table);
 
   object_zero_and_free (self);
 }
@@ -165,6 +165,7 @@ midi_region_insert_midi_note (
     self->midi_notes_size, MidiNote *);
   array_insert (
     self->midi_notes, self->num_midi_notes, idx, midi_note);
+  arranger_object_positions_changed ();
 
   for (int i = idx; i < self->num_midi_notes; i++)
     {
@@ -340,347 +341,99 @@ midi_region_remove_midi_note (
 }
 
 /**
- * Creates a MIDI region from the given MIDI
- * file path, starting at the given Position.
+ * Creates a MIDI region from the given track of a
+ * MIDI file, starting at the given Position.
  *
- * @param idx The index of this track, starting from
- *   0. This will be sequential, ie, if idx 1 is
- *   requested and the MIDI file only has tracks
- *   5 and 7, it will use track 7.
+ * The notes are created in bulk.
+ *
+ * @return The region, or NULL if the track is empty.
  */
 ZRegion *
-midi_region_new_from_midi_file (
-  const Position * start_pos,
-  const char *     abs_path,
-  unsigned int     track_name_hash,
-  int              lane_pos,
-  int              idx_inside_lane,
-  int              idx)
+midi_region_new_from_midi_file_track (
+  const Position *      start_pos,
+  const MidiFile *      mf,
+  const MidiFileTrack * mf_track,
+  unsigned int          track_name_hash,
+  int                   lane_pos,
+  int                   idx_inside_lane)
 {
-  g_message ("%s: reading from %s...", __func__, abs_path);
+  /* convert time to zrythm time */
+  double ticks_per_pulse =
+    transport_get_ppqn (TRANSPORT) / (double) mf->ppqn;
+
+  /* this is an empty track */
+  if (mf_track->end_pos == 0)
+    {
+      return NULL;
+    }
 
   ZRegion *        self = object_new (ZRegion);
   ArrangerObject * r_obj = (ArrangerObject *) self;
-
   self->id.type = REGION_TYPE_MIDI;
 
-  MIDI_FILE * mf = midiFileOpen (abs_path);
-  g_return_val_if_fail (mf, NULL);
-
-  char         str[128];
-  char         txt[60000];
-  int          ev;
-  MIDI_MSG     msg;
-  unsigned int j;
-  Position     pos, global_pos;
-  MidiNote *   mn;
-  double       ticks;
-
   Position end_pos;
-  position_from_ticks (&end_pos, start_pos->ticks + 1);
+  if (mf_track->end_pos > 0)
+    {
+      position_from_ticks (
+        &end_pos,
+        start_pos->ticks
+          + (double) mf_track->end_pos * ticks_per_pulse);
+    }
+  else
+    {
+      position_from_ticks (&end_pos, start_pos->ticks + 1);
+    }
   region_init (
     self, start_pos, &end_pos, track_name_hash, lane_pos,
     idx_inside_lane);
 
-  midiReadInitMessage (&msg);
-  int    num_tracks = midiReadGetNumTracks (mf);
-  double ppqn = (double) midiFileGetPPQN (mf);
-  double transport_ppqn = transport_get_ppqn (TRANSPORT);
-
-  int actual_iter = 0;
-
-  for (int i = 0; i < num_tracks; i++)
+  if (mf_track->name)
     {
-      if (!midi_file_track_has_data (abs_path, i))
-        {
-          continue;
-        }
+      arranger_object_set_name (
+        r_obj, mf_track->name, F_NO_PUBLISH_EVENTS);
+    }
 
-      if (actual_iter != idx)
-        {
-          actual_iter++;
-          continue;
-        }
+  /* unended notes end at the end of the region */
+  double length =
+    arranger_object_get_length_in_ticks (r_obj);
 
-      g_message ("%s: reading MIDI Track %d", __func__, i);
-      g_return_val_if_fail (i < 1000, NULL);
-      while (midiReadGetNextMessage (mf, i, &msg))
+  self->midi_notes_size =
+    (size_t) MAX (mf_track->num_notes, 1);
+  self->midi_notes =
+    object_new_n (self->midi_notes_size, MidiNote *);
+  for (int i = 0; i < mf_track->num_notes; i++)
+    {
+      const MidiFileNote * note = &mf_track->notes[i];
+      Position             note_start, note_end;
+      position_from_ticks (
+        &note_start, (double) note->start * ticks_per_pulse);
+      if (note->end >= 0)
         {
-          /* convert time to zrythm time */
-          ticks =
-            ((double) msg.dwAbsPos * transport_ppqn) / ppqn;
-          position_from_ticks (&pos, ticks);
           position_from_ticks (
-            &global_pos, r_obj->pos.ticks + ticks);
-          g_debug ("dwAbsPos: %d ", msg.dwAbsPos);
-
-          int bars = position_get_bars (&pos, true);
-          if (ZRYTHM_HAVE_UI && bars > TRANSPORT->total_bars - 8)
-            {
-              transport_update_total_bars (
-                TRANSPORT, bars + 8, F_PUBLISH_EVENTS);
-            }
-
-          if (msg.bImpliedMsg)
-            {
-              ev = msg.iImpliedMsg;
-            }
-          else
-            {
-              ev = msg.iType;
-            }
-
-          if (muGetMIDIMsgName (str, ev))
-            {
-              g_debug ("MIDI msg name: %s", str);
-            }
-          switch (ev)
-            {
-            case msgNoteOff:
-handle_note_off:
-              g_debug (
-                "Note off at %d "
-                "[ch %d pitch %d]",
-                msg.dwAbsPos, msg.MsgData.NoteOff.iChannel,
-                msg.MsgData.NoteOff.iNote);
-              mn = midi_region_pop_unended_note (
-                self, msg.MsgData.NoteOff.iNote);
-              if (mn)
-                {
-                  arranger_object_end_pos_setter (
-                    (ArrangerObject *) mn, &pos);
-                }
-              else
-                {
-                  g_message (
-                    "Found a Note off event without "
-                    "a corresponding Note on. "
-                    "Skipping...");
-                }
-              break;
-            case msgNoteOn:
-              /* 0 velocity is a note off */
-              if (msg.MsgData.NoteOn.iVolume == 0)
-                {
-                  msg.MsgData.NoteOff.iChannel =
-                    msg.MsgData.NoteOn.iChannel;
-                  msg.MsgData.NoteOff.iNote =
-                    msg.MsgData.NoteOn.iNote;
-                  goto handle_note_off;
-                }
-
-              g_debug (
-                "Note on at %d "
-                "[ch %d pitch %d vel %d]",
-                msg.dwAbsPos, msg.MsgData.NoteOn.iChannel,
-                msg.MsgData.NoteOn.iNote,
-                msg.MsgData.NoteOn.iVolume);
-              midi_region_start_unended_note (
-                self, &pos, NULL, msg.MsgData.NoteOn.iNote,
-                msg.MsgData.NoteOn.iVolume, 0);
-              break;
-            case msgNoteKeyPressure:
-              muGetNameFromNote (
-                str, msg.MsgData.NoteKeyPressure.iNote);
-              g_debug (
-                "(%.2d) %s %d",
-                msg.MsgData.NoteKeyPressure.iChannel, str,
-                msg.MsgData.NoteKeyPressure.iPressure);
-              break;
-            case msgSetParameter:
-              muGetControlName (
-                str, msg.MsgData.NoteParameter.iControl);
-              g_debug (
-                "(%.2d) %s -> %d",
-                msg.MsgData.NoteParameter.iChannel, str,
-                msg.MsgData.NoteParameter.iParam);
-              break;
-            case msgSetProgram:
-              muGetInstrumentName (
-                str, msg.MsgData.ChangeProgram.iProgram);
-              g_debug (
-                "(%.2d) %s",
-                msg.MsgData.ChangeProgram.iChannel, str);
-              break;
-            case msgChangePressure:
-              muGetControlName (
-                str, msg.MsgData.ChangePressure.iPressure);
-              g_debug (
-                "(%.2d) %s",
-                msg.MsgData.ChangePressure.iChannel, str);
-              break;
-            case msgSetPitchWheel:
-              g_debug (
-                "(%.2d) %d", msg.MsgData.PitchWheel.iChannel,
-                msg.MsgData.PitchWheel.iPitch);
-              break;
-            case msgMetaEvent:
-              g_debug ("---- meta events");
-              switch (msg.MsgData.MetaEvent.iType)
-                {
-                case metaMIDIPort:
-                  g_debug (
-                    "MIDI Port = %d",
-                    msg.MsgData.MetaEvent.Data.iMIDIPort);
-                  break;
-                case metaSequenceNumber:
-                  g_debug (
-                    "Sequence Number = %d",
-                    msg.MsgData.MetaEvent.Data.iSequenceNumber);
-                  break;
-                case metaTextEvent:
-                  g_debug (
-                    "Text = '%s'",
-                    msg.MsgData.MetaEvent.Data.Text.pData);
-                  break;
-                case metaCopyright:
-                  g_debug (
-                    "Copyright = '%s'",
-                    msg.MsgData.MetaEvent.Data.Text.pData);
-                  break;
-                case metaTrackName:
-                  {
-                    char tmp[6000];
-                    strncpy (
-                      tmp,
-                      (char *)
-                        msg.MsgData.MetaEvent.Data.Text.pData,
-                      msg.iMsgSize - 3);
-                    tmp[msg.iMsgSize - 3] = '\0';
-                    arranger_object_set_name (
-                      (ArrangerObject *) self, tmp,
-                      F_NO_PUBLISH_EVENTS);
-                    g_warn_if_fail (self->name);
-                    g_message (
-                      "[data sz %d] Track name = '%s'",
-                      msg.iMsgSize - 3, self->name);
-                  }
-                  break;
-                case metaInstrument:
-                  g_message (
-                    "Instrument = '%s'",
-                    msg.MsgData.MetaEvent.Data.Text.pData);
-                  break;
-                case metaLyric:
-                  g_message (
-                    "Lyric = '%s'",
-                    msg.MsgData.MetaEvent.Data.Text.pData);
-                  break;
-                case metaMarker:
-                  g_message (
-                    "Marker = '%s'",
-                    msg.MsgData.MetaEvent.Data.Text.pData);
-                  break;
-                case metaCuePoint:
-                  g_message (
-                    "Cue point = '%s'",
-                    msg.MsgData.MetaEvent.Data.Text.pData);
-                  break;
-                case metaEndSequence:
-                  g_message ("End Sequence");
-                  if (position_is_equal (&pos, start_pos))
-                    {
-                      /* this is an empty track,
-                        * so return NULL
-                       * instead */
-                      return NULL;
-                    }
-                  arranger_object_end_pos_setter (
-                    r_obj, &global_pos);
-                  arranger_object_loop_end_pos_setter (
-                    r_obj, &global_pos);
-                  break;
-                case metaSetTempo:
-                  g_message (
-                    "tempo %d",
-                    msg.MsgData.MetaEvent.Data.Tempo.iBPM);
-                  break;
-                case metaSMPTEOffset:
-                  g_message (
-                    "SMPTE offset = %d:%d:%d.%d %d",
-                    msg.MsgData.MetaEvent.Data.SMPTE.iHours,
-                    msg.MsgData.MetaEvent.Data.SMPTE.iMins,
-                    msg.MsgData.MetaEvent.Data.SMPTE.iSecs,
-                    msg.MsgData.MetaEvent.Data.SMPTE.iFrames,
-                    msg.MsgData.MetaEvent.Data.SMPTE.iFF);
-                  break;
-                case metaTimeSig:
-                  g_message (
-                    "Time sig = %d/%d",
-                    msg.MsgData.MetaEvent.Data.TimeSig.iNom,
-                    msg.MsgData.MetaEvent.Data.TimeSig.iDenom
-                      / MIDI_NOTE_CROCHET);
-                  break;
-                case metaKeySig:
-                  if (muGetKeySigName (
-                        str,
-                        msg.MsgData.MetaEvent.Data.KeySig.iKey))
-                    g_message ("Key sig = %s", str);
-                  break;
-                case metaSequencerSpecific:
-                  g_message ("Sequencer specific = ");
-                  /*HexList(msg.MsgData.MetaEvent.Data.Sequencer.pData, msg.MsgData.MetaEvent.Data.Sequencer.iSize);*/
-                  break;
-                }
-              break;
-
-            case msgSysEx1:
-            case msgSysEx2:
-              g_message ("Sysex = ");
-              /*HexList(msg.MsgData.SysEx.pData, msg.MsgData.SysEx.iSize);*/
-              break;
-            }
-
-          /* print the hex */
-          if (
-            ev == msgSysEx1
-            || (ev == msgMetaEvent && msg.MsgData.MetaEvent.iType == metaSequencerSpecific))
-            {
-              /* Already done a hex dump */
-            }
-          else
-            {
-              char tmp[100];
-              strcpy (txt, "[");
-              if (msg.bImpliedMsg)
-                {
-                  sprintf (tmp, "%.2x!", msg.iImpliedMsg);
-                  strcat (txt, tmp);
-                }
-              for (j = 0; j < msg.iMsgSize; j++)
-                {
-                  sprintf (tmp, " %.2x ", msg.data[j]);
-                  strcat (txt, tmp);
-                }
-              strcat (txt, "]");
-              g_debug ("%s", txt);
-            }
+            &note_end, (double) note->end * ticks_per_pulse);
         }
-
-      if (actual_iter == idx)
+      else
         {
-          break;
+          position_from_ticks (&note_end, length);
         }
+      MidiNote * mn = midi_note_new (
+        &self->id, &note_start, &note_end, note->pitch,
+        note->velocity);
+      midi_note_set_region_and_index (mn, self, i);
+      self->midi_notes[i] = mn;
     }
+  self->num_midi_notes = mf_track->num_notes;
 
-  midiReadFreeMessage (&msg);
-  midiFileClose (mf);
-
-  if (self->num_unended_notes != 0)
+  /* extend the song to fit the region */
+  Position last_pos;
+  position_from_ticks (
+    &last_pos,
+    (double) mf_track->last_event_pos * ticks_per_pulse);
+  int bars = position_get_bars (&last_pos, true);
+  if (ZRYTHM_HAVE_UI && bars > TRANSPORT->total_bars - 8)
     {
-      g_warning (
-        "unended notes found: %d", self->num_unended_notes);
-
-      double length = arranger_object_get_length_in_ticks (
-        (ArrangerObject *) self);
-      position_from_ticks (&end_pos, length);
-
-      while (self->num_unended_notes > 0)
-        {
-          mn = midi_region_pop_unended_note (self, -1);
-          arranger_object_end_pos_setter (
-            (ArrangerObject *) mn, &end_pos);
-        }
+      transport_update_total_bars (
+        TRANSPORT, bars + 8, F_PUBLISH_EVENTS);
     }
 
   g_return_val_if_fail (
@@ -0,0 +1,271 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "audio/peak_cache.h"
+#include "utils/objects.h"
+
+#include <glib.h>
+
+typedef enum
+{
+  Z_AUDIO_PEAK_CACHE_ERROR_FAILED,
+} ZAudioPeakCacheError;
+
+#define Z_AUDIO_PEAK_CACHE_ERROR \
+  z_audio_peak_cache_error_quark ()
+GQuark
+z_audio_peak_cache_error_quark (void);
+G_DEFINE_QUARK (
+  z - audio - peak - cache - error - quark,
+  z_audio_peak_cache_error)
+
+#define FILE_MAGIC "ZPEAKS\0\0"
+#define FILE_VERSION 1
+
+/**
+ * Header of peak files, followed by the peaks of
+ * all levels in the native float format.
+ */
+typedef struct FileHeader
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t base_frames;
+  uint64_t num_frames;
+  uint64_t data_size;
+} FileHeader;
+
+/**
+ * Sets up the levels for the number of frames.
+ */
+static void
+init_levels (PeakCache * self)
+{
+  size_t           data_size = 0;
+  size_t           num_peaks = (size_t) MAX (
+    (self->num_frames + PEAK_CACHE_BASE_FRAMES - 1)
+      / PEAK_CACHE_BASE_FRAMES,
+    1);
+  unsigned_frame_t frames_per_peak = PEAK_CACHE_BASE_FRAMES;
+  for (int i = 0; i < PEAK_CACHE_MAX_LEVELS; i++)
+    {
+      PeakCacheLevel * level = &self->levels[i];
+      level->frames_per_peak = frames_per_peak;
+      level->num_peaks = num_peaks;
+      data_size += num_peaks * 2;
+      self->num_levels++;
+
+      if (num_peaks == 1)
+        break;
+
+      num_peaks = (num_peaks + 1) / 2;
+      frames_per_peak *= 2;
+    }
+
+  self->data_size = data_size;
+}
+
+/**
+ * Points the levels to their part of
+ * PeakCache.data.
+ */
+static void
+init_level_data (PeakCache * self)
+{
+  size_t offset = 0;
+  for (int i = 0; i < self->num_levels; i++)
+    {
+      PeakCacheLevel * level = &self->levels[i];
+      level->peaks = &self->data[offset];
+      offset += level->num_peaks * 2;
+    }
+}
+
+PeakCache *
+peak_cache_new (
+  const float *          frames,
+  const unsigned_frame_t num_frames,
+  const channels_t       channels)
+{
+  PeakCache * self = object_new (PeakCache);
+  self->num_frames = num_frames;
+  init_levels (self);
+  self->data = object_new_n (self->data_size, float);
+  init_level_data (self);
+
+  /* finest level from the frames */
+  PeakCacheLevel * level = &self->levels[0];
+  for (size_t i = 0; i < level->num_peaks; i++)
+    {
+      unsigned_frame_t start = i * PEAK_CACHE_BASE_FRAMES;
+      unsigned_frame_t end =
+        MIN (start + PEAK_CACHE_BASE_FRAMES, num_frames);
+      float min = 0.f, max = 0.f;
+      if (start < end)
+        {
+          min = max = frames[start * channels];
+        }
+      for (size_t j = start * channels; j < end * channels;
+           j++)
+        {
+          min = MIN (min, frames[j]);
+          max = MAX (max, frames[j]);
+        }
+      level->peaks[i * 2] = min;
+      level->peaks[i * 2 + 1] = max;
+    }
+
+  /* each following level from the previous one */
+  for (int i = 1; i < self->num_levels; i++)
+    {
+      const PeakCacheLevel * prev = &self->levels[i - 1];
+      level = &self->levels[i];
+      for (size_t j = 0; j < level->num_peaks; j++)
+        {
+          size_t first = j * 2;
+          size_t second =
+            MIN (first + 1, prev->num_peaks - 1);
+          level->peaks[j * 2] = MIN (
+            prev->peaks[first * 2], prev->peaks[second * 2]);
+          level->peaks[j * 2 + 1] = MAX (
+            prev->peaks[first * 2 + 1],
+            prev->peaks[second * 2 + 1]);
+        }
+    }
+
+  return self;
+}
+
+bool
+peak_cache_get_min_max (
+  const PeakCache *      self,
+  const unsigned_frame_t start_frame,
+  const unsigned_frame_t end_frame,
+  float *                min,
+  float *                max)
+{
+  if (
+    end_frame <= start_frame
+    || end_frame - start_frame < PEAK_CACHE_BASE_FRAMES)
+    return false;
+
+  /* find the coarsest level whose peaks fit in the
+   * range */
+  const unsigned_frame_t span = end_frame - start_frame;
+  const PeakCacheLevel * level = &self->levels[0];
+  for (int i = 1; i < self->num_levels; i++)
+    {
+      if (self->levels[i].frames_per_peak > span)
+        break;
+      level = &self->levels[i];
+    }
+
+  const unsigned_frame_t fpp = level->frames_per_peak;
+  size_t                 first = (size_t) (start_frame / fpp);
+  size_t last = MIN (
+    (size_t) ((end_frame - 1) / fpp), level->num_peaks - 1);
+  for (size_t i = first; i <= last; i++)
+    {
+      *min = MIN (*min, level->peaks[i * 2]);
+      *max = MAX (*max, level->peaks[i * 2 + 1]);
+    }
+
+  return true;
+}
+
+PeakCache *
+peak_cache_new_from_file (
+  const char *           path,
+  const unsigned_frame_t num_frames,
+  GError **              error)
+{
+  GError *      err = NULL;
+  GMappedFile * mapped_file =
+    g_mapped_file_new (path, false, &err);
+  if (!mapped_file)
+    {
+      g_propagate_prefixed_error (
+        error, err, "Failed to map %s: ", path);
+      return NULL;
+    }
+
+  PeakCache * self = object_new (PeakCache);
+  self->mapped_file = mapped_file;
+  self->num_frames = num_frames;
+  init_levels (self);
+
+  size_t       size = g_mapped_file_get_length (mapped_file);
+  const char * contents =
+    g_mapped_file_get_contents (mapped_file);
+  FileHeader header;
+  if (size >= sizeof (header))
+    memcpy (&header, contents, sizeof (header));
+  if (
+    size != sizeof (header) + self->data_size * sizeof (float)
+    || memcmp (header.magic, FILE_MAGIC, 8) != 0
+    || header.version != FILE_VERSION
+    || header.base_frames != PEAK_CACHE_BASE_FRAMES
+    || header.num_frames != num_frames
+    || header.data_size != self->data_size)
+    {
+      g_set_error (
+        error, Z_AUDIO_PEAK_CACHE_ERROR,
+        Z_AUDIO_PEAK_CACHE_ERROR_FAILED,
+        "%s does not match the audio", path);
+      peak_cache_free (self);
+      return NULL;
+    }
+
+  /* the mapping is page-aligned, so the peaks
+   * after the header are aligned too */
+  self->data = (float *) (contents + sizeof (header));
+  init_level_data (self);
+
+  return self;
+}
+
+bool
+peak_cache_write_to_file (
+  const PeakCache * self,
+  const char *      path,
+  GError **         error)
+{
+  FileHeader header = {
+    .version = FILE_VERSION,
+    .base_frames = PEAK_CACHE_BASE_FRAMES,
+    .num_frames = self->num_frames,
+    .data_size = self->data_size,
+  };
+  memcpy (header.magic, FILE_MAGIC, 8);
+
+  size_t data_bytes = self->data_size * sizeof (float);
+  char * contents = g_malloc (sizeof (header) + data_bytes);
+  memcpy (contents, &header, sizeof (header));
+  memcpy (&contents[sizeof (header)], self->data, data_bytes);
+
+  /* written atomically so readers never see a
+   * partial file */
+  bool ret = g_file_set_contents (
+    path, contents, (gssize) (sizeof (header) + data_bytes),
+    error);
+  g_free (contents);
+
+  return ret;
+}
+
+void
+peak_cache_free (PeakCache * self)
+{
+  if (self->mapped_file)
+    {
+      g_mapped_file_unref (self->mapped_file);
+    }
+  else
+    {
+      object_zero_and_free (self->data);
+    }
+  object_zero_and_free (self);
+}
@@ -395,6 +395,7 @@ audio_pool_reload_clip_frame_bufs (AudioPool * self)
       else if (!in_use && clip->num_frames > 0)
         {
           /* unload frames */
+          audio_clip_free_peaks (clip);
           clip->num_frames = 0;
           free (clip->frames);
           clip->frames = NULL;
@@ -15,6 +15,7 @@
 #include "audio/graph.h"
 #include "audio/hardware_processor.h"
 #include "audio/master_track.h"
+#include "audio/meter.h"
 #include "audio/midi_event.h"
 #include "audio/pan.h"
 #include "audio/port.h"
@@ -35,6 +36,7 @@
 #include "utils/error.h"
 #include "utils/flags.h"
 #include "utils/hash.h"
+#include "utils/log.h"
 #include "utils/math.h"
 #include "utils/mem.h"
 #include "utils/object_utils.h"
@@ -2098,40 +2100,33 @@ send_data_to_windows_mme (
 /**
  * To be called when a control's value changes
  * so that a message can be sent to the UI.
+ *
+ * Changes to plugin ports are only flagged here.
+ * The plugin receives all changes of a cycle in
+ * one batch when it is next processed, and its UI
+ * receives the latest value of each changed port
+ * on its next refresh, so fast automation or
+ * modulation does not send an event per change.
  */
 static void
 port_forward_control_change_event (Port * self)
 {
-  /* if lv2 port/parameter */
-  if (self->value_type > 0)
-    {
-      Plugin * pl = port_get_plugin (self, 1);
-      g_return_if_fail (IS_PLUGIN_AND_NONNULL (pl) && pl->lv2);
-      lv2_ui_send_control_val_event_from_plugin_to_ui (
-        pl->lv2, self);
-    }
-  else if (self->id.owner_type == PORT_OWNER_TYPE_PLUGIN)
+  if (self->id.owner_type == PORT_OWNER_TYPE_PLUGIN)
     {
       Plugin * pl = port_get_plugin (self, 1);
-      if (pl)
+      g_return_if_fail (IS_PLUGIN_AND_NONNULL (pl));
+
+      g_atomic_int_set (&self->plugin_change_pending, 1);
+      g_atomic_int_set (&pl->control_changes_pending, 1);
+      g_atomic_int_set (&pl->ui_control_changes_pending, 1);
+
+      /* if not lv2 port/parameter */
+      if (
+        self->value_type == 0
+        && !g_atomic_int_get (&pl->state_changed_event_sent))
         {
-#ifdef HAVE_CARLA
-          if (
-            pl->setting->open_with_carla
-            && self->carla_param_id >= 0)
-            {
-              g_return_if_fail (pl->carla);
-              carla_native_plugin_set_param_value (
-                pl->carla, (uint32_t) self->carla_param_id,
-                self->control);
-            }
-#endif
-          if (!g_atomic_int_get (&pl->state_changed_event_sent))
-            {
-              EVENTS_PUSH (ET_PLUGIN_STATE_CHANGED, pl);
-              g_atomic_int_set (
-                &pl->state_changed_event_sent, 1);
-            }
+          EVENTS_PUSH (ET_PLUGIN_STATE_CHANGED, pl);
+          g_atomic_int_set (&pl->state_changed_event_sent, 1);
         }
     }
   else if (self->id.owner_type == PORT_OWNER_TYPE_FADER)
@@ -2149,8 +2144,6 @@ port_forward_control_change_event (Port * self)
         }
       else if (self->id.flags & PORT_FLAG_AMPLITUDE)
         {
-          if (ZRYTHM_HAVE_UI)
-            g_return_if_fail (track->channel->widget);
           fader_update_volume_and_fader_val (
             track->channel->fader);
           EVENTS_PUSH (
@@ -2901,6 +2894,19 @@ port_process (
 
           zix_ring_write (
             port->audio_ring, &port->buf[0], size);
+
+          /* update subscribed meters */
+          for (int i = 0; i < PORT_MAX_METERS; i++)
+            {
+              Meter * meter =
+                g_atomic_pointer_get (&port->meters[i]);
+              if (meter)
+                {
+                  meter_process (
+                    meter, &port->buf[0],
+                    AUDIO_ENGINE->block_length);
+                }
+            }
         }
 
       /* if track output (to be shown on mixer) */
@@ -3068,7 +3074,8 @@ port_process (
         AutomationTrack * at = port->at;
         if (G_UNLIKELY (!at))
           {
-            g_critical (
+            log_rt (
+              G_LOG_LEVEL_CRITICAL,
               "No automation track found for port "
               "%s",
               id->label);
@@ -3689,6 +3696,7 @@ port_clone (const Port * src)
 void
 port_free (Port * self)
 {
+  meter_detach_all_from_port (self);
   port_free_bufs (self);
 
 #ifdef HAVE_RTMIDI
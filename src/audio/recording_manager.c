@@ -154,6 +154,7 @@ handle_stop_recording (
         {
           AudioClip * clip = audio_region_get_clip (r);
           audio_clip_write_to_pool (clip, true, F_NOT_BACKUP);
+          audio_clip_build_peaks (clip);
         }
     }
 
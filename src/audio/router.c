@@ -57,6 +57,7 @@
 #include "utils/mpmc_queue.h"
 #include "utils/object_utils.h"
 #include "utils/objects.h"
+#include "utils/rt_checker.h"
 #include "utils/stoat.h"
 #include "zrythm_app.h"
 
@@ -156,7 +157,9 @@ router_start_cycle (
 
   self->callback_in_progress = true;
   zix_sem_post (&self->graph->callback_start);
+  rt_checker_allow_begin ();
   zix_sem_wait (&self->graph->callback_done);
+  rt_checker_allow_end ();
   self->callback_in_progress = false;
 
   zix_sem_post (&self->graph_access);
@@ -203,6 +206,18 @@ router_recalc_graph (Router * self, bool soft)
   g_message ("done");
 }
 
+void
+router_update_plugin_latencies (
+  Router *    self,
+  GPtrArray * plugins)
+{
+  g_return_if_fail (self->graph);
+
+  zix_sem_wait (&self->graph_access);
+  graph_update_latencies_for_plugins (self->graph, plugins);
+  zix_sem_post (&self->graph_access);
+}
+
 /**
  * Queues a control port change to be applied
  * when processing starts.
@@ -17,6 +17,7 @@
  * along with Zrythm.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "audio/audio_file_stream.h"
 #include "audio/audio_region.h"
 #include "audio/engine.h"
 #include "audio/group_target_track.h"
@@ -43,11 +44,41 @@
 
 #include <glib/gi18n.h>
 
+/**
+ * Returns a new request for playing the given set
+ * (or -1 to stop), following @p prev_request.
+ *
+ * The low 2 bits hold the set index + 1 and the
+ * remaining bits a counter.
+ */
+static inline int
+make_request (int prev_request, int set_idx)
+{
+  return (int) ((((unsigned int) prev_request >> 2) + 1u)
+                  << 2
+                | (unsigned int) (set_idx + 1));
+}
+
+/**
+ * Returns the set index stored in the given
+ * request.
+ */
+static inline int
+get_request_set (int request)
+{
+  return (request & 0x3) - 1;
+}
+
 static void
 init_common (SampleProcessor * self)
 {
   self->tracklist = tracklist_new (NULL, self);
   self->midi_events = midi_events_new ();
+  g_atomic_int_set (&self->request, 0);
+  g_atomic_int_set (&self->taken_request, 0);
+  g_cond_init (&self->request_cond);
+  g_mutex_init (&self->request_lock);
+  self->active_set = -1;
 
   if (!ZRYTHM_TESTING)
     {
@@ -282,37 +313,89 @@ sample_processor_process (
         }
     }
 
-  if (self->roll)
+  /* pick up new material */
+  const int request = g_atomic_int_get (&self->request);
+  bool      changed =
+    request != g_atomic_int_get (&self->taken_request);
+  if (changed)
     {
-      midi_events_clear (self->midi_events, F_NOT_QUEUED);
-      for (int i = self->tracklist->num_tracks - 1; i >= 1; i--)
+      /* the previous set is no longer read after
+       * this point */
+      self->active_set = get_request_set (request);
+      g_atomic_int_set (&self->taken_request, request);
+
+      /* signaling does not need the lock, the
+       * waiter re-checks on timeout */
+      g_cond_signal (&self->request_cond);
+    }
+  const int set_idx = self->active_set;
+  if (changed)
+    {
+      position_set_to_bar (&self->playhead, 1);
+      self->roll = set_idx >= 0;
+      if (set_idx >= 0)
         {
-          Track * track = self->tracklist->tracks[i];
-
-          float *audio_data_l = NULL, *audio_data_r = NULL;
+          position_set_to_pos (
+            &self->file_end_pos,
+            &self->audition_sets[set_idx].file_end_pos);
+        }
+    }
 
-          track_processor_clear_buffers (track->processor);
+  if ((self->roll && set_idx >= 0) || changed)
+    {
+      midi_events_clear (self->midi_events, F_NOT_QUEUED);
 
-          EngineProcessTimeInfo time_nfo = {
-            .g_start_frame =
-              (unsigned_frame_t) self->playhead.frames
-              + cycle_offset,
-            .local_offset = cycle_offset,
-            .nframes = nframes,
-          };
+      /* silence the instrument when the material
+       * changes */
+      if (changed)
+        midi_events_panic (self->midi_events, F_NOT_QUEUED);
+
+      EngineProcessTimeInfo time_nfo = {
+        .g_start_frame =
+          (unsigned_frame_t) self->playhead.frames
+          + cycle_offset,
+        .local_offset = cycle_offset,
+        .nframes = nframes,
+      };
+
+      bool has_midi = false;
+      if (self->roll && set_idx >= 0)
+        {
+          SampleProcessorAuditionSet * set =
+            &self->audition_sets[set_idx];
 
-          if (track->type == TRACK_TYPE_AUDIO)
+          if (set->stream)
+            {
+              audio_file_stream_mix (
+                set->stream, &l[cycle_offset],
+                &r[cycle_offset], nframes,
+                self->fader->amp->control);
+            }
+          else if (set->has_audio)
             {
+              Track * track = set->audio_track;
+              track_processor_clear_buffers (
+                track->processor);
               track_processor_process (
                 track->processor, &time_nfo);
-
-              audio_data_l =
-                track->processor->stereo_out->l->buf;
-              audio_data_r =
-                track->processor->stereo_out->l->buf;
+              dsp_mix2 (
+                &l[cycle_offset],
+                &track->processor->stereo_out->l
+                   ->buf[cycle_offset],
+                1.f, self->fader->amp->control, nframes);
+              dsp_mix2 (
+                &r[cycle_offset],
+                &track->processor->stereo_out->r
+                   ->buf[cycle_offset],
+                1.f, self->fader->amp->control, nframes);
             }
-          else if (track->type == TRACK_TYPE_MIDI)
+
+          has_midi = set->num_used_midi_tracks > 0;
+          for (int i = 0; i < set->num_used_midi_tracks; i++)
             {
+              Track * track = set->midi_tracks[i];
+              track_processor_clear_buffers (
+                track->processor);
               track_processor_process (
                 track->processor, &time_nfo);
               midi_events_append (
@@ -320,31 +403,26 @@ sample_processor_process (
                 track->processor->midi_out->midi_events,
                 cycle_offset, nframes, F_NOT_QUEUED);
             }
-          else if (track->type == TRACK_TYPE_INSTRUMENT)
-            {
-              Plugin * const ins = track->channel->instrument;
-              if (!ins)
-                return;
-
-              plugin_prepare_process (ins);
-              midi_events_append (
-                ins->midi_in_port->midi_events,
-                self->midi_events, cycle_offset, nframes,
-                F_NOT_QUEUED);
-              plugin_process (ins, &time_nfo);
-              audio_data_l = ins->l_out->buf;
-              audio_data_r = ins->r_out->buf;
-            }
+        }
 
-          if (audio_data_l && audio_data_r)
-            {
-              dsp_mix2 (
-                &l[cycle_offset], &audio_data_l[cycle_offset],
-                1.f, self->fader->amp->control, nframes);
-              dsp_mix2 (
-                &r[cycle_offset], &audio_data_r[cycle_offset],
-                1.f, self->fader->amp->control, nframes);
-            }
+      Plugin * const ins =
+        self->instrument_track
+          ? self->instrument_track->channel->instrument
+          : NULL;
+      if (ins && (has_midi || changed))
+        {
+          plugin_prepare_process (ins);
+          midi_events_append (
+            ins->midi_in_port->midi_events,
+            self->midi_events, cycle_offset, nframes,
+            F_NOT_QUEUED);
+          plugin_process (ins, &time_nfo);
+          dsp_mix2 (
+            &l[cycle_offset], &ins->l_out->buf[cycle_offset],
+            1.f, self->fader->amp->control, nframes);
+          dsp_mix2 (
+            &r[cycle_offset], &ins->r_out->buf[cycle_offset],
+            1.f, self->fader->amp->control, nframes);
         }
     }
 
@@ -469,22 +547,149 @@ sample_processor_queue_sample_from_file (
   /* TODO */
 }
 
+static Track *
+add_track (
+  SampleProcessor * self,
+  TrackType         type,
+  const char *      name,
+  bool              with_lane)
+{
+  Track * track = track_new (
+    type, self->tracklist->num_tracks, name, with_lane);
+  tracklist_insert_track (
+    self->tracklist, track, track->pos, F_NO_PUBLISH_EVENTS,
+    F_NO_RECALC_GRAPH);
+  return track;
+}
+
+/**
+ * Adds a MIDI track to the given set and routes it
+ * to the instrument track.
+ */
 static void
-queue_file_or_chord_preset (
-  SampleProcessor *     self,
-  const SupportedFile * file,
-  const ChordPreset *   chord_pset)
+add_midi_track (SampleProcessor * self, int set_idx)
 {
-  EngineState state;
-  engine_wait_for_pause (AUDIO_ENGINE, &state, false);
+  SampleProcessorAuditionSet * set =
+    &self->audition_sets[set_idx];
+  g_return_if_fail (
+    set->num_midi_tracks < SAMPLE_PROCESSOR_MAX_MIDI_TRACKS);
+
+  char name[600];
+  sprintf (
+    name, "Sample processor MIDI %d-%d", set_idx,
+    set->num_midi_tracks);
+  Track * track =
+    add_track (self, TRACK_TYPE_MIDI, name, F_WITH_LANE);
+  if (self->instrument_track)
+    {
+      group_target_track_add_child (
+        self->instrument_track, track_get_name_hash (track),
+        F_CONNECT, F_NO_RECALC_GRAPH, F_NO_PUBLISH_EVENTS);
+    }
+  set->midi_tracks[set->num_midi_tracks++] = track;
+}
+
+/**
+ * Creates the instrument track and instantiates
+ * the instrument.
+ */
+static void
+create_instrument_track (SampleProcessor * self)
+{
+  g_debug ("creating instrument track...");
+  Track * instrument_track = add_track (
+    self, TRACK_TYPE_INSTRUMENT,
+    "Sample processor instrument", F_WITH_LANE);
+  GError * err = NULL;
+  Plugin * pl = plugin_new_from_setting (
+    self->instrument_setting,
+    track_get_name_hash (instrument_track),
+    PLUGIN_SLOT_INSTRUMENT, -1, &err);
+  if (!pl)
+    {
+      HANDLE_ERROR (
+        err, _ ("Failed to create plugin %s"),
+        self->instrument_setting->descr->name);
+      return;
+    }
+  int ret = plugin_instantiate (pl, NULL, &err);
+  if (ret != 0)
+    {
+      HANDLE_ERROR (
+        err, _ ("Failed to instantiate plugin %s"),
+        self->instrument_setting->descr->name);
+      return;
+    }
+  g_return_if_fail (plugin_activate (pl, F_ACTIVATE) == 0);
+  g_return_if_fail (pl->midi_in_port);
+  g_return_if_fail (pl->l_out);
+  g_return_if_fail (pl->r_out);
+  channel_add_plugin (
+    instrument_track->channel, PLUGIN_SLOT_INSTRUMENT,
+    pl->id.slot, pl, F_NO_CONFIRM, F_NOT_MOVING_PLUGIN,
+    F_GEN_AUTOMATABLES, F_NO_RECALC_GRAPH,
+    F_NO_PUBLISH_EVENTS);
+
+  self->instrument_track = instrument_track;
+}
+
+/**
+ * Creates the auditioner tracks.
+ *
+ * @note The engine must be paused.
+ */
+static void
+build_audition_chain (SampleProcessor * self)
+{
+  g_message ("building audition chain...");
+
+  Track * track = add_track (
+    self, TRACK_TYPE_MASTER, "Sample Processor Master",
+    F_WITHOUT_LANE);
+  self->tracklist->master_track = track;
+
+  if (self->instrument_setting)
+    {
+      create_instrument_track (self);
+    }
+
+  for (int i = 0; i < 2; i++)
+    {
+      SampleProcessorAuditionSet * set =
+        &self->audition_sets[i];
+      char name[600];
+      sprintf (name, "Sample processor audio %d", i);
+      set->audio_track =
+        add_track (self, TRACK_TYPE_AUDIO, name, F_WITH_LANE);
+      add_midi_track (self, i);
+    }
+
+  self->audition_chain_built = true;
+}
+
+/**
+ * Removes all auditioner tracks.
+ *
+ * @note The engine must be paused.
+ */
+static void
+free_audition_chain (SampleProcessor * self)
+{
+  int request = make_request (
+    g_atomic_int_get (&self->request), -1);
+  g_atomic_int_set (&self->request, request);
+  g_atomic_int_set (&self->taken_request, request);
+  self->active_set = -1;
+  self->roll = false;
 
-  /* clear tracks */
   for (int i = self->tracklist->num_tracks - 1; i >= 0; i--)
     {
       Track * track = self->tracklist->tracks[i];
 
       /* remove state dir if instrument */
-      if (track->type == TRACK_TYPE_INSTRUMENT)
+      if (
+        track->type == TRACK_TYPE_INSTRUMENT
+        && track->channel->instrument)
         {
           char * state_dir = plugin_get_abs_state_dir (
             track->channel->instrument, F_NOT_BACKUP);
@@ -500,217 +705,339 @@ queue_file_or_chord_preset (
         F_NO_PUBLISH_EVENTS, F_NO_RECALC_GRAPH);
     }
 
-  Position start_pos;
-  position_set_to_bar (&start_pos, 1);
-  position_set_to_bar (&self->file_end_pos, 1);
+  self->instrument_track = NULL;
+  for (int i = 0; i < 2; i++)
+    {
+      object_free_w_func_and_null (
+        audio_file_stream_free,
+        self->audition_sets[i].stream);
+    }
+  memset (
+    self->audition_sets, 0, sizeof (self->audition_sets));
+  self->audition_chain_built = false;
+}
 
-  /* create master track */
-  g_debug ("creating master track...");
-  Track * track = track_new (
-    TRACK_TYPE_MASTER, self->tracklist->num_tracks,
-    "Sample Processor Master", F_WITHOUT_LANE);
-  self->tracklist->master_track = track;
-  tracklist_insert_track (
-    self->tracklist, track, track->pos, F_NO_PUBLISH_EVENTS,
-    F_NO_RECALC_GRAPH);
+/**
+ * Waits until the engine has taken the last
+ * request, so that the set not requested is no
+ * longer being read.
+ *
+ * Returns early if the engine is not processing.
+ */
+static void
+wait_for_request_taken (SampleProcessor * self)
+{
+  /* give the engine 2 cycles to take the request
+   * before checking whether it is processing */
+  gint64 timeout =
+    2 * (gint64) AUDIO_ENGINE->block_length
+      * G_USEC_PER_SEC
+      / MAX ((gint64) AUDIO_ENGINE->sample_rate, 1)
+    + 10 * G_TIME_SPAN_MILLISECOND;
+  uint_fast64_t last_cycle = AUDIO_ENGINE->cycle;
+
+  g_mutex_lock (&self->request_lock);
+  while (
+    g_atomic_int_get (&self->taken_request)
+    != g_atomic_int_get (&self->request))
+    {
+      if (g_cond_wait_until (
+            &self->request_cond, &self->request_lock,
+            g_get_monotonic_time () + timeout))
+        continue;
 
-  if (file && supported_file_type_is_audio (file->type))
+      /* requests are only taken while the engine is
+       * processing */
+      if (
+        AUDIO_ENGINE->cycle == last_cycle
+        && !g_atomic_int_get (&AUDIO_ENGINE->cycle_running))
+        {
+          break;
+        }
+      last_cycle = AUDIO_ENGINE->cycle;
+    }
+  g_mutex_unlock (&self->request_lock);
+}
+
+/**
+ * Fills the given set with the given material.
+ *
+ * @param mf The MIDI file read from @p file, if it
+ *   is a MIDI file.
+ */
+static void
+fill_audition_set (
+  SampleProcessor *            self,
+  SampleProcessorAuditionSet * set,
+  const SupportedFile *        file,
+  const ChordPreset *          chord_pset,
+  AudioFileStream *            stream,
+  const MidiFile *             mf,
+  int                          num_midi_tracks)
+{
+  /* clear previous material */
+  object_free_w_func_and_null (
+    audio_file_stream_free, set->stream);
+  track_clear (set->audio_track);
+  for (int i = 0; i < set->num_midi_tracks; i++)
     {
-      g_debug ("creating audio track...");
-      track = track_new (
-        TRACK_TYPE_AUDIO, self->tracklist->num_tracks,
-        "Sample processor audio", F_WITH_LANE);
-      tracklist_insert_track (
-        self->tracklist, track, track->pos,
-        F_NO_PUBLISH_EVENTS, F_NO_RECALC_GRAPH);
+      track_clear (set->midi_tracks[i]);
+    }
+  set->has_audio = false;
+  set->num_used_midi_tracks = 0;
 
+  Position start_pos;
+  position_set_to_bar (&start_pos, 1);
+  position_set_to_bar (&set->file_end_pos, 1);
+
+  if (stream)
+    {
+      set->stream = stream;
+      position_from_frames (
+        &set->file_end_pos,
+        (signed_frame_t) stream->num_out_frames);
+      return;
+    }
+  else if (file && supported_file_type_is_audio (file->type))
+    {
       /* create an audio region & add to
-       * track */
+       * track (decodes the whole file) */
       ZRegion * ar = audio_region_new (
         -1, file->abs_path, false, NULL, 0, NULL, 0, 0,
         &start_pos, 0, 0, 0);
       track_add_region (
-        track, ar, NULL, 0, F_GEN_NAME, F_NO_PUBLISH_EVENTS);
+        set->audio_track, ar, NULL, 0, F_GEN_NAME,
+        F_NO_PUBLISH_EVENTS);
 
       ArrangerObject * obj = (ArrangerObject *) ar;
-      position_set_to_pos (&self->file_end_pos, &obj->end_pos);
+      position_set_to_pos (&set->file_end_pos, &obj->end_pos);
+      set->has_audio = true;
+      return;
     }
-  else if (
-    ((file && supported_file_type_is_midi (file->type))
-     || chord_pset)
-    && self->instrument_setting)
-    {
-      /* create an instrument track */
-      g_debug ("creating instrument track...");
-      Track * instrument_track = track_new (
-        TRACK_TYPE_INSTRUMENT, self->tracklist->num_tracks,
-        "Sample processor instrument", F_WITH_LANE);
-      tracklist_insert_track (
-        self->tracklist, instrument_track,
-        instrument_track->pos, F_NO_PUBLISH_EVENTS,
-        F_NO_RECALC_GRAPH);
-      GError * err = NULL;
-      Plugin * pl = plugin_new_from_setting (
-        self->instrument_setting,
-        track_get_name_hash (instrument_track),
-        PLUGIN_SLOT_INSTRUMENT, -1, &err);
-      if (!pl)
-        {
-          HANDLE_ERROR (
-            err, _ ("Failed to create plugin %s"),
-            self->instrument_setting->descr->name);
-          return;
-        }
-      int ret = plugin_instantiate (pl, NULL, &err);
-      if (ret != 0)
-        {
-          HANDLE_ERROR (
-            err, _ ("Failed to instantiate plugin %s"),
-            self->instrument_setting->descr->name);
-          return;
-        }
-      g_return_if_fail (plugin_activate (pl, F_ACTIVATE) == 0);
-      g_return_if_fail (pl->midi_in_port);
-      g_return_if_fail (pl->l_out);
-      g_return_if_fail (pl->r_out);
-      channel_add_plugin (
-        instrument_track->channel, PLUGIN_SLOT_INSTRUMENT,
-        pl->id.slot, pl, F_NO_CONFIRM, F_NOT_MOVING_PLUGIN,
-        F_GEN_AUTOMATABLES, F_NO_RECALC_GRAPH,
-        F_NO_PUBLISH_EVENTS);
 
-      int num_tracks = 1;
-      if (file)
+  if (!self->instrument_track)
+    return;
+
+  for (int i = 0; i < num_midi_tracks; i++)
+    {
+      Track * track = set->midi_tracks[i];
+      ZRegion * mr = NULL;
+      if (mf)
         {
-          num_tracks =
-            midi_file_get_num_tracks (file->abs_path, true);
+          /* create a MIDI region from the MIDI
+           * file & add to track */
+          const MidiFileTrack * mf_track =
+            midi_file_get_nonempty_track (mf, i);
+          if (mf_track)
+            {
+              mr = midi_region_new_from_midi_file_track (
+                &start_pos, mf, mf_track,
+                track_get_name_hash (track), 0, 0);
+            }
+          if (!mr)
+            {
+              g_message (
+                "Failed to create MIDI region from "
+                "file %s",
+                file->abs_path);
+              continue;
+            }
         }
-      g_debug ("creating %d MIDI tracks...", num_tracks);
-      for (int i = 0; i < num_tracks; i++)
+      else if (chord_pset)
         {
-          char name[600];
-          sprintf (name, "Sample processor MIDI %d", i);
-          track = track_new (
-            TRACK_TYPE_MIDI, self->tracklist->num_tracks,
-            name, F_WITH_LANE);
-          tracklist_insert_track (
-            self->tracklist, track, track->pos,
-            F_NO_PUBLISH_EVENTS, F_NO_RECALC_GRAPH);
-
-          /* route track to instrument */
-          group_target_track_add_child (
-            instrument_track, track_get_name_hash (track),
-            F_CONNECT, F_NO_RECALC_GRAPH, F_NO_PUBLISH_EVENTS);
-
-          if (file)
+          /* create a MIDI region from the chord
+           * preset */
+          Position end_pos;
+          position_from_seconds (&end_pos, 13.0);
+          mr = midi_region_new (
+            &start_pos, &end_pos, track_get_name_hash (track),
+            0, 0);
+
+          /* add notes */
+          for (int j = 0; j < 12; j++)
             {
-              /* create a MIDI region from the MIDI
-               * file & add to track */
-              ZRegion * mr = midi_region_new_from_midi_file (
-                &start_pos, file->abs_path,
-                track_get_name_hash (track), 0, 0, i);
-              if (mr)
-                {
-                  track_add_region (
-                    track, mr, NULL, 0,
-                    /* name could already be generated
-                     * based
-                     * on the track name (if any) in
-                     * the MIDI file */
-                    mr->name ? F_NO_GEN_NAME : F_GEN_NAME,
-                    F_NO_PUBLISH_EVENTS);
-
-                  ArrangerObject * obj = (ArrangerObject *) mr;
-                  if (position_is_after (
-                        &obj->end_pos, &self->file_end_pos))
-                    {
-                      position_set_to_pos (
-                        &self->file_end_pos, &obj->end_pos);
-                    }
-                }
-              else
+              ChordDescriptor * descr =
+                chord_descriptor_clone (chord_pset->descr[j]);
+              chord_descriptor_update_notes (descr);
+              if (descr->type == CHORD_TYPE_NONE)
                 {
-                  g_message (
-                    "Failed to create MIDI region from "
-                    "file %s",
-                    file->abs_path);
+                  chord_descriptor_free (descr);
+                  continue;
                 }
-            }
-          else if (chord_pset)
-            {
-              /* create a MIDI region from the chord
-               * preset and add to track */
-              Position end_pos;
-              position_from_seconds (&end_pos, 13.0);
-              ZRegion * mr = midi_region_new (
-                &start_pos, &end_pos,
-                track_get_name_hash (track), 0, 0);
 
-              /* add notes */
-              for (int j = 0; j < 12; j++)
+              Position cur_pos;
+              position_from_seconds (&cur_pos, j * 1.0);
+              Position cur_end_pos;
+              position_from_seconds (
+                &cur_end_pos, j * 1.0 + 0.5);
+              for (int k = 0; k < CHORD_DESCRIPTOR_MAX_NOTES;
+                   k++)
                 {
-                  ChordDescriptor * descr =
-                    chord_descriptor_clone (
-                      chord_pset->descr[j]);
-                  chord_descriptor_update_notes (descr);
-                  if (descr->type == CHORD_TYPE_NONE)
+                  if (descr->notes[k])
                     {
-                      chord_descriptor_free (descr);
-                      continue;
+                      MidiNote * mn = midi_note_new (
+                        &mr->id, &cur_pos, &cur_end_pos,
+                        k + 36, VELOCITY_DEFAULT);
+                      midi_region_add_midi_note (
+                        mr, mn, F_NO_PUBLISH_EVENTS);
                     }
+                } /* endforeach notes in chord */
+              chord_descriptor_free (descr);
 
-                  Position cur_pos;
-                  position_from_seconds (&cur_pos, j * 1.0);
-                  Position cur_end_pos;
-                  position_from_seconds (
-                    &cur_end_pos, j * 1.0 + 0.5);
-                  for (int k = 0;
-                       k < CHORD_DESCRIPTOR_MAX_NOTES; k++)
-                    {
-                      if (descr->notes[k])
-                        {
-                          MidiNote * mn = midi_note_new (
-                            &mr->id, &cur_pos, &cur_end_pos,
-                            k + 36, VELOCITY_DEFAULT);
-                          midi_region_add_midi_note (
-                            mr, mn, F_NO_PUBLISH_EVENTS);
-                        }
-                    } /* endforeach notes in chord */
-                  chord_descriptor_free (descr);
+            } /* endforeach chord descriptor */
+        }
+      g_return_if_fail (mr);
 
-                } /* endforeach chord descriptor */
+      track_add_region (
+        track, mr, NULL, 0,
+        /* name could already be generated based on
+         * the track name (if any) in the MIDI file */
+        mr->name ? F_NO_GEN_NAME : F_GEN_NAME,
+        F_NO_PUBLISH_EVENTS);
 
-              ArrangerObject * obj = (ArrangerObject *) mr;
-              if (position_is_after (
-                    &obj->end_pos, &self->file_end_pos))
-                {
-                  position_set_to_pos (
-                    &self->file_end_pos, &obj->end_pos);
-                }
+      ArrangerObject * obj = (ArrangerObject *) mr;
+      if (position_is_after (
+            &obj->end_pos, &set->file_end_pos))
+        {
+          position_set_to_pos (
+            &set->file_end_pos, &obj->end_pos);
+        }
+    }
+  set->num_used_midi_tracks = num_midi_tracks;
+}
 
-              track_add_region (
-                track, mr, NULL, 0,
-                mr->name ? F_NO_GEN_NAME : F_GEN_NAME,
-                F_NO_PUBLISH_EVENTS);
+/**
+ * Fills the set that is not being played with the
+ * given material and hands it over to the engine.
+ *
+ * The engine is only paused if auditioner tracks
+ * need to be created or the audio pool needs to
+ * grow.
+ */
+static void
+queue_file_or_chord_preset (
+  SampleProcessor *     self,
+  const SupportedFile * file,
+  const ChordPreset *   chord_pset)
+{
+  const bool is_audio =
+    file && supported_file_type_is_audio (file->type);
+  const bool is_midi =
+    (file && supported_file_type_is_midi (file->type))
+    || chord_pset;
+
+  /* read the MIDI file once for all the tracks */
+  MidiFile * mf = NULL;
+  int        num_midi_tracks = 0;
+  if (is_midi && file)
+    {
+      GError * err = NULL;
+      mf = midi_file_new (file->abs_path, &err);
+      if (!mf)
+        {
+          g_message (
+            "cannot audition MIDI file: %s", err->message);
+          g_error_free (err);
+          return;
+        }
+    }
+  if (is_midi)
+    {
+      num_midi_tracks =
+        mf ? midi_file_get_num_nonempty_tracks (mf) : 1;
+      if (num_midi_tracks > SAMPLE_PROCESSOR_MAX_MIDI_TRACKS)
+        {
+          g_message (
+            "only auditioning the first %d MIDI tracks",
+            SAMPLE_PROCESSOR_MAX_MIDI_TRACKS);
+          num_midi_tracks = SAMPLE_PROCESSOR_MAX_MIDI_TRACKS;
+        }
+    }
 
-            } /* endif chord preset */
+  /* stream audio files from disk if possible */
+  AudioFileStream * stream = NULL;
+  if (is_audio)
+    {
+      GError * err = NULL;
+      stream = audio_file_stream_new (
+        file->abs_path, AUDIO_ENGINE->sample_rate, &err);
+      if (!stream)
+        {
+          g_message (
+            "cannot stream file, decoding it instead: %s",
+            err->message);
+          g_error_free (err);
+        }
+    }
 
-        } /* endforeach track */
+  const int set_idx =
+    get_request_set (g_atomic_int_get (&self->request))
+        == 0
+      ? 1
+      : 0;
+  SampleProcessorAuditionSet * set =
+    &self->audition_sets[set_idx];
+
+  /* adding tracks or growing the pool can't be done
+   * while the engine is running */
+  bool need_tracks =
+    !self->audition_chain_built
+    || (self->instrument_track
+        && set->num_midi_tracks < num_midi_tracks);
+  bool need_pause =
+    need_tracks
+    || (is_audio && !stream
+        && (size_t) AUDIO_POOL->num_clips
+             >= AUDIO_POOL->clips_size);
+
+  EngineState state;
+  if (need_pause)
+    {
+      engine_wait_for_pause (AUDIO_ENGINE, &state, false);
+
+      if (!self->audition_chain_built)
+        {
+          build_audition_chain (self);
+        }
+      while (
+        self->instrument_track
+        && set->num_midi_tracks < num_midi_tracks)
+        {
+          add_midi_track (self, set_idx);
+        }
+    }
+  else
+    {
+      /* make sure the engine is done with the set
+       * from a previous audition */
+      wait_for_request_taken (self);
     }
 
-  self->roll = true;
-  position_set_to_bar (&self->playhead, 1);
+  fill_audition_set (
+    self, set, file, chord_pset, stream, mf,
+    num_midi_tracks);
+  object_free_w_func_and_null (midi_file_free, mf);
 
   /* add some room to end pos */
   char file_end_pos_str[600];
   position_to_string_full (
-    &self->file_end_pos, file_end_pos_str, 2);
+    &set->file_end_pos, file_end_pos_str, 2);
   g_message ("playing until %s", file_end_pos_str);
-  position_add_bars (&self->file_end_pos, 1);
+  position_add_bars (&set->file_end_pos, 1);
 
-  router_recalc_graph (ROUTER, F_NOT_SOFT);
+  /* hand over to the engine */
+  g_atomic_int_set (
+    &self->request,
+    make_request (
+      g_atomic_int_get (&self->request), set_idx));
 
-  engine_resume (AUDIO_ENGINE, &state);
+  if (need_pause)
+    {
+      if (need_tracks)
+        router_recalc_graph (ROUTER, F_NOT_SOFT);
+
+      engine_resume (AUDIO_ENGINE, &state);
+    }
 }
 
 /**
@@ -741,12 +1068,51 @@ sample_processor_queue_chord_preset (
 void
 sample_processor_stop_file_playback (SampleProcessor * self)
 {
+  g_atomic_int_set (
+    &self->request,
+    make_request (g_atomic_int_get (&self->request), -1));
+}
+
+/**
+ * Returns the index of the set last requested to
+ * play, or -1 if stopped.
+ */
+int
+sample_processor_get_requested_set (SampleProcessor * self)
+{
+  return get_request_set (g_atomic_int_get (&self->request));
+}
+
+/**
+ * Creates the auditioner tracks and instantiates
+ * the instrument, if not already done.
+ */
+void
+sample_processor_prewarm (SampleProcessor * self)
+{
+  if (self->audition_chain_built)
+    return;
+
   EngineState state;
   engine_wait_for_pause (AUDIO_ENGINE, &state, false);
+  build_audition_chain (self);
+  router_recalc_graph (ROUTER, F_NOT_SOFT);
+  engine_resume (AUDIO_ENGINE, &state);
+}
 
-  self->roll = false;
-  position_set_to_bar (&self->playhead, 1);
-
+/**
+ * Frees the auditioner tracks and creates them
+ * again.
+ */
+void
+sample_processor_rebuild_audition_chain (
+  SampleProcessor * self)
+{
+  EngineState state;
+  engine_wait_for_pause (AUDIO_ENGINE, &state, false);
+  free_audition_chain (self);
+  build_audition_chain (self);
+  router_recalc_graph (ROUTER, F_NOT_SOFT);
   engine_resume (AUDIO_ENGINE, &state);
 }
 
@@ -773,11 +1139,19 @@ sample_processor_free (SampleProcessor * self)
   if (self == SAMPLE_PROCESSOR)
     sample_processor_disconnect (self);
 
+  for (int i = 0; i < 2; i++)
+    {
+      object_free_w_func_and_null (
+        audio_file_stream_free,
+        self->audition_sets[i].stream);
+    }
   object_free_w_func_and_null (
     tracklist_free, self->tracklist);
   object_free_w_func_and_null (fader_free, self->fader);
   object_free_w_func_and_null (
     midi_events_free, self->midi_events);
+  g_cond_clear (&self->request_cond);
+  g_mutex_clear (&self->request_lock);
 
   object_zero_and_free (self);
 }
@@ -255,18 +255,37 @@ supported_file_should_autoplay (const SupportedFile * self)
 char *
 supported_file_get_info_text_for_label (
   const SupportedFile * self)
+{
+  return supported_file_get_info_text_for_label_w_info (
+    self, NULL);
+}
+
+/**
+ * Returns a pango markup to be used in GTK labels.
+ *
+ * @param nfo Audio info to show for audio files, or
+ *   NULL to read it from the file.
+ */
+char *
+supported_file_get_info_text_for_label_w_info (
+  const SupportedFile * self,
+  const AudecInfo *     nfo)
 {
   char * file_type_label =
     supported_file_type_get_description (self->type);
   char * label = NULL;
   if (supported_file_type_is_audio (self->type))
     {
-      AudioEncoder * enc =
-        audio_encoder_new_from_file (self->abs_path);
-      if (!enc)
+      AudioEncoder * enc = NULL;
+      if (!nfo)
         {
-          g_free (file_type_label);
-          return g_strdup (_ ("Failed opening file"));
+          enc = audio_encoder_new_from_file (self->abs_path);
+          if (!enc)
+            {
+              g_free (file_type_label);
+              return g_strdup (_ ("Failed opening file"));
+            }
+          nfo = &enc->nfo;
         }
 
       label = g_markup_printf_escaped (
@@ -277,12 +296,11 @@ supported_file_get_info_text_for_label (
           "%" PRId64 " ms | BPM: %.1f\n"
           "Channel(s): %u | Bitrate: %'d.%d kb/s\n"
           "Bit depth: %d bits"),
-        self->label, enc->nfo.sample_rate,
-        enc->nfo.length / 1000, enc->nfo.length % 1000,
-        (double) enc->nfo.bpm, enc->nfo.channels,
-        enc->nfo.bit_rate / 1000,
-        (enc->nfo.bit_rate % 1000) / 100, enc->nfo.bit_depth);
-      audio_encoder_free (enc);
+        self->label, nfo->sample_rate, nfo->length / 1000,
+        nfo->length % 1000, (double) nfo->bpm, nfo->channels,
+        nfo->bit_rate / 1000, (nfo->bit_rate % 1000) / 100,
+        nfo->bit_depth);
+      object_free_w_func_and_null (audio_encoder_free, enc);
     }
   else
     label = g_markup_printf_escaped (
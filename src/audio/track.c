@@ -1812,6 +1812,7 @@ track_insert_region (
     }
 
   g_return_if_fail (region->name);
+  arranger_object_positions_changed ();
   g_message (
     "inserting region '%s' to track '%s' "
     "at lane %d (idx %d)",
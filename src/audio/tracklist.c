@@ -1232,6 +1232,7 @@ tracklist_handle_file_drop (
 {
   GPtrArray * file_arr = g_ptr_array_new_with_free_func (
     (GDestroyNotify) supported_file_free);
+  MidiFile * mf = NULL;
   if (orig_file)
     {
       SupportedFile * file = supported_file_clone (orig_file);
@@ -1278,6 +1279,7 @@ tracklist_handle_file_drop (
   for (size_t i = 0; i < file_arr->len; i++)
     {
       SupportedFile * file = g_ptr_array_index (file_arr, i);
+      object_free_w_func_and_null (midi_file_free, mf);
 
       TrackType track_type = 0;
       if (
@@ -1306,8 +1308,18 @@ tracklist_handle_file_drop (
       int num_nonempty_midi_tracks = 0;
       if (track_type == TRACK_TYPE_MIDI)
         {
+          /* read the file once for both the track
+           * count and the region */
+          GError * err = NULL;
+          mf = midi_file_new (file->abs_path, &err);
+          if (!mf)
+            {
+              HANDLE_ERROR (
+                err, "%s", _ ("Failed to read MIDI file"));
+              goto free_file_array_and_return;
+            }
           num_nonempty_midi_tracks =
-            midi_file_get_num_tracks (file->abs_path, true);
+            midi_file_get_num_nonempty_tracks (mf);
           if (num_nonempty_midi_tracks == 0)
             {
               if (ZRYTHM_HAVE_UI)
@@ -1395,10 +1407,12 @@ tracklist_handle_file_drop (
                     lane_pos, idx_in_lane);
                   break;
                 case TRACK_TYPE_MIDI:
-                  region = midi_region_new_from_midi_file (
-                    pos, file->abs_path,
-                    track_get_name_hash (track), lane_pos,
-                    idx_in_lane, 0);
+                  region =
+                    midi_region_new_from_midi_file_track (
+                      pos, mf,
+                      midi_file_get_nonempty_track (mf, 0),
+                      track_get_name_hash (track), lane_pos,
+                      idx_in_lane);
                   break;
                 default:
                   break;
@@ -1459,6 +1473,7 @@ tracklist_handle_file_drop (
     } /* foreach file */
 
 free_file_array_and_return:
+  object_free_w_func_and_null (midi_file_free, mf);
   g_ptr_array_unref (file_arr);
 
   return;
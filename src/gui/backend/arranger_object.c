@@ -70,9 +70,30 @@
       func (CHORD_OBJECT, ChordObject, chord_object) func ( \
         AUTOMATION_POINT, AutomationPoint, automation_point)
 
+/**
+ * Incremented when objects are created, freed,
+ * added to the project or moved.
+ */
+static volatile gint positions_generation = 0;
+
+void
+arranger_object_positions_changed (void)
+{
+  g_atomic_int_inc (&positions_generation);
+}
+
+unsigned int
+arranger_object_get_positions_generation (void)
+{
+  return (unsigned int) g_atomic_int_get (
+    &positions_generation);
+}
+
 void
 arranger_object_init (ArrangerObject * self)
 {
+  arranger_object_positions_changed ();
+
   self->schema_version = ARRANGER_OBJECT_SCHEMA_VERSION;
   self->magic = ARRANGER_OBJECT_MAGIC;
 
@@ -311,6 +332,7 @@ arranger_object_set_to_object (
   g_return_if_fail (src && dest);
 
   /* reset positions */
+  arranger_object_positions_changed ();
   dest->pos = src->pos;
   if (arranger_object_type_has_length (src->type))
     {
@@ -691,6 +713,7 @@ arranger_object_set_position (
   pos_ptr = get_position_ptr (self, pos_type);
   g_return_if_fail (pos_ptr);
   position_set_to_pos (pos_ptr, pos);
+  arranger_object_positions_changed ();
 }
 
 /**
@@ -3687,6 +3710,11 @@ free_region (ZRegion * self)
       object_free_w_func_and_null (
         g_object_unref, self->layout);
     }
+  for (int i = 0; i < 2; i++)
+    {
+      object_free_w_func_and_null (
+        gsk_render_node_unref, self->content_nodes[i]);
+    }
 
 #undef FREE_R
 
@@ -3713,6 +3741,8 @@ arranger_object_free (ArrangerObject * self)
 {
   g_return_if_fail (IS_ARRANGER_OBJECT (self));
 
+  arranger_object_positions_changed ();
+
   switch (self->type)
     {
     case TYPE (REGION):
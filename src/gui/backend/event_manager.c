@@ -78,6 +78,7 @@
 #include "gui/widgets/tracklist_header.h"
 #include "gui/widgets/transport_controls.h"
 #include "gui/widgets/visibility.h"
+#include "plugins/plugin.h"
 #include "plugins/plugin_gtk.h"
 #include "project.h"
 #include "settings/settings.h"
@@ -597,7 +598,142 @@ on_plugin_visibility_changed (Plugin * pl)
 /*return FALSE;*/
 /*}*/
 
-static inline void
+/**
+ * Packs the type and argument of an event into a
+ * word, or returns 0 if they don't fit.
+ */
+static inline gsize
+pack_pending_event (EventType type, void * arg)
+{
+#if GLIB_SIZEOF_VOID_P == 8
+  /* pointers and integer args use at most the
+   * lower 48 bits */
+  guint64 arg_bits = (guint64) (guintptr) arg;
+  if (arg_bits >> 48 || type >= 0xFFFF)
+    return 0;
+
+  return (gsize) (((guint64) type + 1) << 48 | arg_bits);
+#else
+  return 0;
+#endif
+}
+
+/**
+ * Returns the first slot to probe for the given
+ * packed event.
+ */
+static inline gsize
+get_pending_event_start_idx (gsize key)
+{
+  /* mix the bits so that nearby pointers spread */
+  guint64 hash = (guint64) key * 0x9E3779B97F4A7C15ull;
+  return (gsize) (hash >> 32);
+}
+
+bool
+event_manager_mark_pending (
+  EventManager * self,
+  EventType      type,
+  void *         arg)
+{
+  gsize key = pack_pending_event (type, arg);
+  if (key == 0)
+    return true;
+
+  gsize idx = get_pending_event_start_idx (key);
+  for (int i = 0; i < EVENT_MANAGER_PENDING_MAX_PROBES; i++)
+    {
+      gsize * slot =
+        &self->pending_events
+           [(idx + (gsize) i)
+            & (EVENT_MANAGER_PENDING_SIZE - 1)];
+      gsize cur = (gsize) g_atomic_pointer_get (slot);
+      if (
+        cur == 0
+        && g_atomic_pointer_compare_and_exchange (
+          slot, (gsize) 0, key))
+        {
+          return true;
+        }
+
+      /* re-read in case another thread just took
+       * the slot */
+      cur = (gsize) g_atomic_pointer_get (slot);
+      if (cur == key)
+        return false;
+    }
+
+  /* too crowded, push without coalescing */
+  return true;
+}
+
+void
+event_manager_unmark_pending (
+  EventManager * self,
+  EventType      type,
+  void *         arg)
+{
+  gsize key = pack_pending_event (type, arg);
+  if (key == 0)
+    return;
+
+  gsize idx = get_pending_event_start_idx (key);
+  for (int i = 0; i < EVENT_MANAGER_PENDING_MAX_PROBES; i++)
+    {
+      gsize * slot =
+        &self->pending_events
+           [(idx + (gsize) i)
+            & (EVENT_MANAGER_PENDING_SIZE - 1)];
+      if (g_atomic_pointer_compare_and_exchange (
+            slot, key, (gsize) 0))
+        return;
+    }
+}
+
+/**
+ * Clears the pending events table.
+ *
+ * Must be called after dequeuing events and before
+ * processing them, so that any change made while
+ * an identical event was considered queued is seen
+ * when processing it.
+ */
+static void
+clear_pending_events (EventManager * self)
+{
+  for (size_t i = 0; i < EVENT_MANAGER_PENDING_SIZE; i++)
+    {
+      if (g_atomic_pointer_get (&self->pending_events[i]))
+        {
+          g_atomic_pointer_set (
+            &self->pending_events[i], (gsize) 0);
+        }
+    }
+}
+
+static guint
+event_hash (gconstpointer data)
+{
+  const ZEvent * ev = (const ZEvent *) data;
+  return g_direct_hash (ev->arg) ^ (guint) ev->type;
+}
+
+static gboolean
+event_equal (gconstpointer a, gconstpointer b)
+{
+  const ZEvent * ev_a = (const ZEvent *) a;
+  const ZEvent * ev_b = (const ZEvent *) b;
+  return ev_a->type == ev_b->type && ev_a->arg == ev_b->arg;
+}
+
+/**
+ * Dequeues all events into the events array,
+ * skipping duplicates.
+ *
+ * Events pushed while the queue is being drained
+ * may still be duplicates of these.
+ */
+static void
 clean_duplicates_and_copy (
   EventManager * self,
   GPtrArray *    events_arr)
@@ -606,45 +742,72 @@ clean_duplicates_and_copy (
   ZEvent *    event;
 
   g_ptr_array_remove_range (events_arr, 0, events_arr->len);
+  g_hash_table_remove_all (self->events_set);
 
   /* only add events once to new array while
    * popping */
   while (event_queue_dequeue_event (q, &event))
     {
-      bool already_exists = false;
-
-      for (guint i = 0; i < events_arr->len; i++)
-        {
-          ZEvent * cur_event =
-            (ZEvent *) g_ptr_array_index (events_arr, i);
-          if (
-            event->type == cur_event->type
-            && event->arg == cur_event->arg)
-            already_exists = true;
-        }
-
-      if (already_exists)
+      /* g_hash_table_add() would replace the stored
+       * key, so check first to keep the event that
+       * stays in the array */
+      if (g_hash_table_contains (self->events_set, event))
         {
           object_pool_return (self->obj_pool, event);
         }
       else
         {
+          g_hash_table_add (self->events_set, event);
           g_ptr_array_add (events_arr, event);
         }
     }
+
+  clear_pending_events (self);
 }
 
+/**
+ * Updates the graph latencies of the plugins whose
+ * latency changed, once no latency changed for a
+ * while and the transport is paused.
+ *
+ * This way a plugin that keeps changing its latency
+ * (e.g., while one of its parameters is moved)
+ * causes a single update.
+ */
 static int
-soft_recalc_graph_when_paused (void * data)
+update_plugin_latencies_when_settled (void * data)
 {
   EventManager * self = (EventManager *) data;
-  if (TRANSPORT->play_state == PLAYSTATE_PAUSED)
+  if (
+    TRANSPORT->play_state != PLAYSTATE_PAUSED
+    || g_get_monotonic_time () - self->last_latency_change
+         < EVENT_MANAGER_LATENCY_DEBOUNCE_MS * 1000)
     {
-      router_recalc_graph (ROUTER, F_SOFT);
-      self->pending_soft_recalc = false;
-      return G_SOURCE_REMOVE;
+      return G_SOURCE_CONTINUE;
     }
-  return G_SOURCE_CONTINUE;
+
+  GPtrArray * plugins = g_ptr_array_new ();
+  GPtrArray * changed_plugins = g_ptr_array_new ();
+  plugin_get_all (PROJECT, plugins, false);
+  for (size_t i = 0; i < plugins->len; i++)
+    {
+      Plugin * pl = g_ptr_array_index (plugins, i);
+      if (g_atomic_int_compare_and_exchange (
+            &pl->latency_changed, 1, 0))
+        {
+          g_ptr_array_add (changed_plugins, pl);
+        }
+    }
+  if (changed_plugins->len > 0)
+    {
+      router_update_plugin_latencies (
+        ROUTER, changed_plugins);
+    }
+  g_ptr_array_unref (plugins);
+  g_ptr_array_unref (changed_plugins);
+
+  self->latency_update_source_id = 0;
+  return G_SOURCE_REMOVE;
 }
 
 /**
@@ -659,10 +822,12 @@ event_manager_process_event (EventManager * self, ZEvent * ev)
   switch (ev->type)
     {
     case ET_PLUGIN_LATENCY_CHANGED:
-      if (!self->pending_soft_recalc)
+      self->last_latency_change = g_get_monotonic_time ();
+      if (!self->latency_update_source_id)
         {
-          self->pending_soft_recalc = true;
-          g_idle_add (soft_recalc_graph_when_paused, self);
+          self->latency_update_source_id = g_timeout_add (
+            EVENT_MANAGER_LATENCY_DEBOUNCE_MS,
+            update_plugin_latencies_when_settled, self);
         }
       break;
     case ET_TRACKS_REMOVED:
@@ -1419,6 +1584,10 @@ event_manager_new (void)
     (size_t) EVENT_MANAGER_MAX_EVENTS * sizeof (ZEvent *));
 
   self->events_arr = g_ptr_array_sized_new (200);
+  self->events_set =
+    g_hash_table_new (event_hash, event_equal);
+  self->pending_events =
+    object_new_n (EVENT_MANAGER_PENDING_SIZE, gsize);
 
   return self;
 }
@@ -1434,6 +1603,11 @@ event_manager_stop_events (EventManager * self)
       /* remove the source func */
       g_source_remove_and_zero (self->process_source_id);
     }
+  if (self->latency_update_source_id)
+    {
+      g_source_remove_and_zero (
+        self->latency_update_source_id);
+    }
 
   /* process any remaining events - clear the
    * queue. */
@@ -1504,6 +1678,9 @@ event_manager_free (EventManager * self)
   object_free_w_func_and_null (mpmc_queue_free, self->mqueue);
   object_free_w_func_and_null (
     g_ptr_array_unref, self->events_arr);
+  object_free_w_func_and_null (
+    g_hash_table_unref, self->events_set);
+  object_zero_and_free (self->pending_events);
 
   object_zero_and_free (self);
 
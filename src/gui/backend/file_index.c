@@ -0,0 +1,1076 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <string.h>
+
+#include "gui/backend/file_index.h"
+#include "utils/file.h"
+#include "utils/objects.h"
+#include "utils/string.h"
+
+#include <audec/audec.h>
+
+/** File attributes read when listing directories. */
+#define LIST_ATTRIBUTES \
+  G_FILE_ATTRIBUTE_STANDARD_NAME \
+  "," G_FILE_ATTRIBUTE_STANDARD_TYPE \
+  "," G_FILE_ATTRIBUTE_STANDARD_IS_HIDDEN \
+  "," G_FILE_ATTRIBUTE_STANDARD_SIZE \
+  "," G_FILE_ATTRIBUTE_TIME_MODIFIED \
+  "," G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC \
+  "," G_FILE_ATTRIBUTE_ID_FILE
+
+typedef enum FileIndexJobType
+{
+  /** Load the index file. */
+  FILE_INDEX_JOB_LOAD,
+
+  /** List a directory and probe its files. */
+  FILE_INDEX_JOB_INDEX_DIR,
+
+  /** Save the index and stop the thread. */
+  FILE_INDEX_JOB_STOP,
+} FileIndexJobType;
+
+typedef struct FileIndexJob
+{
+  FileIndexJobType type;
+
+  char * dir;
+
+  /** Whether to also index the subdirectories. */
+  bool recursive;
+
+  /**
+   * Whether to skip listed subdirectories whose
+   * modification time did not change.
+   *
+   * Used when re-indexing directories that are
+   * already watched for changes.
+   */
+  bool skip_unchanged_subdirs;
+} FileIndexJob;
+
+static void
+file_index_job_free (FileIndexJob * self)
+{
+  g_free_and_null (self->dir);
+  object_zero_and_free (self);
+}
+
+static void
+file_index_dir_free (FileIndexDir * self)
+{
+  g_ptr_array_unref (self->children);
+  object_zero_and_free (self);
+}
+
+/**
+ * Sets the fields that are not serialized.
+ */
+static void
+init_entry_runtime_fields (FileIndexEntry * self)
+{
+  self->label = g_path_get_basename (self->abs_path);
+  self->search_key = g_strdup (self->label);
+  string_to_upper (self->label, self->search_key);
+}
+
+static int
+cmp_entries (const void * _a, const void * _b)
+{
+  const FileIndexEntry * a =
+    *(const FileIndexEntry * const *) _a;
+  const FileIndexEntry * b =
+    *(const FileIndexEntry * const *) _b;
+  int r = strcasecmp (a->label, b->label);
+  if (r)
+    return r;
+
+  /* if equal ignoring case, put lower before
+   * upper */
+  return -strcmp (a->label, b->label);
+}
+
+/**
+ * Queues a job.
+ *
+ * Directories that are already queued are skipped.
+ */
+static void
+queue_job (
+  FileIndex *      self,
+  FileIndexJobType type,
+  const char *     dir,
+  bool             recursive,
+  bool             skip_unchanged_subdirs,
+  bool             front)
+{
+  g_mutex_lock (&self->lock);
+  if (dir && g_hash_table_contains (self->queued_dirs, dir))
+    {
+      g_mutex_unlock (&self->lock);
+      return;
+    }
+
+  FileIndexJob * job = object_new (FileIndexJob);
+  job->type = type;
+  job->dir = g_strdup (dir);
+  job->recursive = recursive;
+  job->skip_unchanged_subdirs = skip_unchanged_subdirs;
+  if (dir)
+    {
+      g_hash_table_add (self->queued_dirs, g_strdup (dir));
+    }
+  self->num_pending_jobs++;
+  g_mutex_unlock (&self->lock);
+
+  if (front)
+    g_async_queue_push_front (self->queue, job);
+  else
+    g_async_queue_push (self->queue, job);
+}
+
+/**
+ * Reads the audio info of the entry's file.
+ */
+static void
+probe_audio_info (FileIndexEntry * self)
+{
+  AudecInfo     nfo;
+  AudecHandle * handle = audec_open (self->abs_path, &nfo);
+  if (!handle)
+    {
+      g_debug ("failed to open %s", self->abs_path);
+      return;
+    }
+
+  self->samplerate = (int) nfo.sample_rate;
+  self->channels = (int) nfo.channels;
+  self->length = (int64_t) nfo.length;
+  self->bpm = nfo.bpm;
+  self->bit_rate = (int) nfo.bit_rate;
+  self->bit_depth = (int) nfo.bit_depth;
+  self->have_info = 1;
+  audec_close (handle);
+}
+
+/**
+ * Removes the entry for the given path and, if it
+ * is a listed directory, everything under it.
+ *
+ * Must be called with the lock held.
+ */
+static void
+remove_path (FileIndex * self, const char * path)
+{
+  FileIndexDir * dir = (FileIndexDir *) g_hash_table_lookup (
+    self->dirs_ht, path);
+  if (dir)
+    {
+      GPtrArray * children = g_ptr_array_ref (dir->children);
+      for (guint i = 0; i < children->len; i++)
+        {
+          FileIndexEntry * child = (FileIndexEntry *)
+            g_ptr_array_index (children, i);
+          remove_path (self, child->abs_path);
+        }
+      g_ptr_array_unref (children);
+      g_hash_table_remove (self->dirs_ht, path);
+    }
+  g_hash_table_remove (self->entries_ht, path);
+  self->dirty = true;
+}
+
+static void
+on_dir_changed (
+  GFileMonitor *    monitor,
+  GFile *           file,
+  GFile *           other_file,
+  GFileMonitorEvent event_type,
+  FileIndex *       self)
+{
+  switch (event_type)
+    {
+    case G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT:
+    case G_FILE_MONITOR_EVENT_DELETED:
+    case G_FILE_MONITOR_EVENT_CREATED:
+    case G_FILE_MONITOR_EVENT_RENAMED:
+    case G_FILE_MONITOR_EVENT_MOVED_IN:
+    case G_FILE_MONITOR_EVENT_MOVED_OUT:
+      break;
+    default:
+      return;
+    }
+
+  GFile * parent = g_file_get_parent (file);
+  if (!parent)
+    return;
+
+  char * dir = g_file_get_path (parent);
+  if (dir && g_hash_table_contains (self->monitors, dir))
+    {
+      file_index_index_dir (self, dir);
+    }
+  g_free (dir);
+  g_object_unref (parent);
+}
+
+/**
+ * Watches the directories added by the indexing
+ * thread.
+ */
+static gboolean
+watch_dirs_cb (gpointer user_data)
+{
+  FileIndex * self = (FileIndex *) user_data;
+
+  g_mutex_lock (&self->lock);
+  GPtrArray * dirs = self->dirs_to_watch;
+  self->dirs_to_watch =
+    g_ptr_array_new_with_free_func (g_free);
+  self->watch_source_id = 0;
+  g_mutex_unlock (&self->lock);
+
+  for (guint i = 0; i < dirs->len; i++)
+    {
+      const char * dir =
+        (const char *) g_ptr_array_index (dirs, i);
+      if (
+        g_hash_table_size (self->monitors)
+        >= FILE_INDEX_MAX_MONITORS)
+        break;
+      if (g_hash_table_contains (self->monitors, dir))
+        continue;
+
+      GError *       err = NULL;
+      GFile *        file = g_file_new_for_path (dir);
+      GFileMonitor * monitor = g_file_monitor_directory (
+        file, G_FILE_MONITOR_WATCH_MOVES, NULL, &err);
+      g_object_unref (file);
+      if (!monitor)
+        {
+          g_debug (
+            "failed to watch %s: %s", dir, err->message);
+          g_error_free (err);
+          continue;
+        }
+      g_signal_connect (
+        monitor, "changed", G_CALLBACK (on_dir_changed),
+        self);
+      g_hash_table_insert (
+        self->monitors, g_strdup (dir), monitor);
+    }
+  g_ptr_array_unref (dirs);
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * Queues watching the given directory.
+ *
+ * Must be called with the lock held.
+ */
+static void
+watch_dir (FileIndex * self, const char * dir)
+{
+  if (
+    !self->path
+    || self->dirs_to_watch->len >= FILE_INDEX_MAX_MONITORS)
+    return;
+
+  g_ptr_array_add (self->dirs_to_watch, g_strdup (dir));
+  if (!self->watch_source_id)
+    {
+      self->watch_source_id =
+        g_idle_add (watch_dirs_cb, self);
+    }
+}
+
+/**
+ * Returns whether the directory with the given file
+ * ID should be descended into from @p path, and
+ * records it if so.
+ *
+ * A directory reached again through another path
+ * (e.g., a symlink to one of its ancestors) is only
+ * descended into from the path it was first reached
+ * from, as long as that path is still indexed.
+ */
+static bool
+claim_dir_for_recursion (
+  FileIndex *  self,
+  const char * id,
+  const char * path)
+{
+  if (!id)
+    return true;
+
+  const char * prev_path = (const char *)
+    g_hash_table_lookup (self->recursed_dir_ids, id);
+  if (prev_path && !string_is_equal (prev_path, path))
+    {
+      g_mutex_lock (&self->lock);
+      bool prev_indexed =
+        g_hash_table_contains (self->dirs_ht, prev_path)
+        || g_hash_table_contains (
+          self->queued_dirs, prev_path);
+      g_mutex_unlock (&self->lock);
+      if (prev_indexed)
+        {
+          g_debug (
+            "not descending into %s, already indexed "
+            "as %s",
+            path, prev_path);
+          return false;
+        }
+    }
+
+  g_hash_table_replace (
+    self->recursed_dir_ids, g_strdup (id), g_strdup (path));
+  return true;
+}
+
+static void
+index_dir (FileIndex * self, FileIndexJob * job)
+{
+  GError * err = NULL;
+  GFile *  file = g_file_new_for_path (job->dir);
+
+  /* claim the top directory of a recursive location,
+   * so that links back to it are not followed */
+  if (job->recursive)
+    {
+      GFileInfo * dir_info = g_file_query_info (
+        file, G_FILE_ATTRIBUTE_ID_FILE,
+        G_FILE_QUERY_INFO_NONE, NULL, NULL);
+      if (dir_info)
+        {
+          const char * id = g_file_info_get_attribute_string (
+            dir_info, G_FILE_ATTRIBUTE_ID_FILE);
+          if (
+            id
+            && !g_hash_table_contains (
+              self->recursed_dir_ids, id))
+            {
+              claim_dir_for_recursion (self, id, job->dir);
+            }
+          g_object_unref (dir_info);
+        }
+    }
+
+  GFileEnumerator * enumerator = g_file_enumerate_children (
+    file, LIST_ATTRIBUTES, G_FILE_QUERY_INFO_NONE, NULL,
+    &err);
+  g_object_unref (file);
+  if (!enumerator)
+    {
+      /* the directory was removed or cannot be
+       * read */
+      g_debug (
+        "failed to list %s: %s", job->dir, err->message);
+      g_error_free (err);
+      g_mutex_lock (&self->lock);
+      if (g_hash_table_contains (self->dirs_ht, job->dir))
+        {
+          remove_path (self, job->dir);
+        }
+      g_mutex_unlock (&self->lock);
+      return;
+    }
+
+  /* only this thread modifies the index, so it can
+   * be read without locking here */
+  GPtrArray * children = g_ptr_array_new ();
+  GPtrArray * new_entries = g_ptr_array_new ();
+  bool        complete = false;
+  while (!g_atomic_int_get (&self->stopping))
+    {
+      GFileInfo * info = NULL;
+      if (!g_file_enumerator_iterate (
+            enumerator, &info, NULL, NULL, &err))
+        {
+          g_debug (
+            "failed to list %s: %s", job->dir, err->message);
+          g_error_free (err);
+          break;
+        }
+      if (!info)
+        {
+          complete = true;
+          break;
+        }
+
+      const char * name = g_file_info_get_name (info);
+      char * path = g_build_filename (job->dir, name, NULL);
+      bool   is_dir =
+        g_file_info_get_file_type (info)
+        == G_FILE_TYPE_DIRECTORY;
+      int64_t mtime =
+        (int64_t) g_file_info_get_attribute_uint64 (
+          info, G_FILE_ATTRIBUTE_TIME_MODIFIED)
+          * G_USEC_PER_SEC
+        + g_file_info_get_attribute_uint32 (
+          info, G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC);
+      int64_t size = (int64_t) g_file_info_get_size (info);
+
+      FileIndexEntry * entry = (FileIndexEntry *)
+        g_hash_table_lookup (self->entries_ht, path);
+      bool unchanged =
+        entry && entry->mtime == mtime && entry->size == size
+        && (entry->type == FILE_TYPE_DIR) == is_dir;
+      if (!unchanged)
+        {
+          entry = object_new (FileIndexEntry);
+          entry->abs_path = g_strdup (path);
+          entry->type =
+            is_dir
+              ? FILE_TYPE_DIR
+              : supported_file_get_type (path);
+          entry->hidden =
+            g_file_info_get_is_hidden (info)
+            || name[0] == '.';
+          entry->mtime = mtime;
+          entry->size = size;
+          init_entry_runtime_fields (entry);
+          if (supported_file_type_is_audio (entry->type))
+            {
+              probe_audio_info (entry);
+            }
+          g_ptr_array_add (new_entries, entry);
+        }
+      g_ptr_array_add (children, entry);
+
+      if (is_dir && job->recursive && !entry->hidden)
+        {
+          bool skip =
+            (job->skip_unchanged_subdirs && unchanged
+             && g_hash_table_contains (self->dirs_ht, path))
+            || !claim_dir_for_recursion (
+              self,
+              g_file_info_get_attribute_string (
+                info, G_FILE_ATTRIBUTE_ID_FILE),
+              path);
+          if (!skip)
+            {
+              queue_job (
+                self, FILE_INDEX_JOB_INDEX_DIR, path, true,
+                job->skip_unchanged_subdirs, false);
+            }
+        }
+      g_free (path);
+    }
+  g_object_unref (enumerator);
+
+  /* keep the previous listing if stopped or if
+   * listing failed midway, otherwise the entries
+   * not reached would be removed */
+  if (!complete)
+    {
+      g_ptr_array_set_free_func (
+        new_entries, (GDestroyNotify) file_index_entry_free);
+      g_ptr_array_unref (new_entries);
+      g_ptr_array_unref (children);
+      return;
+    }
+
+  g_ptr_array_sort (children, cmp_entries);
+
+  g_mutex_lock (&self->lock);
+
+  /* remove entries that no longer exist */
+  FileIndexDir * dir = (FileIndexDir *) g_hash_table_lookup (
+    self->dirs_ht, job->dir);
+  if (dir)
+    {
+      GHashTable * child_paths =
+        g_hash_table_new (g_str_hash, g_str_equal);
+      for (guint i = 0; i < children->len; i++)
+        {
+          FileIndexEntry * child = (FileIndexEntry *)
+            g_ptr_array_index (children, i);
+          g_hash_table_add (child_paths, child->abs_path);
+        }
+      GPtrArray * prev_children =
+        g_ptr_array_ref (dir->children);
+      for (guint i = 0; i < prev_children->len; i++)
+        {
+          FileIndexEntry * prev_child =
+            (FileIndexEntry *) g_ptr_array_index (
+              prev_children, i);
+          if (!g_hash_table_contains (
+                child_paths, prev_child->abs_path))
+            {
+              remove_path (self, prev_child->abs_path);
+            }
+        }
+      g_ptr_array_unref (prev_children);
+      g_hash_table_unref (child_paths);
+    }
+
+  /* add new and changed entries (this frees the
+   * replaced entries) */
+  for (guint i = 0; i < new_entries->len; i++)
+    {
+      FileIndexEntry * entry =
+        (FileIndexEntry *) g_ptr_array_index (new_entries, i);
+
+      /* remove the listing of a directory that was
+       * replaced by a file */
+      if (
+        entry->type != FILE_TYPE_DIR
+        && g_hash_table_contains (
+          self->dirs_ht, entry->abs_path))
+        {
+          remove_path (self, entry->abs_path);
+        }
+
+      g_hash_table_replace (
+        self->entries_ht, entry->abs_path, entry);
+    }
+
+  /* the dir may have been removed above if it was
+   * listed under itself through a symlink */
+  dir = (FileIndexDir *) g_hash_table_lookup (
+    self->dirs_ht, job->dir);
+  if (!dir)
+    {
+      dir = object_new (FileIndexDir);
+      dir->children = children;
+      dir->generation = 1;
+      g_hash_table_insert (
+        self->dirs_ht, g_strdup (job->dir), dir);
+      watch_dir (self, job->dir);
+      self->dirty = true;
+    }
+  else
+    {
+      bool changed = dir->children->len != children->len;
+      for (guint i = 0; !changed && i < children->len; i++)
+        {
+          changed =
+            g_ptr_array_index (dir->children, i)
+            != g_ptr_array_index (children, i);
+        }
+      g_ptr_array_unref (dir->children);
+      dir->children = children;
+      if (changed)
+        {
+          dir->generation++;
+          self->dirty = true;
+        }
+    }
+  g_mutex_unlock (&self->lock);
+
+  g_ptr_array_unref (new_entries);
+}
+
+static bool
+is_yaml_our_version (const char * yaml)
+{
+  char version_str[120];
+  sprintf (
+    version_str, "schema_version: %d\n",
+    FILE_INDEX_SCHEMA_VERSION);
+  if (g_str_has_prefix (yaml, version_str))
+    return true;
+
+  sprintf (
+    version_str, "---\nschema_version: %d\n",
+    FILE_INDEX_SCHEMA_VERSION);
+  return g_str_has_prefix (yaml, version_str);
+}
+
+static void
+load_from_file (FileIndex * self)
+{
+  if (!file_exists (self->path))
+    return;
+
+  GError * err = NULL;
+  char *   yaml = NULL;
+  if (!g_file_get_contents (self->path, &yaml, NULL, &err))
+    {
+      g_warning (
+        "failed to read file index %s: %s", self->path,
+        err->message);
+      g_error_free (err);
+      return;
+    }
+  if (!is_yaml_our_version (yaml))
+    {
+      g_message (
+        "Found old file index version. Rebuilding the "
+        "index.");
+      g_free (yaml);
+      return;
+    }
+
+  FileIndex * loaded = (FileIndex *) yaml_deserialize (
+    yaml, &file_index_schema, &err);
+  g_free (yaml);
+  if (!loaded)
+    {
+      g_warning (
+        "failed to deserialize file index %s: %s",
+        self->path, err->message);
+      g_error_free (err);
+      return;
+    }
+
+  g_mutex_lock (&self->lock);
+
+  /* directories listed before loading (e.g., by a
+   * job queued in front) are already up to date, so
+   * their saved entries are outdated */
+  GHashTable * listed_dirs = g_hash_table_new_full (
+    g_str_hash, g_str_equal, g_free, NULL);
+  GHashTableIter iter;
+  gpointer       key;
+  g_hash_table_iter_init (&iter, self->dirs_ht);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    {
+      g_hash_table_add (listed_dirs, g_strdup (key));
+    }
+
+  for (int i = 0; i < loaded->num_entries; i++)
+    {
+      FileIndexEntry * entry = loaded->entries[i];
+      char * parent = g_path_get_dirname (entry->abs_path);
+      bool   outdated =
+        g_hash_table_contains (listed_dirs, parent)
+        || g_hash_table_contains (
+          self->entries_ht, entry->abs_path);
+      g_free (parent);
+      if (outdated)
+        {
+          file_index_entry_free (entry);
+          continue;
+        }
+      init_entry_runtime_fields (entry);
+      g_hash_table_insert (
+        self->entries_ht, entry->abs_path, entry);
+
+      /* entries are always added with all their
+       * siblings, so the listing of their parent
+       * can be restored */
+      char * parent = g_path_get_dirname (entry->abs_path);
+      FileIndexDir * dir = (FileIndexDir *)
+        g_hash_table_lookup (self->dirs_ht, parent);
+      if (!dir)
+        {
+          dir = object_new (FileIndexDir);
+          dir->children = g_ptr_array_new ();
+          dir->generation = 1;
+          g_hash_table_insert (self->dirs_ht, parent, dir);
+          watch_dir (self, parent);
+        }
+      else
+        {
+          g_free (parent);
+        }
+      g_ptr_array_add (dir->children, entry);
+    }
+
+  g_hash_table_unref (listed_dirs);
+
+  gpointer value;
+  g_hash_table_iter_init (&iter, self->dirs_ht);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      FileIndexDir * dir = (FileIndexDir *) value;
+      g_ptr_array_sort (dir->children, cmp_entries);
+    }
+  g_mutex_unlock (&self->lock);
+
+  g_message (
+    "Loaded %d entries from file index", loaded->num_entries);
+
+  g_free (loaded->entries);
+  object_zero_and_free (loaded);
+}
+
+static void
+save_to_file (FileIndex * self)
+{
+  /* only this thread modifies the entries, so they
+   * can be read without locking */
+  self->num_entries = 0;
+  self->entries_size =
+    MAX (g_hash_table_size (self->entries_ht), 1);
+  self->entries =
+    object_new_n (self->entries_size, FileIndexEntry *);
+  GHashTableIter iter;
+  gpointer       value;
+  g_hash_table_iter_init (&iter, self->entries_ht);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      self->entries[self->num_entries++] =
+        (FileIndexEntry *) value;
+    }
+
+  char * yaml = yaml_serialize (self, &file_index_schema);
+  g_free_and_null (self->entries);
+  self->num_entries = 0;
+  self->entries_size = 0;
+  g_return_if_fail (yaml);
+
+  GError * err = NULL;
+  if (!g_file_set_contents (self->path, yaml, -1, &err))
+    {
+      g_warning (
+        "failed to write file index %s: %s", self->path,
+        err->message);
+      g_error_free (err);
+    }
+  g_free (yaml);
+}
+
+static gpointer
+indexing_thread (gpointer data)
+{
+  FileIndex * self = (FileIndex *) data;
+
+  bool stop = false;
+  while (!stop)
+    {
+      FileIndexJob * job =
+        (FileIndexJob *) g_async_queue_pop (self->queue);
+      if (job->dir)
+        {
+          g_mutex_lock (&self->lock);
+          g_hash_table_remove (self->queued_dirs, job->dir);
+          g_mutex_unlock (&self->lock);
+        }
+
+      switch (job->type)
+        {
+        case FILE_INDEX_JOB_LOAD:
+          load_from_file (self);
+          break;
+        case FILE_INDEX_JOB_INDEX_DIR:
+          index_dir (self, job);
+          break;
+        case FILE_INDEX_JOB_STOP:
+          stop = true;
+          break;
+        }
+      file_index_job_free (job);
+
+      /* save when everything is indexed */
+      g_mutex_lock (&self->lock);
+      bool save =
+        self->path && self->dirty
+        && (stop || self->num_pending_jobs == 1);
+      self->dirty = self->dirty && !save;
+      g_mutex_unlock (&self->lock);
+      if (save)
+        {
+          save_to_file (self);
+        }
+
+      g_mutex_lock (&self->lock);
+      self->num_pending_jobs--;
+      if (self->num_pending_jobs == 0)
+        {
+          g_cond_broadcast (&self->idle_cond);
+        }
+      g_mutex_unlock (&self->lock);
+    }
+
+  return NULL;
+}
+
+FileIndex *
+file_index_new (const char * path)
+{
+  FileIndex * self = object_new (FileIndex);
+  self->schema_version = FILE_INDEX_SCHEMA_VERSION;
+  self->path = g_strdup (path);
+
+  self->entries_ht = g_hash_table_new_full (
+    g_str_hash, g_str_equal, NULL,
+    (GDestroyNotify) file_index_entry_free);
+  self->dirs_ht = g_hash_table_new_full (
+    g_str_hash, g_str_equal, g_free,
+    (GDestroyNotify) file_index_dir_free);
+  self->queued_dirs = g_hash_table_new_full (
+    g_str_hash, g_str_equal, g_free, NULL);
+  self->recursive_locations =
+    g_ptr_array_new_with_free_func (g_free);
+  self->dirs_to_watch =
+    g_ptr_array_new_with_free_func (g_free);
+  self->monitors = g_hash_table_new_full (
+    g_str_hash, g_str_equal, g_free, g_object_unref);
+  self->recursed_dir_ids = g_hash_table_new_full (
+    g_str_hash, g_str_equal, g_free, g_free);
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->idle_cond);
+  self->queue = g_async_queue_new_full (
+    (GDestroyNotify) file_index_job_free);
+
+  if (self->path)
+    {
+      queue_job (
+        self, FILE_INDEX_JOB_LOAD, NULL, false, false, false);
+    }
+
+  self->thread =
+    g_thread_new ("file_index", indexing_thread, self);
+
+  return self;
+}
+
+/**
+ * Returns whether the given directory is inside a
+ * recursively indexed location.
+ *
+ * Must be called with the lock held.
+ */
+static bool
+is_in_recursive_location (FileIndex * self, const char * dir)
+{
+  for (guint i = 0; i < self->recursive_locations->len; i++)
+    {
+      const char * location = (const char *)
+        g_ptr_array_index (self->recursive_locations, i);
+      size_t len = strlen (location);
+      if (strncmp (dir, location, len) != 0)
+        continue;
+
+      if (
+        dir[len] == '\0' || dir[len] == G_DIR_SEPARATOR
+        || (len > 0 && location[len - 1] == G_DIR_SEPARATOR))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+void
+file_index_add_location (
+  FileIndex *  self,
+  const char * dir,
+  bool         recursive)
+{
+  if (recursive)
+    {
+      g_mutex_lock (&self->lock);
+      g_ptr_array_add (
+        self->recursive_locations, g_strdup (dir));
+      g_mutex_unlock (&self->lock);
+    }
+
+  queue_job (
+    self, FILE_INDEX_JOB_INDEX_DIR, dir, recursive, false,
+    false);
+}
+
+void
+file_index_index_dir (FileIndex * self, const char * dir)
+{
+  g_mutex_lock (&self->lock);
+  bool recursive = is_in_recursive_location (self, dir);
+  g_mutex_unlock (&self->lock);
+
+  queue_job (
+    self, FILE_INDEX_JOB_INDEX_DIR, dir, recursive, true,
+    true);
+}
+
+bool
+file_index_get_dir_entries (
+  FileIndex *    self,
+  const char *   dir,
+  GPtrArray *    entries,
+  unsigned int * generation)
+{
+  g_mutex_lock (&self->lock);
+  FileIndexDir * index_dir =
+    (FileIndexDir *) g_hash_table_lookup (self->dirs_ht, dir);
+  if (index_dir)
+    {
+      for (guint i = 0; i < index_dir->children->len; i++)
+        {
+          const FileIndexEntry * entry =
+            (const FileIndexEntry *) g_ptr_array_index (
+              index_dir->children, i);
+          g_ptr_array_add (
+            entries, file_index_entry_clone (entry));
+        }
+      if (generation)
+        {
+          *generation = index_dir->generation;
+        }
+    }
+  g_mutex_unlock (&self->lock);
+
+  return index_dir != NULL;
+}
+
+unsigned int
+file_index_get_dir_generation (
+  FileIndex *  self,
+  const char * dir)
+{
+  g_mutex_lock (&self->lock);
+  FileIndexDir * index_dir =
+    (FileIndexDir *) g_hash_table_lookup (self->dirs_ht, dir);
+  unsigned int generation =
+    index_dir ? index_dir->generation : 0;
+  g_mutex_unlock (&self->lock);
+
+  return generation;
+}
+
+FileIndexEntry *
+file_index_get_entry (FileIndex * self, const char * path)
+{
+  g_mutex_lock (&self->lock);
+  const FileIndexEntry * entry = (const FileIndexEntry *)
+    g_hash_table_lookup (self->entries_ht, path);
+  FileIndexEntry * ret =
+    entry ? file_index_entry_clone (entry) : NULL;
+  g_mutex_unlock (&self->lock);
+
+  return ret;
+}
+
+/**
+ * Returns the rank of a search match, lower is
+ * better.
+ */
+static int
+get_search_rank (
+  const FileIndexEntry * entry,
+  const char *           key)
+{
+  if (string_is_equal (entry->search_key, key))
+    return 0;
+  if (g_str_has_prefix (entry->search_key, key))
+    return 1;
+  return 2;
+}
+
+static int
+cmp_search_results (
+  const void * _a,
+  const void * _b,
+  void *       user_data)
+{
+  const FileIndexEntry * a =
+    *(const FileIndexEntry * const *) _a;
+  const FileIndexEntry * b =
+    *(const FileIndexEntry * const *) _b;
+  const char * key = (const char *) user_data;
+  int          r =
+    get_search_rank (a, key) - get_search_rank (b, key);
+  if (r)
+    return r;
+
+  return cmp_entries (_a, _b);
+}
+
+void
+file_index_search (
+  FileIndex *  self,
+  const char * text,
+  GPtrArray *  entries,
+  guint        max_results)
+{
+  char key[strlen (text) + 1];
+  key[strlen (text)] = '\0';
+  string_to_upper (text, key);
+
+  /* rank all matches before truncating, so the best
+   * matches are never left out */
+  GPtrArray * found = g_ptr_array_new ();
+  g_mutex_lock (&self->lock);
+  GHashTableIter iter;
+  gpointer       value;
+  g_hash_table_iter_init (&iter, self->entries_ht);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      FileIndexEntry * entry = (FileIndexEntry *) value;
+      if (strstr (entry->search_key, key))
+        {
+          g_ptr_array_add (found, entry);
+        }
+    }
+  g_ptr_array_sort_with_data (
+    found, cmp_search_results, key);
+  for (guint i = 0; i < MIN (found->len, max_results); i++)
+    {
+      g_ptr_array_add (
+        entries,
+        file_index_entry_clone (
+          (const FileIndexEntry *) g_ptr_array_index (
+            found, i)));
+    }
+  g_mutex_unlock (&self->lock);
+  g_ptr_array_unref (found);
+}
+
+void
+file_index_wait_until_idle (FileIndex * self)
+{
+  g_mutex_lock (&self->lock);
+  while (self->num_pending_jobs > 0)
+    {
+      g_cond_wait (&self->idle_cond, &self->lock);
+    }
+  g_mutex_unlock (&self->lock);
+}
+
+FileIndexEntry *
+file_index_entry_clone (const FileIndexEntry * src)
+{
+  FileIndexEntry * self = object_new (FileIndexEntry);
+  *self = *src;
+  self->abs_path = g_strdup (src->abs_path);
+  self->label = g_strdup (src->label);
+  self->search_key = g_strdup (src->search_key);
+
+  return self;
+}
+
+void
+file_index_entry_free (FileIndexEntry * self)
+{
+  g_free_and_null (self->abs_path);
+  g_free_and_null (self->label);
+  g_free_and_null (self->search_key);
+
+  object_zero_and_free (self);
+}
+
+void
+file_index_free (FileIndex * self)
+{
+  /* stop indexing and save */
+  g_atomic_int_set (&self->stopping, 1);
+  queue_job (
+    self, FILE_INDEX_JOB_STOP, NULL, false, false, true);
+  g_thread_join (self->thread);
+
+  if (self->watch_source_id)
+    {
+      g_source_remove (self->watch_source_id);
+    }
+  g_hash_table_destroy (self->monitors);
+
+  g_async_queue_unref (self->queue);
+  g_hash_table_destroy (self->dirs_ht);
+  g_hash_table_destroy (self->entries_ht);
+  g_hash_table_destroy (self->queued_dirs);
+  g_hash_table_destroy (self->recursed_dir_ids);
+  g_ptr_array_unref (self->recursive_locations);
+  g_ptr_array_unref (self->dirs_to_watch);
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->idle_cond);
+  g_free_and_null (self->path);
+
+  object_zero_and_free (self);
+}
@@ -21,6 +21,7 @@
 #include <string.h>
 
 #include "audio/supported_file.h"
+#include "gui/backend/file_index.h"
 #include "gui/backend/file_manager.h"
 #include "settings/settings.h"
 #include "utils/arrays.h"
@@ -48,6 +49,18 @@ file_manager_new (void)
   self->locations = g_ptr_array_new_with_free_func (
     (GDestroyNotify) file_browser_location_free);
 
+  char * index_path = NULL;
+  if (!ZRYTHM_TESTING)
+    {
+      char * zrythm_dir =
+        zrythm_get_dir (ZRYTHM_DIR_USER_TOP);
+      index_path = g_build_filename (
+        zrythm_dir, "file_index.yaml", NULL);
+      g_free (zrythm_dir);
+    }
+  self->index = file_index_new (index_path);
+  g_free (index_path);
+
   /* add standard locations */
   FileBrowserLocation * fl = file_browser_location_new ();
   /* TRANSLATORS: Home directory */
@@ -68,6 +81,19 @@ file_manager_new (void)
 
   if (!ZRYTHM_TESTING)
     {
+      /* index the standard locations without their
+       * subdirectories, which are indexed when
+       * visited */
+      for (guint i = 0; i < self->locations->len; i++)
+        {
+          fl = g_ptr_array_index (self->locations, i);
+          if (fl->path)
+            {
+              file_index_add_location (
+                self->index, fl->path, false);
+            }
+        }
+
       /* add bookmarks */
       char ** bookmarks = g_settings_get_strv (
         S_UI_FILE_BROWSER, "file-browser-bookmarks");
@@ -79,6 +105,8 @@ file_manager_new (void)
           fl->path = g_strdup (bookmark);
           fl->special_location = FILE_MANAGER_NONE;
           g_ptr_array_add (self->locations, fl);
+          file_index_add_location (
+            self->index, fl->path, true);
         }
       g_strfreev (bookmarks);
 
@@ -98,18 +126,16 @@ file_manager_new (void)
   return self;
 }
 
-static int
-alphaBetize (const void * _a, const void * _b)
+static SupportedFile *
+create_file_from_index_entry (const FileIndexEntry * entry)
 {
-  SupportedFile * a = *(SupportedFile * const *) _a;
-  SupportedFile * b = *(SupportedFile * const *) _b;
-  int             r = strcasecmp (a->label, b->label);
-  if (r)
-    return r;
-  /* if equal ignoring case, use opposite of strcmp()
-   * result to get lower before upper */
-  return -strcmp (
-    a->label, b->label); /* aka: return strcmp(b, a); */
+  SupportedFile * fd = object_new (SupportedFile);
+  fd->abs_path = g_strdup (entry->abs_path);
+  fd->label = g_strdup (entry->label);
+  fd->type = entry->type;
+  fd->hidden = entry->hidden;
+
+  return fd;
 }
 
 static void
@@ -117,91 +143,46 @@ load_files_from_location (
   FileManager *         self,
   FileBrowserLocation * location)
 {
-  const gchar *   file;
-  SupportedFile * fd;
-
   g_ptr_array_remove_range (self->files, 0, self->files->len);
-
-  GDir * dir = g_dir_open (location->path, 0, NULL);
-  if (!dir)
+  self->showing_search_results = false;
+  self->files_generation = 0;
+
+  /* read the files from the index (directories that
+   * were not indexed yet are shown once the index
+   * has listed them, see
+   * file_manager_files_changed()) */
+  GPtrArray * entries = g_ptr_array_new_with_free_func (
+    (GDestroyNotify) file_index_entry_free);
+  if (file_index_get_dir_entries (
+        self->index, location->path, entries,
+        &self->files_generation))
     {
-      g_warning ("Could not open dir %s", location->path);
-      return;
+      for (guint i = 0; i < entries->len; i++)
+        {
+          const FileIndexEntry * entry =
+            (const FileIndexEntry *) g_ptr_array_index (
+              entries, i);
+          g_ptr_array_add (
+            self->files,
+            create_file_from_index_entry (entry));
+        }
     }
+  g_ptr_array_unref (entries);
+
+  /* refresh the index in the background */
+  file_index_index_dir (self->index, location->path);
 
   /* create special parent dir entry */
-  fd = object_new (SupportedFile);
-  /*g_message ("pre path %s",*/
-  /*location->path);*/
-  fd->abs_path = io_path_get_parent_dir (location->path);
-  /*g_message ("after path %s",*/
-  /*fd->abs_path);*/
-  fd->type = FILE_TYPE_PARENT_DIR;
-  fd->hidden = 0;
-  fd->label = g_strdup ("..");
   if (strlen (location->path) > 1)
     {
-      g_ptr_array_add (self->files, fd);
-    }
-  else
-    {
-      supported_file_free (fd);
-      fd = NULL;
-    }
-
-  while ((file = g_dir_read_name (dir)))
-    {
-      fd = object_new (SupportedFile);
-      /*fd->dnd_type = UI_DND_TYPE_FILE_DESCRIPTOR;*/
-
-      /* set absolute path & label */
-      char * absolute_path = g_strdup_printf (
-        "%s%s%s",
-        strlen (location->path) == 1 ? "" : location->path,
-        G_DIR_SEPARATOR_S, file);
-      fd->abs_path = absolute_path;
-      fd->label = g_strdup (file);
-
-      GError *    err = NULL;
-      GFile *     gfile = g_file_new_for_path (absolute_path);
-      GFileInfo * info = g_file_query_info (
-        gfile, G_FILE_ATTRIBUTE_STANDARD_IS_HIDDEN,
-        G_FILE_QUERY_INFO_NONE, NULL, &err);
-      if (err)
-        {
-          g_warning (
-            "failed to query file info for %s", absolute_path);
-        }
-      else
-        {
-          fd->hidden = g_file_info_get_is_hidden (info);
-          g_object_unref (info);
-        }
-      g_object_unref (gfile);
-
-      /* set type */
-      if (g_file_test (absolute_path, G_FILE_TEST_IS_DIR))
-        {
-          fd->type = FILE_TYPE_DIR;
-        }
-      else
-        {
-          fd->type = supported_file_get_type (file);
-        }
-
-      /* force hidden if starts with . */
-      if (file[0] == '.')
-        fd->hidden = true;
-
-      g_ptr_array_add (self->files, fd);
-      /*g_message ("File found: %s (%d - %d)",*/
-      /*fd->abs_path,*/
-      /*fd->type,*/
-      /*fd->hidden);*/
+      SupportedFile * fd = object_new (SupportedFile);
+      fd->abs_path = io_path_get_parent_dir (location->path);
+      fd->type = FILE_TYPE_PARENT_DIR;
+      fd->hidden = 0;
+      fd->label = g_strdup ("..");
+      g_ptr_array_insert (self->files, 0, fd);
     }
-  g_dir_close (dir);
 
-  g_ptr_array_sort (self->files, (GCompareFunc) alphaBetize);
   g_message ("Total files: %d", self->files->len);
 }
 
@@ -223,6 +204,84 @@ file_manager_load_files (FileManager * self)
     }
 }
 
+/**
+ * Loads the files in all locations whose name
+ * contains the given text into FileManager.files.
+ */
+void
+file_manager_load_search_results (
+  FileManager * self,
+  const char *  text)
+{
+  g_ptr_array_remove_range (self->files, 0, self->files->len);
+  self->showing_search_results = true;
+  self->files_generation = 0;
+
+  GPtrArray * entries = g_ptr_array_new_with_free_func (
+    (GDestroyNotify) file_index_entry_free);
+  file_index_search (
+    self->index, text, entries,
+    FILE_MANAGER_MAX_SEARCH_RESULTS);
+  for (guint i = 0; i < entries->len; i++)
+    {
+      const FileIndexEntry * entry =
+        (const FileIndexEntry *) g_ptr_array_index (
+          entries, i);
+      g_ptr_array_add (
+        self->files, create_file_from_index_entry (entry));
+    }
+  g_ptr_array_unref (entries);
+}
+
+/**
+ * Returns whether the files under the current
+ * selection changed since they were loaded.
+ */
+bool
+file_manager_files_changed (FileManager * self)
+{
+  if (self->showing_search_results || !self->selection)
+    return false;
+
+  return file_index_get_dir_generation (
+           self->index, self->selection->path)
+         != self->files_generation;
+}
+
+/**
+ * Returns a pango markup describing the file, using
+ * the indexed info if available.
+ */
+char *
+file_manager_get_file_info_text (
+  FileManager *         self,
+  const SupportedFile * file)
+{
+  FileIndexEntry * entry =
+    file_index_get_entry (self->index, file->abs_path);
+  char * text;
+  if (entry && entry->have_info)
+    {
+      AudecInfo nfo;
+      memset (&nfo, 0, sizeof (AudecInfo));
+      nfo.sample_rate = entry->samplerate;
+      nfo.channels = entry->channels;
+      nfo.length = entry->length;
+      nfo.bpm = entry->bpm;
+      nfo.bit_rate = entry->bit_rate;
+      nfo.bit_depth = entry->bit_depth;
+      text = supported_file_get_info_text_for_label_w_info (
+        file, &nfo);
+    }
+  else
+    {
+      text = supported_file_get_info_text_for_label (file);
+    }
+  object_free_w_func_and_null (file_index_entry_free, entry);
+
+  return text;
+}
+
 /**
  * @param save_to_settings Whether to save this
  *   location to GSettings.
@@ -295,6 +354,7 @@ file_manager_add_location_and_save (
   loc->label = g_path_get_basename (loc->path);
 
   g_ptr_array_add (self->locations, loc);
+  file_index_add_location (self->index, loc->path, true);
 
   save_locations (self);
 }
@@ -346,6 +406,7 @@ file_manager_remove_location_and_save (
 void
 file_manager_free (FileManager * self)
 {
+  object_free_w_func_and_null (file_index_free, self->index);
   g_ptr_array_free (self->files, true);
   g_ptr_array_free (self->locations, true);
 
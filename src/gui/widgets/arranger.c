@@ -59,6 +59,7 @@
 #include "utils/error.h"
 #include "utils/flags.h"
 #include "utils/gtk.h"
+#include "utils/interval_tree.h"
 #include "utils/math.h"
 #include "utils/objects.h"
 #include "utils/resources.h"
@@ -87,6 +88,10 @@ G_DEFINE_TYPE (ArrangerWidget, arranger_widget, GTK_TYPE_WIDGET)
 
 #define SCROLL_PADDING 8.0
 
+/** Pixels before an object's start where it can
+ * still be hit (e.g. for its resize handle). */
+#define HIT_PADDING 12.0
+
 static void
 drag_end (
   GtkGestureDrag * gesture,
@@ -386,6 +391,17 @@ typedef struct ObjectOverlapInfo
   ArrangerObject * obj;
 } ObjectOverlapInfo;
 
+/**
+ * Returns @ref HIT_PADDING in ticks at the current
+ * zoom level.
+ */
+static double
+get_hit_padding_ticks (ArrangerWidget * self)
+{
+  return HIT_PADDING
+         / arranger_widget_get_ruler (self)->px_per_tick;
+}
+
 /**
  * Adds the object to the array if it or its
  * transient overlaps with the rectangle, or with
@@ -402,7 +418,6 @@ add_object_if_overlap (
   double           x = nfo->x;
   double           y = nfo->y;
   ArrangerObject * obj = nfo->obj;
-  RulerWidget *    ruler = arranger_widget_get_ruler (self);
 
   g_return_val_if_fail (IS_ARRANGER_OBJECT (obj), false);
   g_return_val_if_fail (
@@ -456,7 +471,7 @@ add_object_if_overlap (
       position_add_ticks (&g_obj_start_pos, obj->pos.ticks);
     }
   position_add_ticks (
-    &g_obj_start_pos, -12.0 / ruler->px_per_tick);
+    &g_obj_start_pos, -get_hit_padding_ticks (self));
   if (position_is_after (&g_obj_start_pos, &nfo->end_pos))
     {
       return false;
@@ -530,6 +545,368 @@ add_object_if_overlap (
   return add;
 }
 
+/**
+ * Returns whether the regions of the given track
+ * can be hit in the timeline at the y of the
+ * rectangle or point.
+ */
+static bool
+should_check_track_regions (
+  ArrangerWidget * self,
+  Track *          track,
+  GdkRectangle *   rect,
+  int              start_y)
+{
+  /* skip tracks if not visible or pin status
+   * doesn't match */
+  if (
+    !track->visible
+    || track_is_pinned (track) != self->is_pinned)
+    {
+      return false;
+    }
+
+  /* skip if track should not be visible */
+  if (!track_get_should_be_visible (track))
+    return false;
+
+  if (G_LIKELY (track->widget))
+    {
+      int track_y = track_widget_get_local_y (
+        track->widget, self, start_y);
+
+      /* skip if track starts after the rect */
+      if (track_y + (rect ? rect->height : 0) < 0)
+        {
+          return false;
+        }
+
+      double full_track_height =
+        track_get_full_visible_height (track);
+
+      /* skip if track ends before the rect */
+      if (track_y > full_track_height)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/**
+ * Adds the lane region to the array if it overlaps,
+ * also checking its lane if lanes are visible.
+ */
+static void
+add_lane_region_if_overlap (
+  ArrangerWidget *    self,
+  Track *             track,
+  ZRegion *           r,
+  ObjectOverlapInfo * nfo)
+{
+  g_warn_if_fail (IS_REGION (r));
+  ArrangerObject * obj = (ArrangerObject *) r;
+  nfo->obj = obj;
+  if (add_object_if_overlap (self, nfo))
+    return;
+
+  /* check lanes */
+  if (!track->lanes_visible)
+    return;
+  GdkRectangle lane_rect;
+  region_get_lane_full_rect (r, &lane_rect);
+  bool lane_hit =
+    nfo->rect
+      ? ui_rectangle_overlap (&lane_rect, nfo->rect)
+      : ui_is_point_in_rect_hit (
+        &lane_rect, true, true, nfo->x, nfo->y, 0, 0);
+  if (
+    lane_hit && arranger_object_get_arranger (obj) == self
+    && !obj->deleted_temporarily)
+    {
+      g_ptr_array_add (nfo->arr, obj);
+    }
+}
+
+/**
+ * Adds the regions overlapping the rectangle or
+ * point by checking all regions.
+ */
+static void
+add_regions_if_overlap (
+  ArrangerWidget *    self,
+  ObjectOverlapInfo * nfo,
+  int                 start_y)
+{
+  for (int i = 0; i < TRACKLIST->num_tracks; i++)
+    {
+      Track * track = TRACKLIST->tracks[i];
+
+      if (!should_check_track_regions (
+            self, track, nfo->rect, start_y))
+        continue;
+
+      /* midi and audio regions */
+      for (int j = 0; j < track->num_lanes; j++)
+        {
+          TrackLane * lane = track->lanes[j];
+          for (int k = 0; k < lane->num_regions; k++)
+            {
+              add_lane_region_if_overlap (
+                self, track, lane->regions[k], nfo);
+            }
+        }
+
+      /* chord regions */
+      for (int j = 0; j < track->num_chord_regions; j++)
+        {
+          nfo->obj =
+            (ArrangerObject *) track->chord_regions[j];
+          add_object_if_overlap (self, nfo);
+        }
+
+      /* automation regions */
+      AutomationTracklist * atl =
+        track_get_automation_tracklist (track);
+      if (atl && track->automation_visible)
+        {
+          for (int j = 0; j < atl->num_ats; j++)
+            {
+              AutomationTrack * at = atl->ats[j];
+
+              if (!at->visible)
+                continue;
+
+              for (int k = 0; k < at->num_regions; k++)
+                {
+                  nfo->obj =
+                    (ArrangerObject *) at->regions[k];
+                  add_object_if_overlap (self, nfo);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Returns whether the hit index can be used,
+ * rebuilding it first if arranger objects changed.
+ *
+ * @param region Region shown in the editor, if this
+ *   is an editor.
+ */
+static bool
+update_hit_index (ArrangerWidget * self, ZRegion * region)
+{
+  unsigned int generation =
+    arranger_object_get_positions_generation ();
+  if (
+    self->hit_index
+    && self->hit_index_generation == generation
+    && self->hit_index_region == region)
+    {
+      return true;
+    }
+
+  /* objects change on every motion event during
+   * an action, so scan them instead of rebuilding
+   * the index each time */
+  if (self->action != UI_OVERLAY_ACTION_NONE)
+    return false;
+
+  if (!self->hit_index)
+    {
+      self->hit_index = interval_tree_new ();
+    }
+  interval_tree_clear (self->hit_index);
+
+  /* add the objects in the same order they are
+   * checked without the index, so that the results
+   * are in the same order */
+  switch (self->type)
+    {
+    case TYPE (TIMELINE):
+      for (int i = 0; i < TRACKLIST->num_tracks; i++)
+        {
+          Track * track = TRACKLIST->tracks[i];
+          for (int j = 0; j < track->num_lanes; j++)
+            {
+              TrackLane * lane = track->lanes[j];
+              for (int k = 0; k < lane->num_regions; k++)
+                {
+                  ArrangerObject * obj =
+                    (ArrangerObject *) lane->regions[k];
+                  interval_tree_add (
+                    self->hit_index, obj->pos.ticks,
+                    obj->end_pos.ticks, obj);
+                }
+            }
+          for (int j = 0; j < track->num_chord_regions; j++)
+            {
+              ArrangerObject * obj =
+                (ArrangerObject *) track->chord_regions[j];
+              interval_tree_add (
+                self->hit_index, obj->pos.ticks,
+                obj->end_pos.ticks, obj);
+            }
+          AutomationTracklist * atl =
+            track_get_automation_tracklist (track);
+          for (int j = 0; atl && j < atl->num_ats; j++)
+            {
+              AutomationTrack * at = atl->ats[j];
+              for (int k = 0; k < at->num_regions; k++)
+                {
+                  ArrangerObject * obj =
+                    (ArrangerObject *) at->regions[k];
+                  interval_tree_add (
+                    self->hit_index, obj->pos.ticks,
+                    obj->end_pos.ticks, obj);
+                }
+            }
+        }
+      break;
+    case TYPE (MIDI):
+      /* positions relative to the region */
+      for (int i = 0; region && i < region->num_midi_notes;
+           i++)
+        {
+          ArrangerObject * obj =
+            (ArrangerObject *) region->midi_notes[i];
+          interval_tree_add (
+            self->hit_index, obj->pos.ticks,
+            obj->end_pos.ticks, obj);
+        }
+      break;
+    default:
+      g_return_val_if_reached (false);
+    }
+
+  self->hit_index_generation = generation;
+  self->hit_index_region = region;
+
+  return true;
+}
+
+/**
+ * Returns the track the region is currently in, or
+ * NULL if it is no longer in the project or its
+ * automation track is hidden.
+ *
+ * @param tracks Tracks by name hash.
+ */
+static Track *
+get_track_of_indexed_region (
+  ZRegion *    r,
+  GHashTable * tracks)
+{
+  const RegionIdentifier * id = &r->id;
+  Track * track = (Track *) g_hash_table_lookup (
+    tracks, GUINT_TO_POINTER (id->track_name_hash));
+  if (!track)
+    return NULL;
+
+  switch (id->type)
+    {
+    case REGION_TYPE_MIDI:
+    case REGION_TYPE_AUDIO:
+      {
+        if (
+          id->lane_pos < 0
+          || id->lane_pos >= track->num_lanes)
+          break;
+        TrackLane * lane = track->lanes[id->lane_pos];
+        if (
+          id->idx >= 0 && id->idx < lane->num_regions
+          && lane->regions[id->idx] == r)
+          return track;
+      }
+      break;
+    case REGION_TYPE_CHORD:
+      if (
+        id->idx >= 0 && id->idx < track->num_chord_regions
+        && track->chord_regions[id->idx] == r)
+        return track;
+      break;
+    case REGION_TYPE_AUTOMATION:
+      {
+        AutomationTracklist * atl =
+          track_get_automation_tracklist (track);
+        if (
+          !atl || !track->automation_visible
+          || id->at_idx < 0 || id->at_idx >= atl->num_ats)
+          break;
+        AutomationTrack * at = atl->ats[id->at_idx];
+        if (
+          at->visible && id->idx >= 0
+          && id->idx < at->num_regions
+          && at->regions[id->idx] == r)
+          return track;
+      }
+      break;
+    }
+
+  return NULL;
+}
+
+/**
+ * Adds the regions overlapping the rectangle or
+ * point using the hit index.
+ */
+static void
+add_indexed_regions_if_overlap (
+  ArrangerWidget *    self,
+  ObjectOverlapInfo * nfo,
+  int                 start_y)
+{
+  GPtrArray * objs = g_ptr_array_new ();
+  interval_tree_query (
+    self->hit_index, nfo->start_pos.ticks,
+    nfo->end_pos.ticks + get_hit_padding_ticks (self),
+    objs);
+  if (objs->len == 0)
+    {
+      g_ptr_array_unref (objs);
+      return;
+    }
+
+  GHashTable * tracks =
+    g_hash_table_new (g_direct_hash, g_direct_equal);
+  for (int i = 0; i < TRACKLIST->num_tracks; i++)
+    {
+      Track * track = TRACKLIST->tracks[i];
+      g_hash_table_insert (
+        tracks,
+        GUINT_TO_POINTER (track_get_name_hash (track)),
+        track);
+    }
+
+  for (guint i = 0; i < objs->len; i++)
+    {
+      ZRegion * r = (ZRegion *) g_ptr_array_index (objs, i);
+      Track *   track =
+        get_track_of_indexed_region (r, tracks);
+      if (
+        !track
+        || !should_check_track_regions (
+          self, track, nfo->rect, start_y))
+        continue;
+
+      if (region_type_has_lane (r->id.type))
+        {
+          add_lane_region_if_overlap (self, track, r, nfo);
+        }
+      else
+        {
+          nfo->obj = (ArrangerObject *) r;
+          add_object_if_overlap (self, nfo);
+        }
+    }
+
+  g_hash_table_destroy (tracks);
+  g_ptr_array_unref (objs);
+}
+
 /**
  * Fills in the given array with the
  * ArrangerObject's of the given type that appear
@@ -611,114 +988,14 @@ get_hit_objects (
         type == ARRANGER_OBJECT_TYPE_ALL
         || type == ARRANGER_OBJECT_TYPE_REGION)
         {
-          /* midi and audio regions */
-          for (int i = 0; i < TRACKLIST->num_tracks; i++)
+          if (update_hit_index (self, NULL))
             {
-              Track * track = TRACKLIST->tracks[i];
-
-              /* skip tracks if not visible or this
-               * is timeline and pin status doesn't
-               * match */
-              if (!track->visible ||
-                  (TYPE (TIMELINE) &&
-                     track_is_pinned (track) !=
-                       self->is_pinned))
-                {
-                  continue;
-                }
-
-              /* skip if track should not be
-               * visible */
-              if (!track_get_should_be_visible (track))
-                continue;
-
-              if (G_LIKELY (track->widget))
-                {
-                  int track_y = track_widget_get_local_y (
-                    track->widget, self, start_y);
-
-                  /* skip if track starts after the
-                   * rect */
-                  if (track_y + (rect ? rect->height : 0) < 0)
-                    {
-                      continue;
-                    }
-
-                  double full_track_height =
-                    track_get_full_visible_height (track);
-
-                  /* skip if track ends before the
-                   * rect */
-                  if (track_y > full_track_height)
-                    {
-                      continue;
-                    }
-                }
-
-              for (int j = 0; j < track->num_lanes; j++)
-                {
-                  TrackLane * lane = track->lanes[j];
-                  for (int k = 0; k < lane->num_regions; k++)
-                    {
-                      ZRegion * r = lane->regions[k];
-                      g_warn_if_fail (IS_REGION (r));
-                      obj = (ArrangerObject *) r;
-                      nfo.obj = obj;
-                      bool ret =
-                        add_object_if_overlap (self, &nfo);
-                      if (!ret)
-                        {
-                          /* check lanes */
-                          if (!track->lanes_visible)
-                            continue;
-                          GdkRectangle lane_rect;
-                          region_get_lane_full_rect (
-                            lane->regions[k], &lane_rect);
-                          if (
-                            ((rect
-                              && ui_rectangle_overlap (
-                                &lane_rect, rect))
-                             || (!rect && ui_is_point_in_rect_hit (&lane_rect, true, true, x, y, 0, 0)))
-                            && arranger_object_get_arranger (obj)
-                                 == self
-                            && !obj->deleted_temporarily)
-                            {
-                              g_ptr_array_add (arr, obj);
-                            }
-                        }
-                    }
-                }
-
-              /* chord regions */
-              for (int j = 0; j < track->num_chord_regions; j++)
-                {
-                  ZRegion * cr = track->chord_regions[j];
-                  obj = (ArrangerObject *) cr;
-                  nfo.obj = obj;
-                  add_object_if_overlap (self, &nfo);
-                }
-
-              /* automation regions */
-              AutomationTracklist * atl =
-                track_get_automation_tracklist (track);
-              if (atl && track->automation_visible)
-                {
-                  for (int j = 0; j < atl->num_ats; j++)
-                    {
-                      AutomationTrack * at = atl->ats[j];
-
-                      if (!at->visible)
-                        continue;
-
-                      for (int k = 0; k < at->num_regions; k++)
-                        {
-                          obj =
-                            (ArrangerObject *) at->regions[k];
-                          nfo.obj = obj;
-                          add_object_if_overlap (self, &nfo);
-                        }
-                    }
-                }
+              add_indexed_regions_if_overlap (
+                self, &nfo, start_y);
+            }
+          else
+            {
+              add_regions_if_overlap (self, &nfo, start_y);
             }
         }
 
@@ -760,6 +1037,35 @@ get_hit_objects (
           if (!r)
             break;
 
+          if (update_hit_index (self, r))
+            {
+              /* the index has positions relative to
+               * the region */
+              double      r_ticks = r->base.pos.ticks;
+              GPtrArray * objs = g_ptr_array_new ();
+              interval_tree_query (
+                self->hit_index,
+                nfo.start_pos.ticks - r_ticks,
+                nfo.end_pos.ticks - r_ticks
+                  + get_hit_padding_ticks (self),
+                objs);
+              for (guint i = 0; i < objs->len; i++)
+                {
+                  MidiNote * mn =
+                    (MidiNote *) g_ptr_array_index (objs, i);
+                  if (
+                    mn->pos < 0
+                    || mn->pos >= r->num_midi_notes
+                    || r->midi_notes[mn->pos] != mn)
+                    continue;
+
+                  nfo.obj = (ArrangerObject *) mn;
+                  add_object_if_overlap (self, &nfo);
+                }
+              g_ptr_array_unref (objs);
+              break;
+            }
+
           for (int i = 0; i < r->num_midi_notes; i++)
             {
               MidiNote * mn = r->midi_notes[i];
@@ -6372,6 +6678,8 @@ finalize (ArrangerWidget * self)
 
   object_free_w_func_and_null (
     g_ptr_array_unref, self->hit_objs_to_draw);
+  object_free_w_func_and_null (
+    interval_tree_free, self->hit_index);
 
   G_OBJECT_CLASS (arranger_widget_parent_class)
     ->finalize (G_OBJECT (self));
@@ -15,6 +15,7 @@
 #include "project.h"
 #include "utils/error.h"
 #include "utils/gtk.h"
+#include "utils/hash.h"
 #include "utils/math.h"
 #include "utils/objects.h"
 #include "utils/resources.h"
@@ -121,6 +122,8 @@ balance_control_snapshot (
       height / 2.f - pangorect.height / 2.f));
   gtk_snapshot_append_layout (snapshot, layout, &color);
   gtk_snapshot_restore (snapshot);
+
+  z_gtk_widget_snapshot_redraw_count (widget, snapshot);
 }
 
 /**
@@ -296,7 +299,14 @@ balance_control_tick_cb (
       return G_SOURCE_CONTINUE;
     }
 
-  gtk_widget_queue_draw (widget);
+  BalanceControlWidget * self =
+    Z_BALANCE_CONTROL_WIDGET (widget);
+  float   pan_val = GET_VAL;
+  guint64 version = HASH_FNV1A_INIT;
+  HASH_FNV1A_VAL (version, pan_val);
+  HASH_FNV1A_VAL (version, self->hovered);
+  HASH_FNV1A_VAL (version, self->dragged);
+  z_gtk_widget_queue_draw_if_changed (widget, version);
 
   return G_SOURCE_CONTINUE;
 }
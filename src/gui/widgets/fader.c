@@ -16,6 +16,7 @@
 #include "project.h"
 #include "utils/flags.h"
 #include "utils/gtk.h"
+#include "utils/hash.h"
 #include "utils/math.h"
 #include "utils/resources.h"
 #include "utils/ui.h"
@@ -135,6 +136,8 @@ fader_snapshot (GtkWidget * widget, GtkSnapshot * snapshot)
       border_width,
       (height - value_px) - inner_line_width / 2.f,
       width - border_width * 2, inner_line_width));
+
+  z_gtk_widget_snapshot_redraw_count (widget, snapshot);
 }
 
 static void
@@ -344,7 +347,13 @@ fader_tick_cb (
       return G_SOURCE_CONTINUE;
     }
 
-  gtk_widget_queue_draw (widget);
+  FaderWidget * self = Z_FADER_WIDGET (widget);
+  float fader_val = self->fader ? self->fader->fader_val : 1.f;
+  guint64 version = HASH_FNV1A_INIT;
+  HASH_FNV1A_VAL (version, fader_val);
+  HASH_FNV1A_VAL (version, self->hover);
+  HASH_FNV1A_VAL (version, self->dragging);
+  z_gtk_widget_queue_draw_if_changed (widget, version);
 
   return G_SOURCE_CONTINUE;
 }
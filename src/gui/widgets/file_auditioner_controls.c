@@ -130,6 +130,10 @@ on_instrument_changed (
 
   engine_resume (AUDIO_ENGINE, &state);
 
+  /* instantiate the new instrument now so the next
+   * audition does not have to */
+  sample_processor_rebuild_audition_chain (SAMPLE_PROCESSOR);
+
   EVENTS_PUSH (ET_FILE_BROWSER_INSTRUMENT_CHANGED, NULL);
 }
 
@@ -249,11 +249,14 @@ meter_timeout (
 void
 meter_widget_setup (MeterWidget * self, Port * port, int width)
 {
+  meter_widget_set_active (self, false);
   if (self->meter)
     {
       meter_free (self->meter);
     }
   self->meter = meter_new_for_port (port);
+  self->tick_cb_id = gtk_widget_add_tick_callback (
+    GTK_WIDGET (self), (GtkTickCallback) tick_cb, self, NULL);
   g_return_if_fail (self->meter);
   self->padding = 2;
 
@@ -270,9 +273,6 @@ meter_widget_setup (MeterWidget * self, Port * port, int width)
     G_CALLBACK (on_crossing),  self);
 #endif
   (void) on_crossing;
-
-  gtk_widget_add_tick_callback (
-    GTK_WIDGET (self), (GtkTickCallback) tick_cb, self, NULL);
 #if 0
   self->timeout_source = g_timeout_source_new (20);
   g_source_set_callback (
@@ -287,6 +287,33 @@ meter_widget_setup (MeterWidget * self, Port * port, int width)
   g_message ("meter widget set up for %s", buf);
 }
 
+/**
+ * Sets whether the meter should be updated.
+ *
+ * Inactive meters are not processed and not
+ * redrawn.
+ */
+void
+meter_widget_set_active (MeterWidget * self, bool active)
+{
+  if (!self->meter || (self->tick_cb_id != 0) == active)
+    return;
+
+  meter_set_active (self->meter, active);
+  if (active)
+    {
+      self->tick_cb_id = gtk_widget_add_tick_callback (
+        GTK_WIDGET (self), (GtkTickCallback) tick_cb, self,
+        NULL);
+    }
+  else
+    {
+      gtk_widget_remove_tick_callback (
+        GTK_WIDGET (self), self->tick_cb_id);
+      self->tick_cb_id = 0;
+    }
+}
+
 static void
 finalize (MeterWidget * self)
 {
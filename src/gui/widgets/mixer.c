@@ -34,6 +34,7 @@
 #include "project.h"
 #include "utils/flags.h"
 #include "utils/gtk.h"
+#include "utils/objects.h"
 #include "utils/resources.h"
 #include "zrythm_app.h"
 
@@ -60,6 +61,151 @@ mixer_widget_soft_refresh (MixerWidget * self)
     }
 }
 
+/**
+ * Returns the widget of the strip, creating it if
+ * necessary.
+ */
+static GtkWidget *
+get_or_create_strip_widget (MixerStrip * strip)
+{
+  Track * track = strip->track;
+  if (strip->is_folder)
+    {
+      if (!track->folder_ch_widget)
+        {
+          track->folder_ch_widget =
+            folder_channel_widget_new (track);
+        }
+      folder_channel_widget_refresh (track->folder_ch_widget);
+      return GTK_WIDGET (track->folder_ch_widget);
+    }
+
+  Channel * ch = track->channel;
+  if (!ch->widget)
+    {
+      ch->widget = channel_widget_new (ch);
+    }
+  channel_widget_refresh (ch->widget);
+  return GTK_WIDGET (ch->widget);
+}
+
+static void
+show_strip (MixerWidget * self, MixerStrip * strip)
+{
+  GtkWidget * child =
+    gtk_widget_get_first_child (GTK_WIDGET (strip->box));
+  if (child)
+    return;
+
+  GtkWidget * widget = get_or_create_strip_widget (strip);
+  gtk_box_append (strip->box, widget);
+
+  /* remember the width for when the widget is
+   * destroyed */
+  int width;
+  gtk_widget_measure (
+    widget, GTK_ORIENTATION_HORIZONTAL, -1, NULL, &width,
+    NULL, NULL);
+  strip->width = MAX (width, 1);
+  gtk_widget_set_size_request (
+    GTK_WIDGET (strip->box), strip->width, -1);
+  if (strip->is_folder)
+    self->last_folder_strip_width = strip->width;
+  else
+    self->last_strip_width = strip->width;
+}
+
+static void
+hide_strip (MixerStrip * strip)
+{
+  GtkWidget * child =
+    gtk_widget_get_first_child (GTK_WIDGET (strip->box));
+  if (!child)
+    return;
+
+  /* folder channel widgets hold a reference to
+   * themselves until torn down, which also clears
+   * the track's pointer */
+  if (strip->is_folder)
+    {
+      folder_channel_widget_tear_down (
+        Z_FOLDER_CHANNEL_WIDGET (child));
+    }
+
+  /* the widget clears its pointer in the track or
+   * channel when destroyed */
+  gtk_box_remove (strip->box, child);
+}
+
+/**
+ * Creates the widgets of the strips in or near view
+ * and destroys the widgets of the strips far from
+ * view.
+ */
+void
+mixer_widget_update_strips_in_view (MixerWidget * self)
+{
+  GtkAdjustment * hadj =
+    gtk_scrolled_window_get_hadjustment (
+      self->channels_scroll);
+  double start = gtk_adjustment_get_value (hadj);
+  double page = gtk_adjustment_get_page_size (hadj);
+
+  /* keep widgets a page beyond the view and only
+   * destroy them 2 pages beyond it to avoid
+   * recreating them when scrolling back and forth */
+  double x = 0.0;
+  for (guint i = 0; i < self->strips->len; i++)
+    {
+      MixerStrip * strip =
+        (MixerStrip *) g_ptr_array_index (self->strips, i);
+      double strip_start = x;
+      double strip_end = x + strip->width;
+      x = strip_end;
+
+      if (!IS_TRACK_AND_NONNULL (strip->track))
+        continue;
+
+      if (
+        strip_end >= start - page
+        && strip_start <= start + 2 * page)
+        {
+          show_strip (self, strip);
+        }
+      else if (
+        strip_end < start - 2 * page
+        || strip_start > start + 3 * page)
+        {
+          hide_strip (strip);
+        }
+    }
+}
+
+static void
+on_hadj_changed (GtkAdjustment * hadj, MixerWidget * self)
+{
+  mixer_widget_update_strips_in_view (self);
+}
+
+static void
+add_strip (MixerWidget * self, Track * track, bool is_folder)
+{
+  MixerStrip * strip = object_new (MixerStrip);
+  strip->track = track;
+  strip->is_folder = is_folder;
+  strip->width =
+    is_folder
+      ? self->last_folder_strip_width
+      : self->last_strip_width;
+  strip->box =
+    GTK_BOX (gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0));
+  gtk_widget_set_size_request (
+    GTK_WIDGET (strip->box), strip->width, -1);
+  gtk_box_append (
+    self->channels_box, GTK_WIDGET (strip->box));
+  g_ptr_array_add (self->strips, strip);
+}
+
 void
 mixer_widget_hard_refresh (MixerWidget * self)
 {
@@ -72,32 +218,30 @@ mixer_widget_hard_refresh (MixerWidget * self)
   REF_AND_ADD_TO_ARRAY (self->ddbox);
   REF_AND_ADD_TO_ARRAY (self->channels_add);
 
-  /* ref the channel widgets to make this faster */
-  for (int i = 0; i < TRACKLIST->num_tracks; i++)
+  /* take the existing strip widgets out of their
+   * boxes to reuse them */
+  for (guint i = 0; i < self->strips->len; i++)
     {
-      Track * track = TRACKLIST->tracks[i];
-
-      if (track->folder_ch_widget)
+      MixerStrip * strip =
+        (MixerStrip *) g_ptr_array_index (self->strips, i);
+      GtkWidget * child =
+        gtk_widget_get_first_child (GTK_WIDGET (strip->box));
+      if (child)
         {
-          REF_AND_ADD_TO_ARRAY (track->folder_ch_widget);
-        }
-
-      if (track_type_has_channel (track->type))
-        {
-          if (track->channel->widget)
-            {
-              REF_AND_ADD_TO_ARRAY (track->channel->widget);
-            }
+          REF_AND_ADD_TO_ARRAY (child);
+          gtk_box_remove (strip->box, child);
         }
     }
+  g_ptr_array_set_size (self->strips, 0);
 
   /* remove all things in the container */
   z_gtk_widget_remove_all_children (
     GTK_WIDGET (self->channels_box));
+
   g_return_if_fail (
     gtk_widget_get_parent (GTK_WIDGET (self->ddbox)) == NULL);
 
-  /* add all channels */
+  /* add a strip for each channel */
   for (int i = 0; i < TRACKLIST->num_tracks; i++)
     {
       Track * track = TRACKLIST->tracks[i];
@@ -109,18 +253,7 @@ mixer_widget_hard_refresh (MixerWidget * self)
         track_type_is_foldable (track->type)
         && track->type != TRACK_TYPE_MASTER)
         {
-          if (!track->folder_ch_widget)
-            {
-              track->folder_ch_widget =
-                folder_channel_widget_new (track);
-            }
-
-          folder_channel_widget_refresh (
-            track->folder_ch_widget);
-
-          gtk_box_append (
-            self->channels_box,
-            GTK_WIDGET (track->folder_ch_widget));
+          add_strip (self, track, true);
         }
 
       if (!track_type_has_channel (track->type))
@@ -129,20 +262,15 @@ mixer_widget_hard_refresh (MixerWidget * self)
       Channel * ch = track->channel;
       g_return_if_fail (ch);
 
-      /* create chan widget if necessary */
-      if (!ch->widget)
-        ch->widget = channel_widget_new (ch);
-
-      channel_widget_refresh (ch->widget);
-
-      if (
-        track->type != TRACK_TYPE_MASTER
-        && !gtk_widget_get_parent (
-          GTK_WIDGET (ch->widget))) /* not master */
+      /* master is always shown outside the strips */
+      if (track->type == TRACK_TYPE_MASTER)
         {
-          gtk_box_append (
-            self->channels_box, GTK_WIDGET (ch->widget));
+          if (ch->widget)
+            channel_widget_refresh (ch->widget);
+          continue;
         }
+
+      add_strip (self, track, false);
     }
 
   /* add the add button */
@@ -153,7 +281,12 @@ mixer_widget_hard_refresh (MixerWidget * self)
   gtk_box_append (
     self->channels_box, GTK_WIDGET (self->ddbox));
 
-  /* unref refed widgets */
+  /* create the widgets in view (reusing the ones
+   * above) */
+  mixer_widget_update_strips_in_view (self);
+
+  /* unref refed widgets, destroying the ones not
+   * in view anymore */
   for (size_t i = 0; i < refed_widgets->len; i++)
     {
       g_object_unref (g_ptr_array_index (refed_widgets, i));
@@ -197,6 +330,16 @@ mixer_widget_new (void)
   return self;
 }
 
+static void
+finalize (MixerWidget * self)
+{
+  object_free_w_func_and_null (
+    g_ptr_array_unref, self->strips);
+
+  G_OBJECT_CLASS (mixer_widget_parent_class)
+    ->finalize (G_OBJECT (self));
+}
+
 static void
 mixer_widget_class_init (MixerWidgetClass * _klass)
 {
@@ -207,10 +350,14 @@ mixer_widget_class_init (MixerWidgetClass * _klass)
   gtk_widget_class_bind_template_child (klass, MixerWidget, x)
 
   BIND_CHILD (channels_box);
+  BIND_CHILD (channels_scroll);
   BIND_CHILD (channels_add);
   BIND_CHILD (master_box);
 
 #undef BIND_CHILD
+
+  GObjectClass * oklass = G_OBJECT_CLASS (klass);
+  oklass->finalize = (GObjectFinalizeFunc) finalize;
 }
 
 static void
@@ -229,4 +376,19 @@ mixer_widget_init (MixerWidget * self)
     GTK_ORIENTATION_HORIZONTAL, 0, DRAG_DEST_BOX_TYPE_MIXER);
   gtk_box_append (
     self->channels_box, GTK_WIDGET (self->ddbox));
+
+  self->strips = g_ptr_array_new_with_free_func (g_free);
+  self->last_strip_width = MIXER_STRIP_DEFAULT_WIDTH;
+  self->last_folder_strip_width = MIXER_STRIP_DEFAULT_WIDTH;
+
+  /* only keep the widgets of the strips near the
+   * view */
+  GtkAdjustment * hadj =
+    gtk_scrolled_window_get_hadjustment (
+      self->channels_scroll);
+  g_signal_connect (
+    hadj, "value-changed", G_CALLBACK (on_hadj_changed),
+    self);
+  g_signal_connect (
+    hadj, "changed", G_CALLBACK (on_hadj_changed), self);
 }
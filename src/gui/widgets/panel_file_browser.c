@@ -297,6 +297,51 @@ create_model_for_files (PanelFileBrowserWidget * self)
   return G_LIST_MODEL (self->files_selection_model);
 }
 
+static void
+on_files_selection_changed (
+  GtkSelectionModel * selection_model,
+  guint               position,
+  guint               n_items,
+  gpointer            user_data);
+
+/**
+ * Recreates the files model from FileManager.files.
+ */
+static void
+reload_files_model (PanelFileBrowserWidget * self)
+{
+  self->files_selection_model =
+    GTK_SINGLE_SELECTION (create_model_for_files (self));
+  gtk_list_view_set_model (
+    self->files_list_view,
+    GTK_SELECTION_MODEL (self->files_selection_model));
+  g_signal_connect (
+    G_OBJECT (self->files_selection_model),
+    "selection-changed",
+    G_CALLBACK (on_files_selection_changed), self);
+}
+
+/**
+ * Reloads the files if the index of the current
+ * location changed.
+ */
+static gboolean
+check_files_changed_cb (gpointer user_data)
+{
+  PanelFileBrowserWidget * self =
+    Z_PANEL_FILE_BROWSER_WIDGET (user_data);
+
+  if (
+    gtk_widget_get_mapped (GTK_WIDGET (self))
+    && file_manager_files_changed (FILE_MANAGER))
+    {
+      file_manager_load_files (FILE_MANAGER);
+      reload_files_model (self);
+    }
+
+  return G_SOURCE_CONTINUE;
+}
+
 static void
 on_bookmark_row_activated (
   GtkTreeView *            tree_view,
@@ -313,11 +358,7 @@ on_bookmark_row_activated (
   FileBrowserLocation * loc = g_value_get_pointer (&value);
 
   file_manager_set_selection (FILE_MANAGER, loc, true, true);
-  self->files_selection_model =
-    GTK_SINGLE_SELECTION (create_model_for_files (self));
-  gtk_list_view_set_model (
-    self->files_list_view,
-    GTK_SELECTION_MODEL (self->files_selection_model));
+  reload_files_model (self);
 }
 
 static void
@@ -325,9 +366,19 @@ on_file_search_changed (
   GtkSearchEntry *         search_entry,
   PanelFileBrowserWidget * self)
 {
-  gtk_filter_changed (
-    GTK_FILTER (self->files_filter),
-    GTK_FILTER_CHANGE_DIFFERENT);
+  /* search all indexed locations, or go back to
+   * the current location */
+  const char * text =
+    gtk_editable_get_text (GTK_EDITABLE (search_entry));
+  if (text && strlen (text) > 0)
+    {
+      file_manager_load_search_results (FILE_MANAGER, text);
+    }
+  else
+    {
+      file_manager_load_files (FILE_MANAGER);
+    }
+  reload_files_model (self);
 }
 
 static void
@@ -360,11 +411,7 @@ on_file_row_activated (
       loc->label = g_path_get_basename (loc->path);
       file_manager_set_selection (
         FILE_MANAGER, loc, true, true);
-      self->files_selection_model =
-        GTK_SINGLE_SELECTION (create_model_for_files (self));
-      gtk_list_view_set_model (
-        self->files_list_view,
-        GTK_SELECTION_MODEL (self->files_selection_model));
+      reload_files_model (self);
     }
   else if (
     descr->type == FILE_TYPE_WAV || descr->type == FILE_TYPE_OGG
@@ -430,7 +477,7 @@ on_files_selection_changed (
     return;
 
   char * label =
-    supported_file_get_info_text_for_label (descr);
+    file_manager_get_file_info_text (FILE_MANAGER, descr);
   g_message ("selected file: %s", descr->abs_path);
   update_file_info_label (self, label);
 
@@ -607,6 +654,9 @@ panel_file_browser_widget_new ()
     G_OBJECT (self->file_search_entry), "search-changed",
     G_CALLBACK (on_file_search_changed), self);
 
+  self->files_changed_source_id = g_timeout_add_seconds (
+    1, check_files_changed_cb, self);
+
   g_signal_connect (
     G_OBJECT (self), "map", G_CALLBACK (on_map), self);
   g_signal_connect (
@@ -630,6 +680,12 @@ panel_file_browser_widget_new ()
 static void
 dispose (PanelFileBrowserWidget * self)
 {
+  if (self->files_changed_source_id)
+    {
+      g_source_remove (self->files_changed_source_id);
+      self->files_changed_source_id = 0;
+    }
+
   gtk_widget_unparent (GTK_WIDGET (self->popover_menu));
 
   G_OBJECT_CLASS (panel_file_browser_widget_parent_class)
@@ -248,16 +248,9 @@ plugin_filter_func (GObject * item, gpointer user_data)
   midi_modifiers_active = gtk_toggle_button_get_active (
     self->toggle_midi_modifiers);
 
-  /* filter by name */
-  const char * text = gtk_editable_get_text (
-    GTK_EDITABLE (self->plugin_search_entry));
-  if (
-    text && strlen (text) > 0
-    && !string_contains_substr_case_insensitive (
-      descr->name, text))
-    {
-      return false;
-    }
+  /* filter by name, author and category */
+  if (!search_index_matches (self->search_index, descr))
+    return false;
 
   /* no filter, all visible */
   if (
@@ -915,6 +908,14 @@ create_model_for_plugins (PluginBrowserWidget * self)
           descr, WRAPPED_OBJECT_TYPE_PLUGIN_DESCR);
 
       g_list_store_append (store, wrapped_descr);
+
+      char * search_text = g_strdup_printf (
+        "%s\n%s\n%s", descr->name,
+        descr->author ? descr->author : "",
+        descr->category_str ? descr->category_str : "");
+      search_index_add (
+        self->search_index, descr, search_text);
+      g_free (search_text);
     }
 
   self->plugin_filter = gtk_custom_filter_new (
@@ -1274,9 +1275,30 @@ on_plugin_search_changed (
   GtkSearchEntry *      search_entry,
   PluginBrowserWidget * self)
 {
+  const char * text =
+    gtk_editable_get_text (GTK_EDITABLE (search_entry));
+  SearchIndexChange change =
+    search_index_set_query (self->search_index, text);
+
+  /* only re-check the visible plugins if the search
+   * got more strict */
+  GtkFilterChange filter_change;
+  switch (change)
+    {
+    case SEARCH_INDEX_CHANGE_NONE:
+      return;
+    case SEARCH_INDEX_CHANGE_MORE_STRICT:
+      filter_change = GTK_FILTER_CHANGE_MORE_STRICT;
+      break;
+    case SEARCH_INDEX_CHANGE_LESS_STRICT:
+      filter_change = GTK_FILTER_CHANGE_LESS_STRICT;
+      break;
+    default:
+      filter_change = GTK_FILTER_CHANGE_DIFFERENT;
+      break;
+    }
   gtk_filter_changed (
-    GTK_FILTER (self->plugin_filter),
-    GTK_FILTER_CHANGE_DIFFERENT);
+    GTK_FILTER (self->plugin_filter), filter_change);
 }
 
 static void
@@ -1292,6 +1314,8 @@ static void
 finalize (PluginBrowserWidget * self)
 {
   symap_free (self->symap);
+  object_free_w_func_and_null (
+    search_index_free, self->search_index);
 
   G_OBJECT_CLASS (plugin_browser_widget_parent_class)
     ->finalize (G_OBJECT (self));
@@ -1304,6 +1328,7 @@ plugin_browser_widget_new ()
     g_object_new (PLUGIN_BROWSER_WIDGET_TYPE, NULL);
 
   self->symap = symap_new ();
+  self->search_index = search_index_new ();
 
   gtk_label_set_xalign (self->plugin_info, 0);
 
@@ -33,6 +33,7 @@
 #include "utils/debug.h"
 #include "utils/flags.h"
 #include "utils/gtk.h"
+#include "utils/hash.h"
 #include "utils/math.h"
 #include "utils/objects.h"
 #include "utils/ui.h"
@@ -52,6 +53,13 @@ typedef enum RegionCounterpart
   REGION_COUNTERPART_LANE,
 } RegionCounterpart;
 
+/**
+ * Max relative difference between the width of the
+ * region and the width its content node was drawn
+ * at for the node to be scaled instead of redrawn.
+ */
+#define CONTENT_NODE_MAX_SCALE_DIFF 0.1
+
 /**
  * Recreates the pango layouts for drawing.
  *
@@ -814,6 +822,133 @@ draw_automation_region (
     }
 }
 
+/**
+ * Returns a hash of everything the drawn MIDI notes
+ * or automation depend on, apart from the size of
+ * the region.
+ */
+static guint64
+get_content_hash (ZRegion * self)
+{
+  ArrangerObject * obj = (ArrangerObject *) self;
+
+  guint64 hash = HASH_FNV1A_INIT;
+  double  length = arranger_object_get_length_in_ticks (obj);
+  HASH_FNV1A_VAL (hash, length);
+  HASH_FNV1A_VAL (hash, obj->loop_start_pos.ticks);
+  HASH_FNV1A_VAL (hash, obj->loop_end_pos.ticks);
+  HASH_FNV1A_VAL (hash, obj->clip_start_pos.ticks);
+
+  switch (self->id.type)
+    {
+    case REGION_TYPE_MIDI:
+      {
+        Track * track = arranger_object_get_track (obj);
+        bool    very_bright =
+          track && color_is_very_very_bright (&track->color);
+        HASH_FNV1A_VAL (hash, very_bright);
+        for (int i = 0; i < self->num_midi_notes; i++)
+          {
+            MidiNote *       mn = self->midi_notes[i];
+            ArrangerObject * mn_obj = (ArrangerObject *) mn;
+            bool             muted =
+              arranger_object_get_muted (mn_obj, false);
+            HASH_FNV1A_VAL (hash, mn_obj->pos.ticks);
+            HASH_FNV1A_VAL (hash, mn_obj->end_pos.ticks);
+            HASH_FNV1A_VAL (hash, mn->val);
+            HASH_FNV1A_VAL (hash, muted);
+          }
+      }
+      break;
+    case REGION_TYPE_AUTOMATION:
+      {
+        UiDetail detail = ui_get_detail_level ();
+        HASH_FNV1A_VAL (hash, detail);
+        for (int i = 0; i < self->num_aps; i++)
+          {
+            AutomationPoint * ap = self->aps[i];
+            ArrangerObject *  ap_obj = (ArrangerObject *) ap;
+            HASH_FNV1A_VAL (hash, ap_obj->pos.ticks);
+            HASH_FNV1A_VAL (hash, ap->normalized_val);
+            HASH_FNV1A_VAL (hash, ap->curve_opts.algo);
+            HASH_FNV1A_VAL (hash, ap->curve_opts.curviness);
+          }
+      }
+      break;
+    default:
+      break;
+    }
+
+  return hash;
+}
+
+/**
+ * Draws the MIDI notes or automation of the region
+ * from its cached render node.
+ *
+ * The node is redrawn only if the contents changed
+ * or the zoom level changed too much, otherwise it
+ * is scaled to the current width.
+ */
+static void
+draw_cached_contents (
+  ZRegion *         self,
+  GtkSnapshot *     snapshot,
+  RegionCounterpart counterpart,
+  GdkRectangle *    full_rect)
+{
+  guint64 hash = get_content_hash (self);
+  int     width = self->content_node_widths[counterpart];
+  double  scale =
+    width > 0 ? (double) full_rect->width / width : 0.0;
+  if (
+    width == 0
+    || hash != self->content_node_hashes[counterpart]
+    || full_rect->height
+         != self->content_node_heights[counterpart]
+    || fabs (scale - 1.0) > CONTENT_NODE_MAX_SCALE_DIFF)
+    {
+      /* draw everything so that the node can be
+       * reused when scrolling */
+      GtkSnapshot * content_snapshot = gtk_snapshot_new ();
+      switch (self->id.type)
+        {
+        case REGION_TYPE_MIDI:
+          draw_midi_region (
+            self, content_snapshot, full_rect, full_rect);
+          break;
+        case REGION_TYPE_AUTOMATION:
+          draw_automation_region (
+            self, content_snapshot, full_rect, full_rect);
+          break;
+        default:
+          break;
+        }
+
+      object_free_w_func_and_null (
+        gsk_render_node_unref,
+        self->content_nodes[counterpart]);
+      self->content_nodes[counterpart] =
+        gtk_snapshot_free_to_node (content_snapshot);
+      self->content_node_hashes[counterpart] = hash;
+      self->content_node_widths[counterpart] =
+        full_rect->width;
+      self->content_node_heights[counterpart] =
+        full_rect->height;
+      scale = 1.0;
+    }
+
+  /* nothing drawn */
+  GskRenderNode * node = self->content_nodes[counterpart];
+  if (!node)
+    return;
+
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_scale (snapshot, (float) scale, 1.f);
+  gtk_snapshot_append_node (snapshot, node);
+  gtk_snapshot_restore (snapshot);
+}
+
 /**
  * @param rect Arranger rectangle.
  * @param full_rect Arranger object rect.
@@ -1016,6 +1151,48 @@ draw_fade_part (
     } /* endif fade out visible */
 }
 
+/**
+ * Gets the min and max of the clip's frames in the
+ * given range by scanning them.
+ */
+static void
+get_min_max_from_frames (
+  AudioClip *    clip,
+  signed_frame_t start_frames,
+  signed_frame_t end_frames,
+  float *        min,
+  float *        max)
+{
+  for (signed_frame_t j = start_frames; j < end_frames; j++)
+    {
+      for (unsigned int k = 0; k < clip->channels; k++)
+        {
+          signed_frame_t index =
+            j * (signed_frame_t) clip->channels
+            + (signed_frame_t) k;
+
+          /* if outside bounds */
+          if (
+            index < 0
+            || index >= (signed_frame_t) clip->num_frames
+                          * (signed_frame_t) clip->channels)
+            {
+              /* skip */
+              continue;
+            }
+          float val = clip->frames[index];
+          if (val > *max)
+            {
+              *max = val;
+            }
+          if (val < *min)
+            {
+              *min = val;
+            }
+        }
+    }
+}
+
 static void
 draw_audio_part (
   ZRegion *      self,
@@ -1093,12 +1270,28 @@ draw_audio_part (
   /*position_from_frames (&tmp, curr_frames);*/
   /*position_print (&tmp);*/
 
-  GdkRGBA         color = object_fill_color;
-  graphene_rect_t grect =
-    GRAPHENE_RECT_INIT (0, 0, (float) width, 0);
-  for (double i = local_start_x; i < (double) local_end_x;
-       i += increment)
+  /* frame range and min/max of each column */
+  typedef struct AudioColumn
+  {
+    signed_frame_t start_frames;
+    signed_frame_t end_frames;
+    float          min;
+    float          max;
+    bool           have_peaks;
+  } AudioColumn;
+  size_t num_cols =
+    (size_t) ceil ((double) vis_width / increment);
+  AudioColumn * cols = object_new_n (num_cols, AudioColumn);
+
+  /* use the peak cache if ready, so that the
+   * frames don't need to be scanned when zoomed
+   * out (the peaks are only copied while the
+   * cache is acquired so that peak generation for
+   * other clips is not blocked while drawing) */
+  PeakCache * peaks = audio_clip_acquire_peaks (clip);
+  for (size_t j = 0; j < num_cols; j++)
     {
+      double i = local_start_x + (double) j * increment;
       curr_frames = (signed_frame_t) (multiplier * i);
       /* current single channel frames */
       curr_frames += clip_start_frames;
@@ -1108,34 +1301,36 @@ draw_audio_part (
           if (loop_frames == 0)
             break;
         }
-      float min = 0.f, max = 0.f;
-      for (signed_frame_t j = prev_frames; j < curr_frames; j++)
-        {
-          for (unsigned int k = 0; k < clip->channels; k++)
-            {
-              signed_frame_t index =
-                j * (signed_frame_t) clip->channels
-                + (signed_frame_t) k;
+      AudioColumn * col = &cols[j];
+      col->start_frames = prev_frames;
+      col->end_frames = curr_frames;
+      col->have_peaks =
+        peaks && prev_frames >= 0
+        && curr_frames > prev_frames
+        && peak_cache_get_min_max (
+          peaks, (unsigned_frame_t) prev_frames,
+          (unsigned_frame_t) curr_frames, &col->min,
+          &col->max);
 
-              /* if outside bounds */
-              if (
-                index < 0
-                || index >= (signed_frame_t) clip->num_frames
-                              * (signed_frame_t) clip->channels)
-                {
-                  /* skip */
-                  continue;
-                }
-              float val = clip->frames[index];
-              if (val > max)
-                {
-                  max = val;
-                }
-              if (val < min)
-                {
-                  min = val;
-                }
-            }
+      prev_frames = curr_frames;
+    }
+  audio_clip_release_peaks (clip);
+
+  GdkRGBA         color = object_fill_color;
+  graphene_rect_t grect =
+    GRAPHENE_RECT_INIT (0, 0, (float) width, 0);
+  for (size_t j = 0; j < num_cols; j++)
+    {
+      double i = local_start_x + (double) j * increment;
+      AudioColumn * col = &cols[j];
+      float         min = col->min, max = col->max;
+      if (!col->have_peaks)
+        {
+          min = 0.f;
+          max = 0.f;
+          get_min_max_from_frames (
+            clip, col->start_frames, col->end_frames, &min,
+            &max);
         }
 
       /* normalize */
@@ -1159,9 +1354,9 @@ draw_audio_part (
             (float) (local_max_y - local_min_y);
           gtk_snapshot_append_color (snapshot, &color, &grect);
         }
-
-      prev_frames = curr_frames;
     }
+
+  g_free (cols);
 }
 
 /**
@@ -1456,12 +1651,10 @@ region_draw (
       switch (self->id.type)
         {
         case REGION_TYPE_MIDI:
-          draw_midi_region (
-            self, snapshot, &full_rect, &draw_rect);
-          break;
         case REGION_TYPE_AUTOMATION:
-          draw_automation_region (
-            self, snapshot, &full_rect, &draw_rect);
+          draw_cached_contents (
+            self, snapshot, (RegionCounterpart) i,
+            &full_rect);
           break;
         case REGION_TYPE_CHORD:
           draw_chord_region (
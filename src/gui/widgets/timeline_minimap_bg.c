@@ -4,6 +4,7 @@
 #include "audio/marker_track.h"
 #include "audio/track.h"
 #include "audio/tracklist.h"
+#include "gui/backend/arranger_object.h"
 #include "gui/widgets/center_dock.h"
 #include "gui/widgets/main_notebook.h"
 #include "gui/widgets/main_window.h"
@@ -11,6 +12,8 @@
 #include "gui/widgets/timeline_minimap_bg.h"
 #include "gui/widgets/timeline_panel.h"
 #include "project.h"
+#include "utils/gtk.h"
+#include "utils/hash.h"
 #include "zrythm_app.h"
 
 #include <gtk/gtk.h>
@@ -21,25 +24,11 @@ G_DEFINE_TYPE (
   GTK_TYPE_WIDGET)
 
 static void
-timeline_minimap_bg_snapshot (
-  GtkWidget *   widget,
-  GtkSnapshot * snapshot)
+draw_regions (GtkWidget * widget, GtkSnapshot * snapshot)
 {
-  /*TimelineMinimapBgWidget * self =*/
-  /*Z_TIMELINE_MINIMAP_BG_WIDGET (widget);*/
-
   int width = gtk_widget_get_allocated_width (widget);
   int height = gtk_widget_get_allocated_height (widget);
 
-  GtkStyleContext * context =
-    gtk_widget_get_style_context (widget);
-
-  gtk_snapshot_render_background (
-    snapshot, context, 0, 0, width, height);
-
-  if (!PROJECT->loaded)
-    return;
-
   Marker * start =
     marker_track_get_start_marker (P_MARKER_TRACK);
   ArrangerObject * start_obj = (ArrangerObject *) start;
@@ -109,13 +98,76 @@ timeline_minimap_bg_snapshot (
     }
 }
 
+static void
+timeline_minimap_bg_snapshot (
+  GtkWidget *   widget,
+  GtkSnapshot * snapshot)
+{
+  int width = gtk_widget_get_allocated_width (widget);
+  int height = gtk_widget_get_allocated_height (widget);
+
+  GtkStyleContext * context =
+    gtk_widget_get_style_context (widget);
+
+  gtk_snapshot_render_background (
+    snapshot, context, 0, 0, width, height);
+
+  if (PROJECT->loaded)
+    {
+      draw_regions (widget, snapshot);
+    }
+
+  z_gtk_widget_snapshot_redraw_count (widget, snapshot);
+}
+
+/**
+ * Returns a hash of everything drawn apart from the
+ * size of the widget.
+ */
+static guint64
+get_draw_version (void)
+{
+  guint64 hash = HASH_FNV1A_INIT;
+  if (!PROJECT->loaded)
+    return hash;
+
+  unsigned int positions_generation =
+    arranger_object_get_positions_generation ();
+  HASH_FNV1A_VAL (hash, positions_generation);
+  for (int i = 0; i < TRACKLIST->num_tracks; i++)
+    {
+      Track * track = TRACKLIST->tracks[i];
+      if (!track->widget || !track->visible)
+        continue;
+
+      double wy;
+      gtk_widget_translate_coordinates (
+        GTK_WIDGET (track->widget), GTK_WIDGET (MW_TIMELINE),
+        0, 0, NULL, &wy);
+      int track_height = gtk_widget_get_allocated_height (
+        GTK_WIDGET (track->widget));
+      HASH_FNV1A_VAL (hash, i);
+      HASH_FNV1A_VAL (hash, wy);
+      HASH_FNV1A_VAL (hash, track_height);
+      HASH_FNV1A_VAL (hash, track->color);
+    }
+
+  return hash;
+}
+
 static gboolean
 timeline_minimap_bg_tick_cb (
   GtkWidget *     widget,
   GdkFrameClock * frame_clock,
   gpointer        user_data)
 {
-  gtk_widget_queue_draw (widget);
+  if (!gtk_widget_get_mapped (widget))
+    {
+      return G_SOURCE_CONTINUE;
+    }
+
+  z_gtk_widget_queue_draw_if_changed (
+    widget, get_draw_version ());
 
   return G_SOURCE_CONTINUE;
 }
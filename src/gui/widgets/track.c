@@ -1730,12 +1730,90 @@ track_tick_cb (
       return G_SOURCE_CONTINUE;
     }
 
-  track_widget_redraw_meters (self);
-  gtk_widget_queue_draw (GTK_WIDGET (self->canvas));
+  /* the meters redraw themselves when their values
+   * change */
+  z_gtk_widget_queue_draw_if_changed (
+    GTK_WIDGET (self->canvas),
+    track_canvas_widget_get_draw_version (self->canvas));
 
   return G_SOURCE_CONTINUE;
 }
 
+static void
+setup_meters (TrackWidget * self)
+{
+  Track * track = self->track;
+  if (track_type_has_channel (track->type))
+    {
+      switch (track->out_signal_type)
+        {
+        case TYPE_EVENT:
+          meter_widget_setup (
+            self->meter_l, track->channel->midi_out, 8);
+          gtk_widget_set_margin_start (
+            GTK_WIDGET (self->meter_l), 2);
+          gtk_widget_set_margin_end (
+            GTK_WIDGET (self->meter_l), 2);
+          self->meter_l->padding = 0;
+          gtk_widget_set_visible (
+            GTK_WIDGET (self->meter_r), 0);
+          break;
+        case TYPE_AUDIO:
+          meter_widget_setup (
+            self->meter_l,
+            track->channel->stereo_out->l, 6);
+          self->meter_l->padding = 0;
+          meter_widget_setup (
+            self->meter_r,
+            track->channel->stereo_out->r, 6);
+          self->meter_r->padding = 0;
+          break;
+        default:
+          break;
+        }
+    }
+
+  self->meters_set_up = true;
+}
+
+/**
+ * Sets whether the track is in the visible part of
+ * the tracklist, which starts or stops the meters
+ * and animations.
+ *
+ * Meters are set up the first time the track comes
+ * into view.
+ */
+void
+track_widget_set_in_view (TrackWidget * self, bool in_view)
+{
+  if (self->in_view == in_view)
+    return;
+
+  if (in_view)
+    {
+      if (!self->meters_set_up)
+        {
+          setup_meters (self);
+        }
+      self->tick_cb_id = gtk_widget_add_tick_callback (
+        GTK_WIDGET (self), (GtkTickCallback) track_tick_cb,
+        self, NULL);
+    }
+  else
+    {
+      gtk_widget_remove_tick_callback (
+        GTK_WIDGET (self), self->tick_cb_id);
+      self->tick_cb_id = 0;
+    }
+  if (self->meters_set_up)
+    {
+      meter_widget_set_active (self->meter_l, in_view);
+      meter_widget_set_active (self->meter_r, in_view);
+    }
+  self->in_view = in_view;
+}
+
 /**
  * Wrapper for child track widget.
  *
@@ -1857,36 +1935,7 @@ track_widget_new (Track * track)
       break;
     }
 
-  if (track_type_has_channel (track->type))
-    {
-      switch (track->out_signal_type)
-        {
-        case TYPE_EVENT:
-          meter_widget_setup (
-            self->meter_l, self->track->channel->midi_out, 8);
-          gtk_widget_set_margin_start (
-            GTK_WIDGET (self->meter_l), 2);
-          gtk_widget_set_margin_end (
-            GTK_WIDGET (self->meter_l), 2);
-          self->meter_l->padding = 0;
-          gtk_widget_set_visible (
-            GTK_WIDGET (self->meter_r), 0);
-          break;
-        case TYPE_AUDIO:
-          meter_widget_setup (
-            self->meter_l,
-            self->track->channel->stereo_out->l, 6);
-          self->meter_l->padding = 0;
-          meter_widget_setup (
-            self->meter_r,
-            self->track->channel->stereo_out->r, 6);
-          self->meter_r->padding = 0;
-          break;
-        default:
-          break;
-        }
-    }
-  else
+  if (!track_type_has_channel (track->type))
     {
       gtk_widget_set_visible (GTK_WIDGET (self->meter_l), 0);
       gtk_widget_set_visible (GTK_WIDGET (self->meter_r), 0);
@@ -1896,10 +1945,6 @@ track_widget_new (Track * track)
 
   track_widget_update_size (self);
 
-  gtk_widget_add_tick_callback (
-    GTK_WIDGET (self), (GtkTickCallback) track_tick_cb, self,
-    NULL);
-
   track_canvas_widget_setup (self->canvas, self);
 
   return self;
@@ -10,6 +10,7 @@
 #include "gui/widgets/track_canvas.h"
 #include "utils/color.h"
 #include "utils/gtk.h"
+#include "utils/hash.h"
 #include "utils/objects.h"
 #include "utils/string.h"
 #include "utils/ui.h"
@@ -204,6 +205,98 @@ draw_name (
     snapshot, context, 22, 2, layout);
 }
 
+/**
+ * Returns the state to draw a top or bottom track
+ * button in.
+ */
+static CustomButtonWidgetState
+get_button_state (
+  TrackWidget *        tw,
+  CustomButtonWidget * cb,
+  CustomButtonWidget * hovered_cb)
+{
+  Track * track = tw->track;
+
+  CustomButtonWidgetState state =
+    CUSTOM_BUTTON_WIDGET_STATE_NORMAL;
+
+  bool is_solo = TRACK_CB_ICON_IS (SOLO);
+
+  if (cb == tw->clicked_button)
+    {
+      /* currently clicked button */
+      state = CUSTOM_BUTTON_WIDGET_STATE_ACTIVE;
+    }
+  else if (is_solo && track_get_soloed (track))
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (is_solo && track_get_implied_soloed (track))
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_SEMI_TOGGLED;
+    }
+  else if (
+    TRACK_CB_ICON_IS (SHOW_UI)
+    && instrument_track_is_plugin_visible (track))
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (TRACK_CB_ICON_IS (MUTE) && track_get_muted (track))
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (
+    TRACK_CB_ICON_IS (LISTEN)
+    && track_get_listened (track))
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (
+    TRACK_CB_ICON_IS (MONITOR_AUDIO)
+    && track_get_monitor_audio (track))
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (TRACK_CB_ICON_IS (FREEZE) && track->frozen)
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (
+    TRACK_CB_ICON_IS (MONO_COMPAT)
+    && channel_get_mono_compat_enabled (track->channel))
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (
+    TRACK_CB_ICON_IS (RECORD)
+    && track_get_recording (track))
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (
+    TRACK_CB_ICON_IS (SHOW_TRACK_LANES)
+    && track->lanes_visible)
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (
+    TRACK_CB_ICON_IS (SHOW_AUTOMATION_LANES)
+    && track->automation_visible)
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (TRACK_CB_ICON_IS (FOLD_OPEN))
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
+    }
+  else if (hovered_cb == cb)
+    {
+      state = CUSTOM_BUTTON_WIDGET_STATE_HOVERED;
+    }
+
+  return state;
+}
+
 /**
  * @param top 1 to draw top, 0 to draw bottom.
  * @param width Track width.
@@ -249,81 +342,7 @@ draw_buttons (
         }
 
       CustomButtonWidgetState state =
-        CUSTOM_BUTTON_WIDGET_STATE_NORMAL;
-
-      bool is_solo = TRACK_CB_ICON_IS (SOLO);
-
-      if (cb == tw->clicked_button)
-        {
-          /* currently clicked button */
-          state = CUSTOM_BUTTON_WIDGET_STATE_ACTIVE;
-        }
-      else if (is_solo && track_get_soloed (track))
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (is_solo && track_get_implied_soloed (track))
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_SEMI_TOGGLED;
-        }
-      else if (
-        TRACK_CB_ICON_IS (SHOW_UI)
-        && instrument_track_is_plugin_visible (track))
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (TRACK_CB_ICON_IS (MUTE) && track_get_muted (track))
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (
-        TRACK_CB_ICON_IS (LISTEN)
-        && track_get_listened (track))
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (
-        TRACK_CB_ICON_IS (MONITOR_AUDIO)
-        && track_get_monitor_audio (track))
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (TRACK_CB_ICON_IS (FREEZE) && track->frozen)
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (
-        TRACK_CB_ICON_IS (MONO_COMPAT)
-        && channel_get_mono_compat_enabled (track->channel))
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (
-        TRACK_CB_ICON_IS (RECORD)
-        && track_get_recording (track))
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (
-        TRACK_CB_ICON_IS (SHOW_TRACK_LANES)
-        && track->lanes_visible)
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (
-        TRACK_CB_ICON_IS (SHOW_AUTOMATION_LANES)
-        && track->automation_visible)
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (TRACK_CB_ICON_IS (FOLD_OPEN))
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_TOGGLED;
-        }
-      else if (hovered_cb == cb)
-        {
-          state = CUSTOM_BUTTON_WIDGET_STATE_HOVERED;
-        }
+        get_button_state (tw, cb, hovered_cb);
 
       custom_button_widget_draw (
         cb, snapshot, cb->x, cb->y, state);
@@ -775,6 +794,128 @@ track_canvas_snapshot (
 
   self->last_width = width;
   self->last_height = height;
+
+  z_gtk_widget_snapshot_redraw_count (widget, snapshot);
+}
+
+static guint64
+hash_str (guint64 hash, const char * str)
+{
+  if (!str)
+    return hash;
+
+  return hash_fnv1a (hash, str, strlen (str) + 1);
+}
+
+/**
+ * Hashes the automation track headers drawn by
+ * draw_automation().
+ */
+static guint64
+hash_automation (Track * track, guint64 hash)
+{
+  AutomationTracklist * atl =
+    track_get_automation_tracklist (track);
+  if (!atl)
+    return hash;
+
+  for (int i = 0; i < atl->num_ats; i++)
+    {
+      AutomationTrack * at = atl->ats[i];
+      if (!(at->created && at->visible))
+        continue;
+
+      Port * port = port_find_from_identifier (&at->port_id);
+      float  val = port ? control_port_get_val (port) : 0.f;
+      HASH_FNV1A_VAL (hash, i);
+      HASH_FNV1A_VAL (hash, at->height);
+      HASH_FNV1A_VAL (hash, at->automation_mode);
+      HASH_FNV1A_VAL (hash, at->record_mode);
+      HASH_FNV1A_VAL (hash, val);
+    }
+
+  return hash;
+}
+
+guint64
+track_canvas_widget_get_draw_version (
+  TrackCanvasWidget * self)
+{
+  TrackWidget * tw = self->parent;
+  Track *       track = tw->track;
+  guint64       hash = HASH_FNV1A_INIT;
+  if (!track)
+    return hash;
+
+  bool enabled = track_is_enabled (track);
+  bool selected = track_is_selected (track);
+  hash = hash_str (hash, track->name);
+  hash = hash_str (hash, track->icon_name);
+  HASH_FNV1A_VAL (hash, track->color);
+  HASH_FNV1A_VAL (hash, track->pos);
+  HASH_FNV1A_VAL (hash, track->size);
+  HASH_FNV1A_VAL (hash, track->main_height);
+  HASH_FNV1A_VAL (hash, track->lanes_visible);
+  HASH_FNV1A_VAL (hash, track->automation_visible);
+  HASH_FNV1A_VAL (hash, enabled);
+  HASH_FNV1A_VAL (hash, selected);
+
+  /* hover and click state */
+  CustomButtonWidget * hovered_cb =
+    track_widget_get_hovered_button (
+      tw, (int) tw->last_x, (int) tw->last_y);
+  AutomationModeWidget * hovered_am =
+    track_widget_get_hovered_am_widget (
+      tw, (int) tw->last_x, (int) tw->last_y);
+  HASH_FNV1A_VAL (hash, tw->bg_hovered);
+  HASH_FNV1A_VAL (hash, tw->color_area_hovered);
+  HASH_FNV1A_VAL (hash, tw->icon_hovered);
+  HASH_FNV1A_VAL (hash, tw->clicked_button);
+  HASH_FNV1A_VAL (hash, tw->clicked_am);
+  HASH_FNV1A_VAL (hash, hovered_cb);
+  HASH_FNV1A_VAL (hash, hovered_am);
+  if (hovered_am || tw->clicked_am)
+    {
+      /* the hovered automation mode depends on the
+       * x position */
+      HASH_FNV1A_VAL (hash, tw->last_x);
+    }
+
+  /* button states */
+  for (int i = 0; i < tw->num_top_buttons; i++)
+    {
+      CustomButtonWidgetState state = get_button_state (
+        tw, tw->top_buttons[i], hovered_cb);
+      HASH_FNV1A_VAL (hash, state);
+    }
+  if (TRACK_BOT_BUTTONS_SHOULD_BE_VISIBLE (track->main_height))
+    {
+      for (int i = 0; i < tw->num_bot_buttons; i++)
+        {
+          CustomButtonWidgetState state = get_button_state (
+            tw, tw->bot_buttons[i], hovered_cb);
+          HASH_FNV1A_VAL (hash, state);
+        }
+    }
+
+  if (track->lanes_visible)
+    {
+      for (int i = 0; i < track->num_lanes; i++)
+        {
+          TrackLane * lane = track->lanes[i];
+          hash = hash_str (hash, lane->name);
+          HASH_FNV1A_VAL (hash, lane->height);
+          HASH_FNV1A_VAL (hash, lane->solo);
+          HASH_FNV1A_VAL (hash, lane->mute);
+        }
+    }
+
+  if (track->automation_visible)
+    {
+      hash = hash_automation (track, hash);
+    }
+
+  return hash;
 }
 
 void
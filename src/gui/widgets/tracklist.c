@@ -395,6 +395,90 @@ refresh_track_widget (Track * track)
   track_widget_update_size (track->widget);
 }
 
+/**
+ * Starts the meters and animations of the tracks in
+ * the visible part of the tracklist and stops the
+ * others.
+ */
+void
+tracklist_widget_update_tracks_in_view (
+  TracklistWidget * self)
+{
+  if (!self->tracklist)
+    return;
+
+  GtkAdjustment * vadj =
+    gtk_scrolled_window_get_vadjustment (
+      self->unpinned_scroll);
+  double start = gtk_adjustment_get_value (vadj);
+  double end = start + gtk_adjustment_get_page_size (vadj);
+  for (int i = 0; i < self->tracklist->num_tracks; i++)
+    {
+      Track *       track = self->tracklist->tracks[i];
+      TrackWidget * tw = track->widget;
+      if (!Z_IS_TRACK_WIDGET (tw))
+        continue;
+
+      bool in_view = gtk_widget_get_visible (GTK_WIDGET (tw));
+      if (in_view && !track_is_pinned (track))
+        {
+          graphene_rect_t bounds;
+          in_view =
+            gtk_widget_compute_bounds (
+              GTK_WIDGET (tw),
+              GTK_WIDGET (self->unpinned_box), &bounds)
+            && bounds.size.height > 0
+            && bounds.origin.y + bounds.size.height >= start
+            && bounds.origin.y <= end;
+        }
+      track_widget_set_in_view (tw, in_view);
+    }
+}
+
+static gboolean
+update_tracks_in_view_tick_cb (
+  GtkWidget *       widget,
+  GdkFrameClock *   frame_clock,
+  TracklistWidget * self)
+{
+  tracklist_widget_update_tracks_in_view (self);
+
+  if (--self->in_view_ticks_left > 0)
+    return G_SOURCE_CONTINUE;
+
+  self->in_view_tick_cb_id = 0;
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * Updates the tracks in view on the next 2 frames.
+ *
+ * Used after adding tracks, which only get their
+ * positions in the layout phase after the first
+ * tick.
+ */
+static void
+queue_update_tracks_in_view (TracklistWidget * self)
+{
+  self->in_view_ticks_left = 2;
+  if (self->in_view_tick_cb_id == 0)
+    {
+      self->in_view_tick_cb_id =
+        gtk_widget_add_tick_callback (
+          GTK_WIDGET (self),
+          (GtkTickCallback) update_tracks_in_view_tick_cb,
+          self, NULL);
+    }
+}
+
+static void
+on_vadj_changed (
+  GtkAdjustment *   vadj,
+  TracklistWidget * self)
+{
+  tracklist_widget_update_tracks_in_view (self);
+}
+
 /**
  * Refreshes each track without recreating it.
  */
@@ -407,6 +491,8 @@ tracklist_widget_soft_refresh (TracklistWidget * self)
       Track * track = self->tracklist->tracks[i];
       refresh_track_widget (track);
     }
+
+  queue_update_tracks_in_view (self);
 }
 
 /**
@@ -461,6 +547,8 @@ tracklist_widget_hard_refresh (TracklistWidget * self)
   g_object_unref (self->channel_add);
   g_object_unref (self->ddbox);
 
+  queue_update_tracks_in_view (self);
+
   g_debug ("done hard refreshing tracklist");
 }
 
@@ -486,6 +574,8 @@ tracklist_widget_update_track_visibility (
       track_widget_update_icons (track->widget);
       track_widget_update_size (track->widget);
     }
+
+  queue_update_tracks_in_view (self);
 }
 
 void
@@ -577,6 +667,17 @@ tracklist_widget_init (TracklistWidget * self)
     GTK_SCROLLED_WINDOW (self->unpinned_scroll),
     GTK_WIDGET (viewport));
 
+  /* only run the meters and animations of the
+   * tracks in view */
+  GtkAdjustment * vadj =
+    gtk_scrolled_window_get_vadjustment (
+      self->unpinned_scroll);
+  g_signal_connect (
+    vadj, "value-changed", G_CALLBACK (on_vadj_changed),
+    self);
+  g_signal_connect (
+    vadj, "changed", G_CALLBACK (on_vadj_changed), self);
+
   /* create the drag dest box and bump its reference
    * so it doesn't get deleted. */
   self->ddbox = drag_dest_box_widget_new (
@@ -2,11 +2,14 @@
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
 #include "plugins/cached_plugin_descriptors.h"
+#include "utils/arrays.h"
 #include "utils/file.h"
 #include "utils/objects.h"
 #include "utils/string.h"
 #include "zrythm.h"
 
+#include <glib/gstdio.h>
+
 static char *
 get_cached_plugin_descriptors_file_path (void)
 {
@@ -66,6 +69,273 @@ is_yaml_our_version (const char * yaml)
   return same_version;
 }
 
+/**
+ * Returns the key to index the given descriptor
+ * with (the URI for LV2, the path otherwise).
+ */
+static const char *
+get_descr_key (const PluginDescriptor * descr)
+{
+  if (descr->protocol == PROT_LV2 || !descr->path)
+    return descr->uri;
+  else
+    return descr->path;
+}
+
+/**
+ * Gets the current modification time and size of
+ * the given file or directory.
+ *
+ * @return Whether successful.
+ */
+static bool
+get_path_stamp (
+  const char * path,
+  int64_t *    mtime,
+  int64_t *    size)
+{
+  GStatBuf st;
+  if (!path || g_stat (path, &st) != 0)
+    return false;
+
+#if defined(__APPLE__)
+  *mtime =
+    (int64_t) st.st_mtimespec.tv_sec * G_USEC_PER_SEC
+    + (int64_t) st.st_mtimespec.tv_nsec / 1000;
+#elif defined(_WOE32)
+  /* only whole seconds are available */
+  *mtime = (int64_t) st.st_mtime * G_USEC_PER_SEC;
+#else
+  *mtime = (int64_t) st.st_mtim.tv_sec * G_USEC_PER_SEC
+           + (int64_t) st.st_mtim.tv_nsec / 1000;
+#endif
+  *size = (int64_t) st.st_size;
+  return true;
+}
+
+/**
+ * Gets the current stamp of an LV2 bundle.
+ *
+ * Files in a bundle are normally replaced (not
+ * edited in place) when it is updated, which
+ * changes the modification time of the bundle
+ * directory, so checking the directory and the
+ * manifest is enough.
+ */
+static bool
+get_lv2_bundle_stamp (
+  const char * bundle_path,
+  int64_t *    mtime,
+  int64_t *    size)
+{
+  int64_t dir_mtime, dir_size;
+  if (!get_path_stamp (bundle_path, &dir_mtime, &dir_size))
+    return false;
+
+  char * manifest =
+    g_build_filename (bundle_path, "manifest.ttl", NULL);
+  bool ret = get_path_stamp (manifest, mtime, size);
+  g_free (manifest);
+  if (!ret)
+    return false;
+
+  *mtime = MAX (*mtime, dir_mtime);
+  return true;
+}
+
+static bool
+stamp_matches (
+  CachedPluginDescriptors * self,
+  const char *              key,
+  int64_t                   mtime,
+  int64_t                   size)
+{
+  const PluginFileStamp * stamp =
+    (const PluginFileStamp *) g_hash_table_lookup (
+      self->stamps_ht, key);
+  return stamp && stamp->mtime == mtime
+         && stamp->size == size;
+}
+
+static void
+set_stamp (
+  CachedPluginDescriptors * self,
+  const char *              key,
+  int64_t                   mtime,
+  int64_t                   size)
+{
+  PluginFileStamp * stamp = (PluginFileStamp *)
+    g_hash_table_lookup (self->stamps_ht, key);
+  if (!stamp)
+    {
+      stamp = object_new (PluginFileStamp);
+      stamp->key = g_strdup (key);
+      array_double_size_if_full (
+        self->stamps, self->num_stamps, self->stamps_size,
+        PluginFileStamp *);
+      self->stamps[self->num_stamps++] = stamp;
+      g_hash_table_insert (
+        self->stamps_ht, stamp->key, stamp);
+    }
+  stamp->mtime = mtime;
+  stamp->size = size;
+}
+
+/**
+ * Stores the current stamp of the file at @p path.
+ */
+static void
+stamp_path (CachedPluginDescriptors * self, const char * path)
+{
+  int64_t mtime, size;
+  if (get_path_stamp (path, &mtime, &size))
+    {
+      set_stamp (self, path, mtime, size);
+    }
+}
+
+/**
+ * Returns whether the file at @p path is unchanged
+ * since it was last stamped.
+ */
+static bool
+is_path_unchanged (
+  CachedPluginDescriptors * self,
+  const char *              path)
+{
+  int64_t mtime, size;
+  return get_path_stamp (path, &mtime, &size)
+         && stamp_matches (self, path, mtime, size);
+}
+
+static void
+index_descriptor (
+  CachedPluginDescriptors * self,
+  PluginDescriptor *        descr)
+{
+  const char * key = get_descr_key (descr);
+  if (!key)
+    return;
+
+  GPtrArray * arr = (GPtrArray *) g_hash_table_lookup (
+    self->descriptors_ht, key);
+  if (!arr)
+    {
+      arr = g_ptr_array_new ();
+      g_hash_table_insert (
+        self->descriptors_ht, g_strdup (key), arr);
+    }
+  g_ptr_array_add (arr, descr);
+}
+
+/**
+ * (Re)builds the lookup tables from the arrays.
+ */
+static void
+rebuild_indices (CachedPluginDescriptors * self)
+{
+  object_free_w_func_and_null (
+    g_hash_table_unref, self->descriptors_ht);
+  object_free_w_func_and_null (
+    g_hash_table_unref, self->blacklisted_ht);
+  object_free_w_func_and_null (
+    g_hash_table_unref, self->stamps_ht);
+
+  self->descriptors_ht = g_hash_table_new_full (
+    g_str_hash, g_str_equal, g_free,
+    (GDestroyNotify) g_ptr_array_unref);
+  self->blacklisted_ht = g_hash_table_new_full (
+    g_str_hash, g_str_equal, g_free, NULL);
+  self->stamps_ht =
+    g_hash_table_new (g_str_hash, g_str_equal);
+
+  for (int i = 0; i < self->num_descriptors; i++)
+    {
+      index_descriptor (self, self->descriptors[i]);
+    }
+  for (int i = 0; i < self->num_blacklisted; i++)
+    {
+      PluginDescriptor * descr = self->blacklisted[i];
+      if (descr->path)
+        {
+          g_hash_table_insert (
+            self->blacklisted_ht, g_strdup (descr->path),
+            descr);
+        }
+    }
+  for (int i = 0; i < self->num_stamps; i++)
+    {
+      PluginFileStamp * stamp = self->stamps[i];
+      g_hash_table_insert (
+        self->stamps_ht, stamp->key, stamp);
+    }
+}
+
+/**
+ * Removes the (stale) valid descriptors with the
+ * given key.
+ */
+static void
+remove_descriptors_with_key (
+  CachedPluginDescriptors * self,
+  const char *              key)
+{
+  GPtrArray * arr = (GPtrArray *) g_hash_table_lookup (
+    self->descriptors_ht, key);
+  if (!arr)
+    return;
+
+  for (size_t i = 0; i < arr->len; i++)
+    {
+      PluginDescriptor * descr =
+        (PluginDescriptor *) g_ptr_array_index (arr, i);
+      for (int j = 0; j < self->num_descriptors; j++)
+        {
+          if (self->descriptors[j] != descr)
+            continue;
+
+          for (int k = j; k < self->num_descriptors - 1; k++)
+            {
+              self->descriptors[k] = self->descriptors[k + 1];
+            }
+          self->num_descriptors--;
+          break;
+        }
+      plugin_descriptor_free (descr);
+    }
+  g_hash_table_remove (self->descriptors_ht, key);
+}
+
+/**
+ * Removes the (stale) blacklisted descriptor for
+ * the given path.
+ */
+static void
+remove_blacklisted_with_path (
+  CachedPluginDescriptors * self,
+  const char *              path)
+{
+  PluginDescriptor * descr = (PluginDescriptor *)
+    g_hash_table_lookup (self->blacklisted_ht, path);
+  if (!descr)
+    return;
+
+  for (int j = 0; j < self->num_blacklisted; j++)
+    {
+      if (self->blacklisted[j] != descr)
+        continue;
+
+      for (int k = j; k < self->num_blacklisted - 1; k++)
+        {
+          self->blacklisted[k] = self->blacklisted[k + 1];
+        }
+      self->num_blacklisted--;
+      break;
+    }
+  g_hash_table_remove (self->blacklisted_ht, path);
+  plugin_descriptor_free (descr);
+}
+
 /**
  * Reads the file and fills up the object.
  */
@@ -86,6 +356,7 @@ return_new_instance:
         object_new (CachedPluginDescriptors);
       self->schema_version =
         CACHED_PLUGIN_DESCRIPTORS_SCHEMA_VERSION;
+      rebuild_indices (self);
       return self;
     }
   char * yaml = NULL;
@@ -139,6 +410,9 @@ return_new_instance:
         ->category = plugin_descriptor_string_to_category (
         self->descriptors[i]->category_str);
     }
+  self->stamps_size = (size_t) self->num_stamps;
+
+  rebuild_indices (self);
 
   return self;
 }
@@ -167,20 +441,20 @@ cached_plugin_descriptors_is_blacklisted (
   CachedPluginDescriptors * self,
   const char *              abs_path)
 {
-  for (int i = 0; i < self->num_blacklisted; i++)
+  if (!g_hash_table_contains (self->blacklisted_ht, abs_path))
+    return 0;
+
+  /* give plugins that changed since they were
+   * blacklisted another chance */
+  if (!is_path_unchanged (self, abs_path))
     {
-      PluginDescriptor * descr = self->blacklisted[i];
-      GFile * file = g_file_new_for_path (descr->path);
-      if (
-        string_is_equal (descr->path, abs_path)
-        && descr->ghash == g_file_hash (file))
-        {
-          g_object_unref (file);
-          return 1;
-        }
-      g_object_unref (file);
+      g_message (
+        "%s changed since it was blacklisted", abs_path);
+      remove_blacklisted_with_path (self, abs_path);
+      return 0;
     }
-  return 0;
+
+  return 1;
 }
 
 /**
@@ -201,11 +475,18 @@ cached_plugin_descriptors_find (
   bool                      check_valid,
   bool                      check_blacklisted)
 {
+  const char * key = get_descr_key (descr);
+  if (!key)
+    return NULL;
+
   if (check_valid)
     {
-      for (int i = 0; i < self->num_descriptors; i++)
+      GPtrArray * arr = (GPtrArray *) g_hash_table_lookup (
+        self->descriptors_ht, key);
+      for (size_t i = 0; arr && i < arr->len; i++)
         {
-          PluginDescriptor * cur_descr = self->descriptors[i];
+          PluginDescriptor * cur_descr =
+            (PluginDescriptor *) g_ptr_array_index (arr, i);
           if (plugin_descriptor_is_same_plugin (
                 cur_descr, descr))
             {
@@ -213,26 +494,81 @@ cached_plugin_descriptors_find (
             }
         }
     }
-  if (check_blacklisted)
+  if (check_blacklisted && descr->path)
     {
-      for (int i = 0; i < self->num_blacklisted; i++)
+      PluginDescriptor * cur_descr = (PluginDescriptor *)
+        g_hash_table_lookup (
+          self->blacklisted_ht, descr->path);
+      if (
+        cur_descr
+        && plugin_descriptor_is_same_plugin (
+          cur_descr, descr))
         {
-          PluginDescriptor * cur_descr = self->blacklisted[i];
-          if (plugin_descriptor_is_same_plugin (
-                cur_descr, descr))
-            {
-              return cur_descr;
-            }
+          return cur_descr;
         }
     }
 
   return NULL;
 }
 
+/**
+ * Returns the cached descriptor for the given LV2
+ * plugin URI if the bundle at @p bundle_path has
+ * not changed since it was cached.
+ *
+ * This allows skipping
+ * lv2_plugin_create_descriptor_from_lilv() for
+ * unchanged bundles.
+ *
+ * @return The cached descriptor (not to be free'd)
+ *   or NULL.
+ */
+const PluginDescriptor *
+cached_plugin_descriptors_get_lv2 (
+  CachedPluginDescriptors * self,
+  const char *              uri,
+  const char *              bundle_path)
+{
+  GPtrArray * arr = (GPtrArray *) g_hash_table_lookup (
+    self->descriptors_ht, uri);
+  if (!arr || arr->len == 0)
+    return NULL;
+
+  int64_t mtime, size;
+  if (
+    !get_lv2_bundle_stamp (bundle_path, &mtime, &size)
+    || !stamp_matches (self, uri, mtime, size))
+    {
+      g_debug ("LV2 bundle %s changed", bundle_path);
+      return NULL;
+    }
+
+  return (const PluginDescriptor *) g_ptr_array_index (
+    arr, 0);
+}
+
+/**
+ * Stores the current modification stamp of the
+ * given LV2 bundle for the given plugin URI.
+ */
+void
+cached_plugin_descriptors_stamp_lv2 (
+  CachedPluginDescriptors * self,
+  const char *              uri,
+  const char *              bundle_path)
+{
+  int64_t mtime, size;
+  if (get_lv2_bundle_stamp (bundle_path, &mtime, &size))
+    {
+      set_stamp (self, uri, mtime, size);
+    }
+}
+
 /**
  * Returns the PluginDescriptor's corresponding to
  * the .so/.dll file at the given path, if it
- * exists and the MD5 hash matches.
+ * exists and has not been modified since it was
+ * cached.
  *
  * @note The returned array must be free'd but not
  *   the descriptors.
@@ -244,50 +580,33 @@ cached_plugin_descriptors_get (
   CachedPluginDescriptors * self,
   const char *              abs_path)
 {
-  PluginDescriptor ** descriptors =
-    object_new_n (1, PluginDescriptor *);
-  int num_descriptors = 0;
-
   g_debug ("Getting cached descriptors for %s", abs_path);
 
-  for (int i = 0; i < self->num_descriptors; i++)
-    {
-      PluginDescriptor * descr = self->descriptors[i];
+  GPtrArray * arr = (GPtrArray *) g_hash_table_lookup (
+    self->descriptors_ht, abs_path);
+  if (!arr || arr->len == 0)
+    return NULL;
 
-      /* skip LV2 since they don't have paths */
-      if (descr->protocol == PROT_LV2)
-        continue;
-
-      GFile * file = g_file_new_for_path (descr->path);
-      if (string_is_equal (descr->path, abs_path))
-        {
-          if (descr->ghash == g_file_hash (file))
-            {
-              num_descriptors++;
-              descriptors = g_realloc (
-                descriptors,
-                (size_t) (num_descriptors + 1)
-                  * sizeof (PluginDescriptor *));
-              descriptors[num_descriptors - 1] = descr;
-            }
-          else
-            {
-              g_debug (
-                "hash differs %u != %u", descr->ghash,
-                g_file_hash (file));
-            }
-        }
-      g_object_unref (file);
+  /* discard stale descriptors so that the plugin
+   * gets rescanned */
+  if (!is_path_unchanged (self, abs_path))
+    {
+      g_message (
+        "%s changed since it was cached", abs_path);
+      remove_descriptors_with_key (self, abs_path);
+      return NULL;
     }
 
-  if (num_descriptors == 0)
+  PluginDescriptor ** descriptors =
+    object_new_n (arr->len + 1, PluginDescriptor *);
+  for (size_t i = 0; i < arr->len; i++)
     {
-      free (descriptors);
-      return NULL;
+      descriptors[i] =
+        (PluginDescriptor *) g_ptr_array_index (arr, i);
     }
 
   /* NULL-terminate */
-  descriptors[num_descriptors] = NULL;
+  descriptors[arr->len] = NULL;
 
   return descriptors;
 }
@@ -312,6 +631,9 @@ cached_plugin_descriptors_blacklist (
   new_descr->ghash = g_file_hash (file);
   g_object_unref (file);
   self->blacklisted[self->num_blacklisted++] = new_descr;
+  g_hash_table_insert (
+    self->blacklisted_ht, g_strdup (abs_path), new_descr);
+  stamp_path (self, abs_path);
   if (_serialize)
     {
       cached_plugin_descriptors_serialize_to_file (self);
@@ -353,7 +675,7 @@ cached_plugin_descriptors_replace (
       if (plugin_descriptor_is_same_plugin (
             cur_descr, new_descr))
         {
-          self->descriptors[i] = new_descr;
+          self->blacklisted[i] = new_descr;
           plugin_descriptor_free (cur_descr);
           goto check_serialize;
         }
@@ -364,6 +686,11 @@ cached_plugin_descriptors_replace (
   return;
 
 check_serialize:
+  rebuild_indices (self);
+  if (new_descr->path)
+    {
+      stamp_path (self, new_descr->path);
+    }
   if (_serialize)
     {
       cached_plugin_descriptors_serialize_to_file (self);
@@ -391,6 +718,11 @@ cached_plugin_descriptors_add (
       g_object_unref (file);
     }
   self->descriptors[self->num_descriptors++] = new_descr;
+  index_descriptor (self, new_descr);
+  if (new_descr->protocol != PROT_LV2 && new_descr->path)
+    {
+      stamp_path (self, new_descr->path);
+    }
 
   if (_serialize)
     {
@@ -398,6 +730,80 @@ cached_plugin_descriptors_add (
     }
 }
 
+/**
+ * Removes the descriptors, blacklisted entries and
+ * stamps whose key (URI for LV2, path otherwise) is
+ * not in @p found_keys.
+ *
+ * @return Whether anything was removed.
+ */
+bool
+cached_plugin_descriptors_remove_missing (
+  CachedPluginDescriptors * self,
+  GHashTable *              found_keys)
+{
+  int num_removed = 0;
+
+  int num_kept = 0;
+  for (int i = 0; i < self->num_descriptors; i++)
+    {
+      PluginDescriptor * descr = self->descriptors[i];
+      const char *       key = get_descr_key (descr);
+      if (key && g_hash_table_contains (found_keys, key))
+        {
+          self->descriptors[num_kept++] = descr;
+          continue;
+        }
+      g_debug (
+        "%s was removed, forgetting it",
+        key ? key : descr->name);
+      plugin_descriptor_free (descr);
+      num_removed++;
+    }
+  self->num_descriptors = num_kept;
+
+  num_kept = 0;
+  for (int i = 0; i < self->num_blacklisted; i++)
+    {
+      PluginDescriptor * descr = self->blacklisted[i];
+      if (
+        descr->path
+        && g_hash_table_contains (found_keys, descr->path))
+        {
+          self->blacklisted[num_kept++] = descr;
+          continue;
+        }
+      plugin_descriptor_free (descr);
+      num_removed++;
+    }
+  self->num_blacklisted = num_kept;
+
+  num_kept = 0;
+  for (int i = 0; i < self->num_stamps; i++)
+    {
+      PluginFileStamp * stamp = self->stamps[i];
+      if (g_hash_table_contains (found_keys, stamp->key))
+        {
+          self->stamps[num_kept++] = stamp;
+          continue;
+        }
+      g_free_and_null (stamp->key);
+      object_zero_and_free (stamp);
+      num_removed++;
+    }
+  self->num_stamps = num_kept;
+
+  if (num_removed == 0)
+    return false;
+
+  g_message (
+    "Removed %d cached plugin entries that no longer "
+    "exist",
+    num_removed);
+  rebuild_indices (self);
+  return true;
+}
+
 /**
  * Clears the descriptors and removes the cache file.
  */
@@ -410,6 +816,7 @@ cached_plugin_descriptors_clear (
       plugin_descriptor_free (self->descriptors[i]);
     }
   self->num_descriptors = 0;
+  rebuild_indices (self);
 
   delete_file ();
 }
@@ -427,6 +834,20 @@ cached_plugin_descriptors_free (CachedPluginDescriptors * self)
       object_free_w_func_and_null (
         plugin_descriptor_free, self->blacklisted[i]);
     }
+  for (int i = 0; i < self->num_stamps; i++)
+    {
+      PluginFileStamp * stamp = self->stamps[i];
+      g_free_and_null (stamp->key);
+      object_zero_and_free (stamp);
+    }
+  object_zero_and_free (self->stamps);
+
+  object_free_w_func_and_null (
+    g_hash_table_unref, self->descriptors_ht);
+  object_free_w_func_and_null (
+    g_hash_table_unref, self->blacklisted_ht);
+  object_free_w_func_and_null (
+    g_hash_table_unref, self->stamps_ht);
 
   object_zero_and_free (self);
 }
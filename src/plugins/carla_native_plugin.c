@@ -30,6 +30,7 @@
 #  include "utils/file.h"
 #  include "utils/flags.h"
 #  include "utils/gtk.h"
+#  include "utils/hash.h"
 #  include "utils/io.h"
 #  include "utils/math.h"
 #  include "utils/objects.h"
@@ -38,6 +39,7 @@
 #  include "zrythm_app.h"
 
 #  include <glib/gi18n.h>
+#  include <glib/gstdio.h>
 #  include <gtk/gtk.h>
 
 #  include <CarlaHost.h>
@@ -696,6 +698,73 @@ carla_native_plugin_has_custom_ui (
   g_return_val_if_reached (false);
 }
 
+/**
+ * Sends the parameters that changed since the last
+ * call to Carla.
+ *
+ * Carla has no bulk parameter API, so this sets
+ * each changed parameter once with its latest
+ * value, no matter how many times it changed.
+ */
+static void
+flush_control_changes (CarlaNativePlugin * self)
+{
+  Plugin * pl = self->plugin;
+  if (!g_atomic_int_compare_and_exchange (
+        &pl->control_changes_pending, 1, 0))
+    return;
+
+  for (size_t i = 0; i < pl->ctrl_in_ports->len; i++)
+    {
+      Port * port = g_ptr_array_index (pl->ctrl_in_ports, i);
+      if (
+        g_atomic_int_compare_and_exchange (
+          &port->plugin_change_pending, 1, 0)
+        && port->carla_param_id >= 0)
+        {
+          carla_native_plugin_set_param_value (
+            self, (uint32_t) port->carla_param_id,
+            port->control);
+        }
+    }
+}
+
+/**
+ * Records the time a processing cycle took.
+ *
+ * Realtime function.
+ */
+static void
+record_process_time (CarlaNativePlugin * self, gint64 time_us)
+{
+  /* time available for processing an engine
+   * block */
+  const gint64 budget_us =
+    ((gint64) AUDIO_ENGINE->block_length * G_USEC_PER_SEC)
+    / AUDIO_ENGINE->sample_rate;
+
+  atomic_fetch_add_explicit (
+    &self->process_time_sum_us, time_us,
+    memory_order_relaxed);
+  g_atomic_int_inc (&self->num_processed_cycles);
+
+  /* the max may be raised concurrently if the
+   * plugin is processed from several threads */
+  gint max_us = g_atomic_int_get (&self->process_time_max_us);
+  while (
+    time_us > max_us
+    && !g_atomic_int_compare_and_exchange (
+      &self->process_time_max_us, max_us, (gint) time_us))
+    {
+      max_us = g_atomic_int_get (&self->process_time_max_us);
+    }
+
+  if (time_us > budget_us)
+    {
+      g_atomic_int_inc (&self->num_overruns);
+    }
+}
+
 /**
  * Processes the plugin for this cycle.
  */
@@ -704,6 +773,8 @@ carla_native_plugin_process (
   CarlaNativePlugin *                 self,
   const EngineProcessTimeInfo * const time_nfo)
 {
+  flush_control_changes (self);
+
   self->time_info.playing = TRANSPORT_IS_ROLLING;
   self->time_info.frame = (uint64_t) time_nfo->g_start_frame;
   /* TODO pre-calculate these at the start of the
@@ -854,13 +925,31 @@ carla_native_plugin_process (
 #  endif
     }
 
+  /* measure the round trip to the bridge, if
+   * bridged */
+  const bool measure =
+    self->plugin->setting->bridge_mode == CARLA_BRIDGE_FULL;
+  const gint64 start_time =
+    measure ? g_get_monotonic_time () : 0;
+
   self->native_plugin_descriptor->process (
     self->native_plugin_handle, self->inbufs, self->outbufs,
     time_nfo->nframes, events, (uint32_t) num_events_written);
 
+  if (measure)
+    {
+      record_process_time (
+        self, g_get_monotonic_time () - start_time);
+    }
+
   /* update latency */
-  self->plugin->latency =
-    carla_native_plugin_get_latency (self);
+  nframes_t latency = carla_native_plugin_get_latency (self);
+  if (G_UNLIKELY (latency != self->plugin->latency))
+    {
+      self->plugin->latency = latency;
+      g_atomic_int_set (&self->plugin->latency_changed, 1);
+      EVENTS_PUSH (ET_PLUGIN_LATENCY_CHANGED, self->plugin);
+    }
 }
 
 static ZPluginCategory
@@ -2255,6 +2344,26 @@ carla_native_plugin_get_port_from_param_id (
   g_return_val_if_reached (NULL);
 }
 
+void
+carla_native_plugin_get_process_stats (
+  CarlaNativePlugin *             self,
+  CarlaNativePluginProcessStats * stats)
+{
+  stats->num_cycles =
+    g_atomic_int_get (&self->num_processed_cycles);
+  stats->avg_us =
+    stats->num_cycles > 0
+      ? (double) atomic_load_explicit (
+          &self->process_time_sum_us,
+          memory_order_relaxed)
+          / (double) stats->num_cycles
+      : 0.0;
+  stats->max_us =
+    g_atomic_int_get (&self->process_time_max_us);
+  stats->num_overruns =
+    g_atomic_int_get (&self->num_overruns);
+}
+
 /**
  * Returns the latency in samples.
  */
@@ -2290,6 +2399,10 @@ carla_native_plugin_save_state (
       return 0;
     }
 
+  /* make sure the saved state has the latest
+   * parameter values */
+  flush_control_changes (self);
+
   char * dir_to_use = NULL;
   if (abs_state_dir)
     {
@@ -2305,15 +2418,56 @@ carla_native_plugin_save_state (
     g_build_filename (dir_to_use, CARLA_STATE_FILENAME, NULL);
   g_debug (
     "saving carla plugin state to %s", state_file_abs_path);
+
+  /* save to a temporary file first and only
+   * replace the existing state if it changed */
+  char * tmp_file_abs_path =
+    g_strdup_printf ("%s.tmp", state_file_abs_path);
   bool ret = carla_save_plugin_state (
-    self->host_handle, 0, state_file_abs_path);
+    self->host_handle, 0, tmp_file_abs_path);
   if (ret != true)
     {
       g_warning (
         "failed to save plugin state: %s",
         carla_get_last_error (self->host_handle));
+      io_remove (tmp_file_abs_path);
+    }
+  else
+    {
+      /* compare against the hash of the last
+       * written state instead of re-reading the
+       * existing file */
+      uint32_t hash =
+        hash_get_from_file_simple (tmp_file_abs_path);
+      if (
+        self->saved_state_dir
+        && string_is_equal (
+          self->saved_state_dir, dir_to_use)
+        && hash == self->saved_state_hash
+        && g_file_test (
+          state_file_abs_path, G_FILE_TEST_EXISTS))
+        {
+          g_debug ("state unchanged, skipping write");
+          io_remove (tmp_file_abs_path);
+        }
+      else if (
+        g_rename (tmp_file_abs_path, state_file_abs_path)
+        != 0)
+        {
+          g_warning (
+            "failed to move %s to %s",
+            tmp_file_abs_path, state_file_abs_path);
+        }
+      else
+        {
+          g_free (self->saved_state_dir);
+          self->saved_state_dir = g_strdup (dir_to_use);
+          self->saved_state_hash = hash;
+        }
     }
+  g_free (tmp_file_abs_path);
   g_free (state_file_abs_path);
+  g_free (dir_to_use);
 
   g_warn_if_fail (self->plugin->state_dir);
 
@@ -2408,6 +2562,18 @@ carla_native_plugin_close (CarlaNativePlugin * self)
     }
 
   PluginDescriptor * descr = self->plugin->setting->descr;
+
+  CarlaNativePluginProcessStats stats;
+  carla_native_plugin_get_process_stats (self, &stats);
+  if (stats.num_cycles > 0)
+    {
+      g_message (
+        "%s: bridge round trip: avg %.1f us, max %d us, "
+        "%d of %d cycles over the 128-frame budget",
+        descr->name, stats.avg_us, stats.max_us,
+        stats.num_overruns, stats.num_cycles);
+    }
+
   if (self->native_plugin_descriptor)
     {
       self->native_plugin_descriptor->deactivate (
@@ -2456,6 +2622,7 @@ carla_native_plugin_free (CarlaNativePlugin * self)
 
   object_free_w_func_and_null (
     g_ptr_array_unref, self->patchbay_port_info);
+  g_free_and_null (self->saved_state_dir);
 
   object_zero_and_free (self);
 }
@@ -43,6 +43,7 @@
 #include <sys/types.h>
 
 #include "audio/transport.h"
+#include "plugins/lv2/lv2_gtk.h"
 #include "plugins/lv2/lv2_state.h"
 #include "plugins/lv2/lv2_ui.h"
 #include "plugins/lv2_plugin.h"
@@ -222,11 +223,13 @@ lv2_state_make_path_temp (
 }
 
 /**
- * Saves the plugin state to the filesystem and
- * returns the state.
+ * Takes a snapshot of the plugin state.
+ *
+ * This calls the plugin's save() and must not be
+ * called while the plugin is processing.
  */
 LilvState *
-lv2_state_save_to_file (Lv2Plugin * pl, bool is_backup)
+lv2_state_snapshot (Lv2Plugin * pl, bool is_backup)
 {
   g_return_val_if_fail (
     pl->plugin->instantiated && pl->instance, NULL);
@@ -243,18 +246,150 @@ lv2_state_save_to_file (Lv2Plugin * pl, bool is_backup)
     copy_dir, link_dir, abs_state_dir,
     lv2_plugin_get_port_value, pl, LV2_STATE_IS_PORTABLE,
     pl->state_features);
-  g_return_val_if_fail (state, NULL);
 
+  g_free (abs_state_dir);
+  g_free (copy_dir);
+  g_free (link_dir);
+
+  return state;
+}
+
+/**
+ * Writes the given snapshot to the plugin's state
+ * dir, unless it equals the snapshot last written
+ * there.
+ *
+ * @note Lv2Plugin.state_lock must be held.
+ *
+ * @param[out] written Whether the file was written.
+ *
+ * @return Whether successful.
+ */
+static bool
+write_snapshot (
+  Lv2Plugin *       pl,
+  const LilvState * state,
+  bool              is_backup,
+  bool *            written)
+{
+  *written = false;
+
+  char * abs_state_dir =
+    plugin_get_abs_state_dir (pl->plugin, is_backup);
+  char * state_file_path = g_build_filename (
+    abs_state_dir, STATE_FILENAME, NULL);
+  bool file_exists =
+    g_file_test (state_file_path, G_FILE_TEST_EXISTS);
+  g_free (state_file_path);
+
+  /* skip writing if the same state was already
+   * written here (this compares the values and
+   * files without serializing) */
+  if (
+    pl->saved_state && file_exists
+    && string_is_equal (abs_state_dir, pl->saved_state_dir)
+    && lilv_state_equals (pl->saved_state, state))
+    {
+      g_debug (
+        "state of %s unchanged, skipping write",
+        pl->plugin->setting->descr->name);
+      g_free (abs_state_dir);
+      return true;
+    }
+
+  /* lilv_state_save() interns nodes in the world it
+   * is given, so use a world owned by the plugin
+   * instead of the shared one */
+  if (!pl->state_world)
+    {
+      pl->state_world = lilv_world_new ();
+    }
   int rc = lilv_state_save (
-    LILV_WORLD, &pl->map, &pl->unmap, state, NULL,
+    pl->state_world, &pl->map, &pl->unmap, state, NULL,
     abs_state_dir, STATE_FILENAME);
   if (rc)
     {
       g_critical ("Lilv save state failed");
-      return NULL;
+      g_free (abs_state_dir);
+      return false;
     }
 
-  g_message ("Lilv state saved to %s", pl->plugin->state_dir);
+  g_free (pl->saved_state_dir);
+  pl->saved_state_dir = abs_state_dir;
+  *written = true;
+
+  g_message (
+    "Lilv state saved to %s", pl->plugin->state_dir);
+
+  return true;
+}
+
+/**
+ * Writes a snapshot taken with lv2_state_snapshot()
+ * to the plugin's state dir, unless it equals the
+ * snapshot last written there.
+ *
+ * The written snapshot is kept to compare later
+ * snapshots with, so this takes ownership of
+ * @p state.
+ *
+ * This may be called from any thread. Writes of the
+ * same plugin are serialized.
+ *
+ * @return Whether successful.
+ */
+bool
+lv2_state_write_snapshot (
+  Lv2Plugin * pl,
+  LilvState * state,
+  bool        is_backup)
+{
+  g_return_val_if_fail (state, false);
+
+  g_mutex_lock (&pl->state_lock);
+  bool written = false;
+  bool ret = write_snapshot (pl, state, is_backup, &written);
+  if (written)
+    {
+      object_free_w_func_and_null (
+        lilv_state_free, pl->saved_state);
+      pl->saved_state = state;
+    }
+  else
+    {
+      lilv_state_free (state);
+    }
+  g_mutex_unlock (&pl->state_lock);
+
+  return ret;
+}
+
+/**
+ * Saves the plugin state to the filesystem and
+ * returns the state.
+ */
+LilvState *
+lv2_state_save_to_file (Lv2Plugin * pl, bool is_backup)
+{
+  LilvState * state = lv2_state_snapshot (pl, is_backup);
+  g_return_val_if_fail (state, NULL);
+
+  g_mutex_lock (&pl->state_lock);
+  bool written = false;
+  bool ret = write_snapshot (pl, state, is_backup, &written);
+  if (written)
+    {
+      /* the caller owns the state, so there is
+       * nothing to compare the next snapshot with */
+      object_free_w_func_and_null (
+        lilv_state_free, pl->saved_state);
+    }
+  g_mutex_unlock (&pl->state_lock);
+  if (!ret)
+    {
+      lilv_state_free (state);
+      return NULL;
+    }
 
   return state;
 }
@@ -340,17 +475,20 @@ set_port_value (
         &fvalue);
     }
 
-  if (pl->visible)
+  /* update UI (the plugin-to-UI ring is only
+   * written by the realtime thread) */
+  if (!pl->visible)
+    return;
+  if (g_thread_self () == zrythm_app->gtk_thread)
+    {
+      lv2_gtk_ui_port_event (
+        plugin, (uint32_t) port->lilv_port_index,
+        sizeof (fvalue), 0, &fvalue);
+    }
+  else
     {
-      /* update UI */
-      char buf[sizeof (Lv2ControlChange) + sizeof (fvalue)];
-      Lv2ControlChange * ev = (Lv2ControlChange *) buf;
-      ev->index = port->lilv_port_index;
-      ev->protocol = 0;
-      ev->size = sizeof (fvalue);
-      *(float *) ev->body = fvalue;
-      zix_ring_write (
-        plugin->plugin_to_ui_events, buf, sizeof (buf));
+      /* let the next UI refresh send it */
+      g_atomic_int_set (&pl->ui_control_changes_pending, 1);
     }
 }
 
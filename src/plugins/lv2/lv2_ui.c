@@ -146,6 +146,9 @@ lv2_ui_read_and_apply_events (
           port_set_control_value (port, *(float *) body, 0, 0);
           port->received_ui_event = 1;
 
+          /* the UI already has this value */
+          port->last_sent_control = port->control;
+
 #if 0
           /* note: should not be printing in the
            * realtime thread */
@@ -236,6 +239,53 @@ lv2_ui_send_control_val_event_from_plugin_to_ui (
   port->last_sent_control = port->control;
 }
 
+/**
+ * Passes the current value of the given control
+ * port to the plugin UI directly.
+ *
+ * Lv2Plugin.plugin_to_ui_events is only written by
+ * the realtime thread, so the GTK thread uses this
+ * instead.
+ *
+ * For property ports, a patch:Set of the property
+ * is sent instead (on the control input port).
+ *
+ * @note Must be called from the GTK thread.
+ */
+void
+lv2_ui_update_control_val (
+  Lv2Plugin * lv2_plugin,
+  Port *      port)
+{
+  if (
+    !lv2_plugin->plugin->visible
+    || lv2_plugin->plugin->instantiation_failed)
+    return;
+
+  if (port->id.flags & PORT_FLAG_IS_PROPERTY)
+    {
+      if (lv2_plugin->control_in < 0)
+        return;
+
+      uint8_t          buf[128];
+      const LV2_Atom * atom = lv2_plugin_forge_property_set (
+        &lv2_plugin->main_forge, port, buf, sizeof (buf));
+      lv2_gtk_ui_port_event (
+        lv2_plugin, (uint32_t) lv2_plugin->control_in,
+        lv2_atom_total_size (atom),
+        PM_URIDS.atom_eventTransfer, atom);
+    }
+  else
+    {
+      lv2_gtk_ui_port_event (
+        lv2_plugin, (uint32_t) port->lilv_port_index,
+        sizeof (float), 0, &port->control);
+    }
+
+  port->automating = 0;
+  port->last_sent_control = port->control;
+}
+
 /**
  * Send event to UI, called during the real time
  * audio thread when processing the plugin.
@@ -28,6 +28,8 @@
 #include "plugins/lv2/lv2_worker.h"
 #include "plugins/lv2_plugin.h"
 #include "project.h"
+#include "utils/env.h"
+#include "utils/objects.h"
 #include "zrythm_app.h"
 
 static LV2_Worker_Status
@@ -45,71 +47,284 @@ lv2_worker_respond (
 }
 
 /**
- * Worker logic running in a separate thread (if
- * worker is threaded).
+ * Header written to the request ring before the
+ * request data.
  */
-static void *
-worker_func (void * data)
+typedef struct WorkerRequestHeader
+{
+  /** Size of the data following the header. */
+  uint32_t size;
+
+  /** Time the request was scheduled at. */
+  gint64 time;
+} WorkerRequestHeader;
+
+/**
+ * Pushes the worker to the pool queue unless it is
+ * already queued or being serviced.
+ *
+ * This is realtime-safe.
+ */
+static void
+queue_worker (Lv2WorkerPool * pool, Lv2Worker * worker)
+{
+  if (!g_atomic_int_compare_and_exchange (
+        &worker->scheduled, 0, 1))
+    return;
+
+  if (!mpmc_queue_try_push_back (pool->queue, worker))
+    {
+      /* queue full - the requests stay in the ring
+       * and lv2_worker_emit_responses() tries again
+       * on the next cycle (this is reported by the
+       * pool threads) */
+      g_atomic_int_inc (&pool->num_dropped);
+      g_atomic_int_set (&worker->scheduled, 0);
+      return;
+    }
+  zix_sem_post (&pool->sem);
+}
+
+/**
+ * Runs all pending requests of the given worker.
+ *
+ * @param buf Scratch buffer, resized as needed.
+ */
+static void
+service_worker (
+  Lv2WorkerPool * pool,
+  Lv2Worker *     worker,
+  void **         buf,
+  uint32_t *      buf_size)
 {
-  Lv2Worker * worker = (Lv2Worker *) data;
   Lv2Plugin * plugin = worker->plugin;
-  void *      buf = NULL;
-  while (true)
+
+  zix_sem_wait (&worker->service_lock);
+  do
     {
-      zix_sem_wait (&worker->sem);
-      if (plugin->exit)
+      WorkerRequestHeader header;
+      while (
+        zix_ring_read_space (worker->requests)
+        >= sizeof (header))
         {
-          break;
-        }
+          zix_ring_read (
+            worker->requests, (char *) &header,
+            sizeof (header));
 
-      uint32_t size = 0;
-      zix_ring_read (
-        worker->requests, (char *) &size, sizeof (size));
+          if (header.size > *buf_size)
+            {
+              void * new_buf = realloc (*buf, header.size);
+              if (!new_buf)
+                {
+                  g_critical ("realloc() failed");
+                  zix_ring_skip (
+                    worker->requests, header.size);
+                  g_atomic_int_add (&pool->queue_depth, -1);
+                  continue;
+                }
+              *buf = new_buf;
+              *buf_size = header.size;
+            }
+          zix_ring_read (
+            worker->requests, (char *) *buf, header.size);
+          g_atomic_int_add (&pool->queue_depth, -1);
 
-      if (!(buf = realloc (buf, size)))
-        {
-          g_warning ("error: realloc() failed");
-          free (buf);
-          return NULL;
-        }
+          /* drain without running work if the plugin
+           * is being freed */
+          if (plugin->exit)
+            continue;
 
-      zix_ring_read (worker->requests, (char *) buf, size);
+          gint64 latency =
+            g_get_monotonic_time () - header.time;
+          zix_sem_wait (&pool->stats_lock);
+          pool->num_serviced++;
+          pool->total_latency_us += latency;
+          pool->max_latency_us =
+            MAX (pool->max_latency_us, latency);
+          zix_sem_post (&pool->stats_lock);
 
-      zix_sem_wait (&plugin->work_lock);
-      char pl_str[700];
-      plugin_print (plugin->plugin, pl_str, 700);
-      if (DEBUGGING)
-        {
-          g_debug (
-            "running work (threaded) for plugin %s", pl_str);
+          zix_sem_wait (&plugin->work_lock);
+          if (DEBUGGING)
+            {
+              char pl_str[700];
+              plugin_print (plugin->plugin, pl_str, 700);
+              g_debug (
+                "running work (threaded) for plugin %s",
+                pl_str);
+            }
+          worker->iface->work (
+            plugin->instance->lv2_handle,
+            lv2_worker_respond, worker, header.size,
+            *buf);
+          zix_sem_post (&plugin->work_lock);
         }
-      worker->iface->work (
-        plugin->instance->lv2_handle, lv2_worker_respond,
-        worker, size, buf);
-      zix_sem_post (&plugin->work_lock);
+
+      g_atomic_int_set (&worker->scheduled, 0);
+
+      /* a request may have been written after the
+       * last read but before the flag was cleared, in
+       * which case the scheduler did not queue the
+       * worker, so keep servicing it */
+    }
+  while (
+    zix_ring_read_space (worker->requests) > 0
+    && g_atomic_int_compare_and_exchange (
+      &worker->scheduled, 0, 1));
+
+  /* wake up lv2_worker_finish() (the worker must
+   * not be accessed after releasing the lock) */
+  if (g_atomic_int_get (&worker->finishing))
+    zix_sem_post (&worker->finished);
+  zix_sem_post (&worker->service_lock);
+}
+
+/**
+ * Warns about workers that could not be queued
+ * since the last call.
+ */
+static void
+report_dropped (Lv2WorkerPool * pool)
+{
+  int reported =
+    g_atomic_int_get (&pool->num_dropped_reported);
+  int dropped = g_atomic_int_get (&pool->num_dropped);
+  if (
+    dropped == reported
+    || !g_atomic_int_compare_and_exchange (
+      &pool->num_dropped_reported, reported, dropped))
+    return;
+
+  g_warning (
+    "LV2 worker pool queue full: %d worker(s) had to "
+    "be queued again on a later cycle",
+    dropped - reported);
+}
+
+/**
+ * Pool thread logic.
+ */
+static void *
+pool_thread_func (void * data)
+{
+  Lv2WorkerPool * pool = (Lv2WorkerPool *) data;
+  void *          buf = NULL;
+  uint32_t        buf_size = 0;
+  while (true)
+    {
+      zix_sem_wait (&pool->sem);
+      if (g_atomic_int_get (&pool->exit))
+        break;
+
+      Lv2Worker * worker = NULL;
+      if (!mpmc_queue_dequeue (
+            pool->queue, (void **) &worker))
+        continue;
+
+      service_worker (pool, worker, &buf, &buf_size);
+      report_dropped (pool);
     }
 
   free (buf);
   return NULL;
 }
 
+Lv2WorkerPool *
+lv2_worker_pool_new (int num_threads)
+{
+  Lv2WorkerPool * self = object_new (Lv2WorkerPool);
+
+  if (num_threads <= 0)
+    {
+      num_threads = env_get_int (
+        "ZRYTHM_LV2_WORKER_THREADS",
+        CLAMP (
+          (int) g_get_num_processors () / 2, 1, 4));
+    }
+  self->num_threads = CLAMP (num_threads, 1, 64);
+
+  /* each worker is queued at most once */
+  self->queue = mpmc_queue_new ();
+  mpmc_queue_reserve (self->queue, 4096);
+
+  zix_sem_init (&self->sem, 0);
+  zix_sem_init (&self->stats_lock, 1);
+
+  g_message (
+    "creating LV2 worker pool with %d threads",
+    self->num_threads);
+  self->threads =
+    object_new_n ((size_t) self->num_threads, ZixThread);
+  for (int i = 0; i < self->num_threads; i++)
+    {
+      zix_thread_create (
+        &self->threads[i], 4096, pool_thread_func, self);
+    }
+
+  return self;
+}
+
+void
+lv2_worker_pool_get_stats (
+  Lv2WorkerPool *      self,
+  Lv2WorkerPoolStats * stats)
+{
+  stats->queue_depth =
+    g_atomic_int_get (&self->queue_depth);
+  zix_sem_wait (&self->stats_lock);
+  stats->num_serviced = self->num_serviced;
+  stats->avg_latency_us =
+    self->num_serviced > 0
+      ? self->total_latency_us / self->num_serviced
+      : 0;
+  stats->max_latency_us = self->max_latency_us;
+  zix_sem_post (&self->stats_lock);
+  stats->num_dropped =
+    g_atomic_int_get (&self->num_dropped);
+}
+
+void
+lv2_worker_pool_free (Lv2WorkerPool * self)
+{
+  g_atomic_int_set (&self->exit, 1);
+  for (int i = 0; i < self->num_threads; i++)
+    {
+      zix_sem_post (&self->sem);
+    }
+  for (int i = 0; i < self->num_threads; i++)
+    {
+      zix_thread_join (self->threads[i], NULL);
+    }
+  free (self->threads);
+
+  mpmc_queue_free (self->queue);
+  zix_sem_destroy (&self->sem);
+  zix_sem_destroy (&self->stats_lock);
+
+  object_zero_and_free (self);
+}
+
 void
 lv2_worker_init (
   Lv2Plugin *                  plugin,
   Lv2Worker *                  worker,
   const LV2_Worker_Interface * iface,
+  Lv2WorkerPool *              pool,
   bool                         threaded)
 {
   g_message (
     "initializing worker for LV2 plugin %s",
     plugin->plugin->setting->descr->name);
   g_return_if_fail (plugin && worker && iface);
+  g_return_if_fail (!threaded || pool);
   worker->iface = iface;
   worker->threaded = threaded;
   if (threaded)
     {
-      zix_thread_create (
-        &worker->thread, 4096, worker_func, worker);
+      worker->pool = pool;
+      g_atomic_int_set (&worker->scheduled, 0);
+      g_atomic_int_set (&worker->finishing, 0);
+      zix_sem_init (&worker->service_lock, 1);
+      zix_sem_init (&worker->finished, 0);
       worker->requests =
         zix_ring_new (zix_default_allocator (), 4096);
       zix_ring_mlock (worker->requests);
@@ -130,8 +345,23 @@ lv2_worker_finish (Lv2Worker * worker)
     {
       if (worker->threaded)
         {
-          zix_sem_post (&worker->sem);
-          zix_thread_join (worker->thread, NULL);
+          /* wait for any pool thread to finish
+           * servicing this worker (the plugin is
+           * already marked as exiting so pending
+           * requests are only drained) */
+          g_atomic_int_set (&worker->finishing, 1);
+          while (g_atomic_int_get (&worker->scheduled))
+            {
+              zix_sem_wait (&worker->finished);
+            }
+
+          /* wait for the pool thread to release the
+           * worker */
+          zix_sem_wait (&worker->service_lock);
+          zix_sem_post (&worker->service_lock);
+
+          zix_sem_destroy (&worker->finished);
+          zix_sem_destroy (&worker->service_lock);
           zix_ring_free (worker->requests);
         }
       zix_ring_free (worker->responses);
@@ -176,12 +406,24 @@ lv2_worker_schedule (
   else
     {
       /* Schedule a request to be executed by the
-       * worker thread */
+       * worker pool */
+      WorkerRequestHeader header = {
+        .size = size,
+        .time = g_get_monotonic_time (),
+      };
+      if (
+        zix_ring_write_space (worker->requests)
+        < sizeof (header) + size)
+        {
+          return LV2_WORKER_ERR_NO_SPACE;
+        }
       zix_ring_write (
-        worker->requests, (const char *) &size, sizeof (size));
+        worker->requests, (const char *) &header,
+        sizeof (header));
       zix_ring_write (
         worker->requests, (const char *) data, size);
-      zix_sem_post (&worker->sem);
+      g_atomic_int_inc (&worker->pool->queue_depth);
+      queue_worker (worker->pool, worker);
     }
   return LV2_WORKER_SUCCESS;
 }
@@ -197,6 +439,16 @@ lv2_worker_emit_responses (
   Lv2Worker *    worker,
   LilvInstance * instance)
 {
+  /* retry queuing requests that could not be
+   * queued because the pool queue was full */
+  if (
+    worker->threaded
+    && !g_atomic_int_get (&worker->scheduled)
+    && zix_ring_read_space (worker->requests) > 0)
+    {
+      queue_worker (worker->pool, worker);
+    }
+
   if (worker->responses)
     {
       uint32_t read_space =
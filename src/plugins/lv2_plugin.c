@@ -303,6 +303,7 @@ create_port (
       pi->sym = g_strdup (param->symbol);
       g_return_val_if_fail (IS_PORT_AND_NONNULL (port), NULL);
       port->value_type = param->value_type_urid;
+      port->property_urid = param->urid;
       pi->comment = g_strdup (param->comment);
 
       if (param->has_range)
@@ -863,6 +864,7 @@ void
 lv2_plugin_init_loaded (Lv2Plugin * self)
 {
   self->magic = LV2_PLUGIN_MAGIC;
+  g_mutex_init (&self->state_lock);
 }
 
 /**
@@ -1771,6 +1773,7 @@ lv2_plugin_new (Plugin * plugin)
   Lv2Plugin * self = object_new (Lv2Plugin);
 
   self->magic = LV2_PLUGIN_MAGIC;
+  g_mutex_init (&self->state_lock);
 
   /* set pointers to each other */
   self->plugin = plugin;
@@ -2328,8 +2331,6 @@ lv2_plugin_instantiate (
 
   /*zix_sem_init (&self->exit_sem, 0);*/
 
-  zix_sem_init (&self->worker.sem, 0);
-
   /* Load preset, if specified */
   if (!state)
     {
@@ -2788,11 +2789,14 @@ lv2_plugin_instantiate (
           lilv_instance_get_extension_data (
             self->instance, LV2_WORKER__interface);
 
-      lv2_worker_init (self, &self->worker, iface, true);
+      lv2_worker_init (
+        self, &self->worker, iface,
+        PLUGIN_MANAGER->lv2_worker_pool, true);
       if (self->safe_restore)
         {
           lv2_worker_init (
-            self, &self->state_worker, iface, false);
+            self, &self->state_worker, iface, NULL,
+            false);
         }
     }
 
@@ -2921,6 +2925,81 @@ lv2_plugin_cleanup (Lv2Plugin * self)
   return 0;
 }
 
+/**
+ * Forges a patch:Set of the given numeric property
+ * port's current value into @p buf.
+ *
+ * @return The forged atom (at the start of @p buf).
+ */
+const LV2_Atom *
+lv2_plugin_forge_property_set (
+  LV2_Atom_Forge * forge,
+  Port *           port,
+  uint8_t *        buf,
+  uint32_t         buf_size)
+{
+  lv2_atom_forge_set_buffer (forge, buf, buf_size);
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_object (
+    forge, &frame, 0, PM_URIDS.patch_Set);
+  lv2_atom_forge_key (forge, PM_URIDS.patch_property);
+  lv2_atom_forge_urid (forge, port->property_urid);
+  lv2_atom_forge_key (forge, PM_URIDS.patch_value);
+  if (port->value_type == forge->Int)
+    lv2_atom_forge_int (forge, (int32_t) port->control);
+  else if (port->value_type == forge->Long)
+    lv2_atom_forge_long (forge, (int64_t) port->control);
+  else if (port->value_type == forge->Double)
+    lv2_atom_forge_double (forge, port->control);
+  else if (port->value_type == forge->Bool)
+    lv2_atom_forge_bool (forge, port->control > 0.5f);
+  else
+    lv2_atom_forge_float (forge, port->control);
+  lv2_atom_forge_pop (forge, &frame);
+
+  return (const LV2_Atom *) buf;
+}
+
+/**
+ * Writes a patch:Set for each numeric property
+ * that changed since the last cycle, so that all
+ * of them reach the plugin in one event sequence.
+ *
+ * Plain control ports are connected directly, so
+ * only their pending flag is cleared.
+ *
+ * @param iter Iterator of the control input event
+ *   buffer, or NULL if the plugin has none.
+ */
+REALTIME
+static void
+write_pending_control_changes (
+  Lv2Plugin *          self,
+  LV2_Evbuf_Iterator * iter)
+{
+  Plugin *         pl = self->plugin;
+  LV2_Atom_Forge * forge = &self->dsp_forge;
+  for (size_t i = 0; i < pl->ctrl_in_ports->len; i++)
+    {
+      Port * port = g_ptr_array_index (pl->ctrl_in_ports, i);
+      if (!g_atomic_int_compare_and_exchange (
+            &port->plugin_change_pending, 1, 0))
+        continue;
+
+      if (
+        !iter || !(port->id.flags & PORT_FLAG_IS_PROPERTY)
+        || !(port->id.flags & PORT_FLAG_AUTOMATABLE))
+        continue;
+
+      uint8_t          buf[128];
+      const LV2_Atom * atom = lv2_plugin_forge_property_set (
+        forge, port, buf, sizeof (buf));
+      lv2_evbuf_write (
+        iter, 0, 0, atom->type, atom->size,
+        (const uint8_t *) LV2_ATOM_BODY_CONST (atom));
+    }
+}
+
 /**
  * Processes the plugin for this cycle.
  */
@@ -3028,6 +3107,16 @@ lv2_plugin_process (
     }
   self->bpm = tempo_track_get_current_bpm (P_TEMPO_TRACK);
 
+  /* deliver control changes made since the last
+   * cycle in one batch */
+  const bool control_changed =
+    g_atomic_int_compare_and_exchange (
+      &pl->control_changes_pending, 1, 0);
+  if (control_changed && self->control_in < 0)
+    {
+      write_pending_control_changes (self, NULL);
+    }
+
   /* Prepare port buffers */
   for (int p = 0; p < pl->num_lilv_ports; ++p)
     {
@@ -3078,6 +3167,11 @@ lv2_plugin_process (
                 (const uint8_t *) LV2_ATOM_BODY (&get));
             }
 
+          if (control_changed && p == self->control_in)
+            {
+              write_pending_control_changes (self, &iter);
+            }
+
           if (port->midi_events->num_events > 0)
             {
               int num_events_written = 0;
@@ -3172,9 +3266,9 @@ lv2_plugin_process (
                     "to %f",
                     pi->label, pl->latency,
                     (double) port->control);
-                  EVENTS_PUSH (
-                    ET_PLUGIN_LATENCY_CHANGED, NULL);
                   pl->latency = (nframes_t) port->control;
+                  g_atomic_int_set (&pl->latency_changed, 1);
+                  EVENTS_PUSH (ET_PLUGIN_LATENCY_CHANGED, pl);
                 }
 
               /* if UI is instantiated */
@@ -3398,6 +3492,12 @@ lv2_plugin_free (Lv2Plugin * self)
 
   remove (self->temp_dir);
   object_zero_and_free_if_nonnull (self->temp_dir);
+  g_free_and_null (self->saved_state_dir);
+  object_free_w_func_and_null (
+    lilv_state_free, self->saved_state);
+  object_free_w_func_and_null (
+    lilv_world_free, self->state_world);
+  g_mutex_clear (&self->state_lock);
 
   object_free_w_func_and_null (free, self->ui_event_buf);
 
@@ -39,6 +39,7 @@
 #include "utils/arrays.h"
 #include "utils/dialogs.h"
 #include "utils/dsp.h"
+#include "utils/env.h"
 #include "utils/error.h"
 #include "utils/file.h"
 #include "utils/flags.h"
@@ -535,6 +536,24 @@ plugin_new_from_setting (
   plugin_init (self, track_name_hash, slot_type, slot);
   g_return_val_if_fail (self->gain && self->enabled, NULL);
 
+  /* host the plugin in a separate process if
+   * requested, so that it cannot crash the engine
+   * (only for this instance, the saved setting is
+   * not changed) */
+  bool force_bridge = false;
+#ifdef HAVE_CARLA
+  if (
+    setting->bridge_mode != CARLA_BRIDGE_FULL
+    && descr->protocol != PROT_SFZ
+    && descr->protocol != PROT_SF2
+    && env_get_int ("ZRYTHM_BRIDGE_ALL_PLUGINS", 0))
+    {
+      setting->bridge_mode = CARLA_BRIDGE_FULL;
+      setting->open_with_carla = true;
+      force_bridge = true;
+    }
+#endif
+
 #ifdef HAVE_CARLA
   if (setting->open_with_carla)
     {
@@ -588,7 +607,7 @@ plugin_new_from_setting (
   plugin_identifier_copy (
     &self->selected_preset.plugin_id, &self->id);
 
-  if (!ZRYTHM_TESTING)
+  if (!ZRYTHM_TESTING && !force_bridge)
     {
       /* save the new setting (may have changed
        * during instantiation) */
@@ -2080,6 +2099,141 @@ plugin_get_all (
     }
 }
 
+typedef struct PluginStateSaveJob
+{
+  Plugin * pl;
+
+  /** LV2 state snapshot to write, if LV2. */
+  LilvState * lv2_state;
+
+  bool is_backup;
+} PluginStateSaveJob;
+
+/**
+ * Writes the state of a plugin (thread pool
+ * func).
+ */
+static void
+save_state_job_func (
+  PluginStateSaveJob * job,
+  void *               user_data)
+{
+  Plugin * pl = job->pl;
+  if (pl->setting->open_with_carla)
+    {
+#ifdef HAVE_CARLA
+      carla_native_plugin_save_state (
+        pl->carla, job->is_backup, NULL);
+#endif
+    }
+  else if (job->lv2_state)
+    {
+      /* takes ownership of the state */
+      lv2_state_write_snapshot (
+        pl->lv2, job->lv2_state, job->is_backup);
+    }
+
+  object_zero_and_free (job);
+}
+
+/**
+ * Takes snapshots of the states of the given
+ * plugins.
+ *
+ * The returned array must be passed to
+ * plugin_write_state_snapshots().
+ *
+ * The snapshotted plugins are marked with
+ * Plugin.state_saved, which the caller must clear
+ * when done.
+ *
+ * @note The engine must be paused.
+ */
+GPtrArray *
+plugin_snapshot_states (GPtrArray * plugins, bool is_backup)
+{
+  GPtrArray * snapshots = g_ptr_array_new ();
+  for (size_t i = 0; i < plugins->len; i++)
+    {
+      Plugin * pl = (Plugin *) g_ptr_array_index (plugins, i);
+      if (!pl->instantiated)
+        continue;
+
+      PluginStateSaveJob * job =
+        object_new (PluginStateSaveJob);
+      job->pl = pl;
+      job->is_backup = is_backup;
+      if (!pl->setting->open_with_carla)
+        {
+          job->lv2_state =
+            lv2_state_snapshot (pl->lv2, is_backup);
+          if (!job->lv2_state)
+            {
+              g_warning (
+                "failed to snapshot state of %s",
+                pl->setting->descr->name);
+              object_zero_and_free (job);
+              continue;
+            }
+        }
+      pl->state_saved = true;
+      g_ptr_array_add (snapshots, job);
+    }
+
+  return snapshots;
+}
+
+/**
+ * Writes the given snapshots in parallel and frees
+ * them.
+ *
+ * Carla plugins save their state here directly.
+ * Unchanged state files are not rewritten.
+ *
+ * @param snapshots Snapshots returned by
+ *   plugin_snapshot_states().
+ */
+void
+plugin_write_state_snapshots (GPtrArray * snapshots)
+{
+  gint64 time_before = g_get_monotonic_time ();
+  guint  num_snapshots = snapshots->len;
+
+  GError *      err = NULL;
+  GThreadPool * pool = g_thread_pool_new (
+    (GFunc) save_state_job_func, NULL,
+    (int) g_get_num_processors (), F_NOT_EXCLUSIVE, &err);
+  if (!pool)
+    {
+      g_warning (
+        "failed to create thread pool, saving states "
+        "serially: %s",
+        err->message);
+      g_error_free (err);
+    }
+
+  for (size_t i = 0; i < snapshots->len; i++)
+    {
+      PluginStateSaveJob * job =
+        (PluginStateSaveJob *) g_ptr_array_index (
+          snapshots, i);
+      if (pool)
+        g_thread_pool_push (pool, job, NULL);
+      else
+        save_state_job_func (job, NULL);
+    }
+  g_ptr_array_unref (snapshots);
+
+  /* wait for the writes to finish */
+  if (pool)
+    g_thread_pool_free (pool, false, true);
+
+  g_message (
+    "saved %u plugin states in %ldms", num_snapshots,
+    (long) (g_get_monotonic_time () - time_before)
+      / 1000);
+}
+
 /**
  * Clones the given plugin.
  *
@@ -2104,7 +2258,13 @@ plugin_clone (Plugin * src, GError ** error)
   g_message (
     "[1/5] saving state of source plugin (if "
     "instantiated)");
-  if (src->instantiated)
+  if (src->instantiated && src->state_saved)
+    {
+      g_message (
+        "source plugin state already saved to %s",
+        src->state_dir);
+    }
+  else if (src->instantiated)
     {
       if (src->setting->open_with_carla)
         {
@@ -759,6 +759,18 @@ set_float_control (Plugin * pl, Port * port, float value)
       LV2_URID         type = port->value_type;
       LV2_Atom_Forge * forge = &lv2_plugin->main_forge;
 
+      /* properties are sent to the plugin as
+       * patch:Set messages, so only keep track of
+       * the value here without echoing it back to
+       * the UI */
+      if (
+        port->id.flags & PORT_FLAG_IS_PROPERTY
+        && !lv2_plugin->updating)
+        {
+          port->control = value;
+          port->last_sent_control = value;
+        }
+
       if (type == forge->Int)
         {
           const int32_t ival = lrint (value);
@@ -1469,6 +1481,30 @@ plugin_gtk_update_plugin_ui (Plugin * pl)
     {
       Lv2Plugin * lv2_plugin = pl->lv2;
 
+      /* send the latest value of each control that
+       * changed since the last refresh (values that
+       * came from the UI are marked as sent when
+       * received) */
+      if (g_atomic_int_compare_and_exchange (
+            &pl->ui_control_changes_pending, 1, 0))
+        {
+          for (size_t i = 0; i < pl->ctrl_in_ports->len; i++)
+            {
+              Port * port =
+                g_ptr_array_index (pl->ctrl_in_ports, i);
+              bool is_property =
+                port->id.flags & PORT_FLAG_IS_PROPERTY;
+              if (
+                (is_property || port->lilv_port_index >= 0)
+                && !math_floats_equal (
+                  port->control, port->last_sent_control))
+                {
+                  lv2_ui_update_control_val (
+                    lv2_plugin, port);
+                }
+            }
+        }
+
       Lv2ControlChange ev;
       const size_t     space =
         zix_ring_read_space (lv2_plugin->plugin_to_ui_events);
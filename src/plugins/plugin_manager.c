@@ -35,11 +35,13 @@
 #include "plugins/cached_plugin_descriptors.h"
 #include "plugins/carla/carla_discovery.h"
 #include "plugins/collections.h"
+#include "plugins/lv2/lv2_worker.h"
 #include "plugins/lv2_plugin.h"
 #include "plugins/plugin.h"
 #include "plugins/plugin_manager.h"
 #include "settings/settings.h"
 #include "utils/arrays.h"
+#include "utils/env.h"
 #include "utils/flags.h"
 #include "utils/io.h"
 #include "utils/mem.h"
@@ -412,6 +414,8 @@ plugin_manager_new (void)
   init_symap (self);
   load_bundled_lv2_plugins (self);
 
+  self->lv2_worker_pool = lv2_worker_pool_new (0);
+
   /* init vst/dssi/ladspa */
   self->cached_plugin_descriptors =
     cached_plugin_descriptors_new ();
@@ -547,68 +551,6 @@ get_vst3_paths (PluginManager * self)
 #  endif // __APPLE__
 }
 
-static int
-get_vst3_count (PluginManager * self)
-{
-  char ** paths = get_vst3_paths (self);
-  g_return_val_if_fail (paths, 0);
-  int    path_idx = 0;
-  char * path;
-  int    count = 0;
-  while ((path = paths[path_idx++]) != NULL)
-    {
-      if (!g_file_test (path, G_FILE_TEST_EXISTS))
-        continue;
-
-      char ** vst_plugins = io_get_files_in_dir_ending_in (
-        path, 1, ".vst3", false);
-      if (!vst_plugins)
-        continue;
-
-      char * plugin_path;
-      int    plugin_idx = 0;
-      while ((plugin_path = vst_plugins[plugin_idx++]) != NULL)
-        {
-          count++;
-        }
-      g_strfreev (vst_plugins);
-    }
-  g_strfreev (paths);
-
-  return count;
-}
-
-static int
-get_vst_count (PluginManager * self)
-{
-  char ** paths = get_vst_paths (self);
-  g_return_val_if_fail (paths, 0);
-  int    path_idx = 0;
-  char * path;
-  int    count = 0;
-  while ((path = paths[path_idx++]) != NULL)
-    {
-      if (!g_file_test (path, G_FILE_TEST_EXISTS))
-        continue;
-
-      char ** vst_plugins = io_get_files_in_dir_ending_in (
-        path, 1, LIB_SUFFIX, false);
-      if (!vst_plugins)
-        continue;
-
-      char * plugin_path;
-      int    plugin_idx = 0;
-      while ((plugin_path = vst_plugins[plugin_idx++]) != NULL)
-        {
-          count++;
-        }
-      g_strfreev (vst_plugins);
-    }
-  g_strfreev (paths);
-
-  return count;
-}
-
 /**
  * Gets the SFZ or SF2 paths.
  */
@@ -633,38 +575,6 @@ get_sf_paths (PluginManager * self, bool sf2)
   return paths;
 }
 
-static int
-get_sf_count (PluginManager * self, PluginProtocol prot)
-{
-  char ** paths = get_sf_paths (self, prot == PROT_SF2);
-  g_return_val_if_fail (paths, 0);
-  int    path_idx = 0;
-  char * path;
-  int    count = 0;
-  while ((path = paths[path_idx++]) != NULL)
-    {
-      if (!g_file_test (path, G_FILE_TEST_EXISTS))
-        continue;
-
-      char ** sf_instruments = io_get_files_in_dir_ending_in (
-        path, 1, (prot == PROT_SFZ) ? ".sfz" : ".sf2", false);
-      if (!sf_instruments)
-        continue;
-
-      char * plugin_path;
-      int    plugin_idx = 0;
-      while (
-        (plugin_path = sf_instruments[plugin_idx++]) != NULL)
-        {
-          count++;
-        }
-      g_strfreev (sf_instruments);
-    }
-  g_strfreev (paths);
-
-  return count;
-}
-
 static char **
 get_dssi_paths (PluginManager * self)
 {
@@ -813,271 +723,569 @@ plugin_manager_supports_protocol (
 }
 
 #ifdef HAVE_CARLA
+/**
+ * A single carla-discovery scan, run on a worker
+ * thread of the scan pool.
+ */
+typedef struct PluginScanJob
+{
+  /** Path to the plugin file/bundle. */
+  char *         path;
+  PluginProtocol protocol;
+
+  /** NULL-terminated array of scanned descriptors,
+   * or NULL if the scan failed, crashed or timed
+   * out. */
+  PluginDescriptor ** descriptors;
+} PluginScanJob;
+
+static PluginScanJob *
+plugin_scan_job_new (
+  const char *   path,
+  PluginProtocol protocol)
+{
+  PluginScanJob * self = object_new (PluginScanJob);
+  self->path = g_strdup (path);
+  self->protocol = protocol;
+
+  return self;
+}
+
 static void
-scan_carla_descriptors_from_paths (
-  PluginManager * self,
-  PluginProtocol  protocol,
-  unsigned int *  count,
-  const double    size,
-  double *        progress,
-  const double    start_progress,
-  const double    max_progress)
+plugin_scan_job_free (PluginScanJob * self)
+{
+  g_free_and_null (self->path);
+
+  /* descriptors are owned by the plugin manager
+   * at this point, only free the array */
+  free (self->descriptors);
+
+  object_zero_and_free (self);
+}
+
+/**
+ * Thread pool func.
+ *
+ * Each call spawns a separate carla-discovery
+ * process, so a crashing or hanging plugin only
+ * affects its own job (the process gets killed
+ * after the timeout and the job returns no
+ * descriptors).
+ *
+ * @param data The PluginScanJob.
+ * @param user_data The GAsyncQueue to push the
+ *   finished job to.
+ */
+static void
+scan_job_thread_func (gpointer data, gpointer user_data)
+{
+  PluginScanJob * job = (PluginScanJob *) data;
+  GAsyncQueue *   results = (GAsyncQueue *) user_data;
+
+  job->descriptors =
+    z_carla_discovery_create_descriptors_from_file (
+      job->path, ARCH_64, job->protocol);
+
+  /* try 32-bit if above failed */
+  if (!job->descriptors)
+    {
+      g_debug (
+        "no descriptors for %s, trying 32bit...", job->path);
+      job->descriptors =
+        z_carla_discovery_create_descriptors_from_file (
+          job->path, ARCH_32, job->protocol);
+    }
+
+  g_async_queue_push (results, job);
+}
+
+static void
+update_scan_progress (
+  unsigned int   count,
+  const double   size,
+  double *       progress,
+  const double   start_progress,
+  const double   max_progress,
+  PluginProtocol protocol,
+  const char *   plugin_path,
+  const char *   scanned_name)
 {
+  if (!progress)
+    return;
 
   const char * protocol_str =
     plugin_protocol_to_str (protocol);
-  if (!plugin_manager_supports_protocol (self, protocol))
+  *progress =
+    start_progress
+    + ((double) count / size)
+        * (max_progress - start_progress);
+  char prog_str[800];
+  if (scanned_name)
     {
-      g_message (
-        "Plugin protocol %s not supported in this "
-        "build",
-        protocol_str);
-      return;
+      sprintf (
+        prog_str, _ ("Scanned %s plugin: %s"), protocol_str,
+        scanned_name);
     }
-  g_message ("Scanning %s plugins...", protocol_str);
+  else
+    {
+      sprintf (
+        prog_str,
+        /* TRANSLATORS: first argument
+         * is plugin protocol, 2nd
+         * argument is path */
+        _ ("Skipped %1$s plugin at "
+           "%2$s"),
+        protocol_str, plugin_path);
+    }
+  zrythm_app_set_progress_status (
+    zrythm_app, prog_str, *progress);
+}
+
+/**
+ * Plugin files of a protocol that is scanned
+ * through carla.
+ */
+typedef struct PluginFileListing
+{
+  PluginProtocol protocol;
+
+  /** Directories to search. */
+  char ** paths;
+
+  /** Suffix of the plugin files. */
+  const char * suffix;
+
+  /** Paths of the plugin files found. */
+  GPtrArray * files;
+} PluginFileListing;
+
+static void
+plugin_file_listing_free (PluginFileListing * self)
+{
+  g_strfreev (self->paths);
+  g_ptr_array_unref (self->files);
+
+  object_zero_and_free (self);
+}
+
+static PluginFileListing *
+plugin_file_listing_new (
+  PluginManager * mgr,
+  PluginProtocol  protocol)
+{
+  PluginFileListing * self =
+    object_new (PluginFileListing);
+  self->protocol = protocol;
+  self->files = g_ptr_array_new_with_free_func (g_free);
 
-  /* get paths and suffix */
-  char **      paths = NULL;
-  const char * suffix = NULL;
   switch (protocol)
     {
     case PROT_VST:
-      paths = get_vst_paths (self);
+      self->paths = get_vst_paths (mgr);
 #  ifdef __APPLE__
-      suffix = ".vst";
+      self->suffix = ".vst";
 #  else
-      suffix = LIB_SUFFIX;
+      self->suffix = LIB_SUFFIX;
 #  endif
       break;
     case PROT_VST3:
-      paths = get_vst3_paths (self);
-      suffix = ".vst3";
+      self->paths = get_vst3_paths (mgr);
+      self->suffix = ".vst3";
       break;
     case PROT_DSSI:
-      paths = get_dssi_paths (self);
-      suffix = LIB_SUFFIX;
+      self->paths = get_dssi_paths (mgr);
+      self->suffix = LIB_SUFFIX;
       break;
     case PROT_LADSPA:
-      paths = get_ladspa_paths (self);
-      suffix = LIB_SUFFIX;
+      self->paths = get_ladspa_paths (mgr);
+      self->suffix = LIB_SUFFIX;
       break;
     case PROT_SFZ:
-      paths = get_sf_paths (self, false);
-      suffix = ".sfz";
+      self->paths = get_sf_paths (mgr, false);
+      self->suffix = ".sfz";
       break;
     case PROT_SF2:
-      paths = get_sf_paths (self, true);
-      suffix = ".sf2";
+      self->paths = get_sf_paths (mgr, true);
+      self->suffix = ".sf2";
       break;
     default:
       break;
     }
-  g_return_if_fail (paths && suffix);
+  if (!self->paths || !self->suffix)
+    {
+      plugin_file_listing_free (self);
+      g_return_val_if_reached (NULL);
+    }
+
+  return self;
+}
+
+/**
+ * Thread pool func that finds the plugin files of
+ * a PluginFileListing.
+ */
+static void
+list_plugin_files_thread_func (
+  gpointer data,
+  gpointer user_data)
+{
+  PluginFileListing * listing = (PluginFileListing *) data;
 
   int    path_idx = 0;
   char * path;
-  while ((path = paths[path_idx++]) != NULL)
+  while ((path = listing->paths[path_idx++]) != NULL)
     {
       if (!g_file_test (path, G_FILE_TEST_EXISTS))
         continue;
 
       g_message (
-        "scanning for %s plugins in %s", protocol_str, path);
+        "scanning for %s plugins in %s",
+        plugin_protocol_to_str (listing->protocol), path);
 
       char ** plugins = io_get_files_in_dir_ending_in (
-        path, 1, suffix, false);
+        path, 1, listing->suffix, false);
       if (!plugins)
         continue;
 
-      char * plugin_path;
-      int    plugin_idx = 0;
-      while ((plugin_path = plugins[plugin_idx++]) != NULL)
+      /* move the strings to the listing */
+      for (int i = 0; plugins[i]; i++)
         {
-          PluginDescriptor ** descriptors =
-            cached_plugin_descriptors_get (
-              self->cached_plugin_descriptors, plugin_path);
+          g_ptr_array_add (listing->files, plugins[i]);
+        }
+      free (plugins);
+    }
+}
 
-          /* if any cached descriptors are found */
-          if (descriptors)
+/**
+ * Finds the plugin files of the protocols scanned
+ * through carla, walking the directories of each
+ * protocol on a separate thread.
+ *
+ * @return An array of PluginFileListing.
+ */
+static GPtrArray *
+list_carla_plugin_files (PluginManager * self)
+{
+  const PluginProtocol protocols[] = {
+#  if !defined(_WOE32) && !defined(__APPLE__)
+    PROT_LADSPA,
+    PROT_DSSI,
+#  endif
+    PROT_VST,
+    PROT_VST3,
+    PROT_SFZ,
+    PROT_SF2,
+  };
+
+  GPtrArray * listings = g_ptr_array_new_with_free_func (
+    (GDestroyNotify) plugin_file_listing_free);
+  for (size_t i = 0; i < G_N_ELEMENTS (protocols); i++)
+    {
+      if (!plugin_manager_supports_protocol (
+            self, protocols[i]))
+        {
+          g_message (
+            "Plugin protocol %s not supported in this "
+            "build",
+            plugin_protocol_to_str (protocols[i]));
+          continue;
+        }
+
+      PluginFileListing * listing =
+        plugin_file_listing_new (self, protocols[i]);
+      if (listing)
+        g_ptr_array_add (listings, listing);
+    }
+  if (listings->len == 0)
+    return listings;
+
+  GError *      err = NULL;
+  GThreadPool * pool = g_thread_pool_new (
+    list_plugin_files_thread_func, NULL,
+    (int) listings->len, F_NOT_EXCLUSIVE, &err);
+  if (!pool)
+    {
+      g_warning (
+        "failed to create plugin listing pool, listing "
+        "on this thread: %s",
+        err->message);
+      g_error_free (err);
+    }
+  for (size_t i = 0; i < listings->len; i++)
+    {
+      gpointer listing = g_ptr_array_index (listings, i);
+      if (pool)
+        g_thread_pool_push (pool, listing, NULL);
+      else
+        list_plugin_files_thread_func (listing, NULL);
+    }
+
+  /* wait for all listings to finish */
+  if (pool)
+    g_thread_pool_free (pool, false, true);
+
+  return listings;
+}
+
+/**
+ * Collects the plugins of the given listing.
+ *
+ * Cached, blacklisted and soundfont plugins are
+ * handled immediately. Plugins that need to be
+ * scanned with carla-discovery are appended to
+ * @p jobs to be run in parallel later.
+ */
+static void
+scan_carla_descriptors_from_listing (
+  PluginManager *           self,
+  const PluginFileListing * listing,
+  GPtrArray *               jobs,
+  unsigned int *            count,
+  const double              size,
+  double *                  progress,
+  const double              start_progress,
+  const double              max_progress)
+{
+  PluginProtocol protocol = listing->protocol;
+  const char *   protocol_str =
+    plugin_protocol_to_str (protocol);
+  g_message ("Scanning %s plugins...", protocol_str);
+
+  for (size_t idx = 0; idx < listing->files->len; idx++)
+    {
+      const char * plugin_path =
+        (const char *) g_ptr_array_index (
+          listing->files, idx);
+
+      PluginDescriptor ** descriptors =
+        cached_plugin_descriptors_get (
+          self->cached_plugin_descriptors, plugin_path);
+
+      /* if any cached descriptors are found */
+      if (descriptors)
+        {
+          /* clone and add them to the list
+           * of descriptors */
+          PluginDescriptor * descriptor = NULL;
+          int                i = 0;
+          while ((descriptor = descriptors[i++]))
             {
-              /* clone and add them to the list
-               * of descriptors */
-              PluginDescriptor * descriptor = NULL;
-              int                i = 0;
-              while ((descriptor = descriptors[i++]))
+              g_debug (
+                "Found cached %s %s", protocol_str,
+                descriptor->name);
+              PluginDescriptor * clone =
+                plugin_descriptor_clone (descriptor);
+              g_ptr_array_add (
+                self->plugin_descriptors, clone);
+              add_category_and_author (
+                self, clone->category_str, clone->author);
+            }
+        }
+      /* if no cached descriptors found */
+      else
+        {
+          g_debug (
+            "No cached descriptors found for "
+            "%s",
+            plugin_path);
+          if (cached_plugin_descriptors_is_blacklisted (
+                self->cached_plugin_descriptors,
+                plugin_path))
+            {
+              g_message (
+                "Ignoring blacklisted %s "
+                "plugin: %s",
+                protocol_str, plugin_path);
+            }
+          else if (
+            protocol == PROT_SFZ || protocol == PROT_SF2)
+            {
+              descriptors =
+                object_new_n (2, PluginDescriptor *);
+              descriptors[0] = plugin_descriptor_new ();
+              PluginDescriptor * descr = descriptors[0];
+              descr->path = g_strdup (plugin_path);
+              GFile * file =
+                g_file_new_for_path (descr->path);
+              descr->ghash = g_file_hash (file);
+              g_object_unref (file);
+              descr->category = PC_INSTRUMENT;
+              descr->category_str =
+                plugin_descriptor_category_to_string (
+                  descr->category);
+              descr->name =
+                io_path_get_basename_without_ext (
+                  plugin_path);
+              char * parent_path =
+                io_path_get_parent_dir (plugin_path);
+              if (!parent_path)
                 {
-                  g_debug (
-                    "Found cached %s %s", protocol_str,
-                    descriptor->name);
-                  PluginDescriptor * clone =
-                    plugin_descriptor_clone (descriptor);
-                  g_ptr_array_add (
-                    self->plugin_descriptors, clone);
-                  add_category_and_author (
-                    self, clone->category_str, clone->author);
+                  g_warning (
+                    "Failed to get parent dir of "
+                    "%s",
+                    plugin_path);
+                  plugin_descriptor_free (descr);
+                  descriptors[0] = NULL;
+                  free (descriptors);
+                  continue;
                 }
+              descr->author =
+                g_path_get_basename (parent_path);
+              g_free (parent_path);
+              descr->num_audio_outs = 2;
+              descr->num_midi_ins = 1;
+              descr->arch = ARCH_64;
+              descr->protocol = protocol;
+
+              g_ptr_array_add (
+                self->plugin_descriptors, descr);
+              add_category_and_author (
+                self, descr->category_str,
+                descr->author);
+              cached_plugin_descriptors_add (
+                self->cached_plugin_descriptors,
+                plugin_descriptor_clone (descr),
+                F_NO_SERIALIZE);
             }
-          /* if no cached descriptors found */
           else
             {
-              g_debug (
-                "No cached descriptors found for "
-                "%s",
-                plugin_path);
-              if (cached_plugin_descriptors_is_blacklisted (
-                    self->cached_plugin_descriptors,
-                    plugin_path))
-                {
-                  g_message (
-                    "Ignoring blacklisted %s "
-                    "plugin: %s",
-                    protocol_str, plugin_path);
-                }
-              else
-                {
-                  if (protocol == PROT_SFZ || protocol == PROT_SF2)
-                    {
-                      descriptors =
-                        object_new_n (2, PluginDescriptor *);
-                      descriptors[0] =
-                        plugin_descriptor_new ();
-                      PluginDescriptor * descr =
-                        descriptors[0];
-                      descr->path = g_strdup (plugin_path);
-                      GFile * file =
-                        g_file_new_for_path (descr->path);
-                      descr->ghash = g_file_hash (file);
-                      g_object_unref (file);
-                      descr->category = PC_INSTRUMENT;
-                      descr->category_str =
-                        plugin_descriptor_category_to_string (
-                          descr->category);
-                      descr->name =
-                        io_path_get_basename_without_ext (
-                          plugin_path);
-                      char * parent_path =
-                        io_path_get_parent_dir (plugin_path);
-                      if (!parent_path)
-                        {
-                          g_warning (
-                            "Failed to get parent dir of "
-                            "%s",
-                            plugin_path);
-                          plugin_descriptor_free (descr);
-                          descriptors[0] = NULL;
-                          continue;
-                        }
-                      descr->author =
-                        g_path_get_basename (parent_path);
-                      g_free (parent_path);
-                      descr->num_audio_outs = 2;
-                      descr->num_midi_ins = 1;
-                      descr->arch = ARCH_64;
-                      descr->protocol = protocol;
-                    }
-                  else
-                    {
-                      descriptors =
-                        z_carla_discovery_create_descriptors_from_file (
-                          plugin_path, ARCH_64, protocol);
-
-                      /* try 32-bit if above failed */
-                      if (!descriptors)
-                        {
-                          g_debug (
-                            "no descriptors for %s, "
-                            "trying 32bit...",
-                            plugin_path);
-                          descriptors =
-                            z_carla_discovery_create_descriptors_from_file (
-                              plugin_path, ARCH_32, protocol);
-                        }
-                    }
-
-                  g_debug (
-                    "descriptors for %s: %p", plugin_path,
-                    descriptors);
-
-                  if (descriptors)
-                    {
-                      PluginDescriptor * descriptor = NULL;
-                      int                i = 0;
-                      while ((descriptor = descriptors[i++]))
-                        {
-                          g_ptr_array_add (
-                            self->plugin_descriptors,
-                            descriptor);
-                          add_category_and_author (
-                            self, descriptor->category_str,
-                            descriptor->author);
-                          g_message (
-                            "Caching %s %s", protocol_str,
-                            descriptor->name);
-
-                          PluginDescriptor * clone =
-                            plugin_descriptor_clone (
-                              descriptor);
-                          cached_plugin_descriptors_add (
-                            self->cached_plugin_descriptors,
-                            clone, F_NO_SERIALIZE);
-                        }
-                      g_debug (
-                        "%d descriptors cached for "
-                        "%s",
-                        i - 1, plugin_path);
-                    }
-                  else
-                    {
-                      g_message (
-                        "Blacklisting %s %s", protocol_str,
-                        plugin_path);
-                      cached_plugin_descriptors_blacklist (
-                        self->cached_plugin_descriptors,
-                        plugin_path, 0);
-                    }
-                }
+              /* scan later in the pool */
+              g_ptr_array_add (
+                jobs,
+                plugin_scan_job_new (
+                  plugin_path, protocol));
+              continue;
             }
-          (*count)++;
+        }
+      (*count)++;
 
-          if (progress)
+      update_scan_progress (
+        *count, size, progress, start_progress,
+        max_progress, protocol, plugin_path,
+        descriptors ? descriptors[0]->name : NULL);
+      free (descriptors);
+    }
+}
+
+/**
+ * Runs the given scan jobs in a bounded pool of
+ * worker threads (each running its own
+ * carla-discovery process) and merges the results
+ * into the plugin manager and the cache.
+ *
+ * If the pool cannot be created, the jobs are run
+ * one by one on the calling thread.
+ *
+ * Plugins whose scan fails, crashes or times out
+ * are blacklisted.
+ */
+static void
+run_scan_jobs (
+  PluginManager * self,
+  GPtrArray *     jobs,
+  unsigned int *  count,
+  const double    size,
+  double *        progress,
+  const double    start_progress,
+  const double    max_progress)
+{
+  if (jobs->len == 0)
+    return;
+
+  int num_threads = env_get_int (
+    "ZRYTHM_PLUGIN_SCAN_THREADS",
+    (int) g_get_num_processors ());
+  num_threads = CLAMP (num_threads, 1, (int) jobs->len);
+  g_message (
+    "scanning %u plugins with %d threads", jobs->len,
+    num_threads);
+
+  GAsyncQueue * results = g_async_queue_new ();
+  GError *      err = NULL;
+  GThreadPool * pool = g_thread_pool_new (
+    scan_job_thread_func, results, num_threads,
+    F_NOT_EXCLUSIVE, &err);
+  if (pool)
+    {
+      for (size_t i = 0; i < jobs->len; i++)
+        {
+          g_thread_pool_push (
+            pool, g_ptr_array_index (jobs, i), NULL);
+        }
+    }
+  else
+    {
+      /* scan the jobs one by one below instead */
+      g_warning (
+        "failed to create plugin scan pool, scanning "
+        "on this thread: %s",
+        err->message);
+      g_error_free (err);
+    }
+
+  /* merge results as they come in */
+  for (size_t i = 0; i < jobs->len; i++)
+    {
+      if (!pool)
+        {
+          scan_job_thread_func (
+            g_ptr_array_index (jobs, i), results);
+        }
+
+      PluginScanJob * job =
+        (PluginScanJob *) g_async_queue_pop (results);
+      const char * protocol_str =
+        plugin_protocol_to_str (job->protocol);
+
+      g_debug (
+        "descriptors for %s: %p", job->path,
+        job->descriptors);
+
+      if (job->descriptors)
+        {
+          PluginDescriptor * descriptor = NULL;
+          int                j = 0;
+          while ((descriptor = job->descriptors[j++]))
             {
-              *progress =
-                start_progress
-                + ((double) *count / size)
-                    * (max_progress - start_progress);
-              char prog_str[800];
-              if (descriptors)
-                {
-                  sprintf (
-                    prog_str, _ ("Scanned %s plugin: %s"),
-                    protocol_str, descriptors[0]->name);
+              g_ptr_array_add (
+                self->plugin_descriptors, descriptor);
+              add_category_and_author (
+                self, descriptor->category_str,
+                descriptor->author);
+              g_message (
+                "Caching %s %s", protocol_str,
+                descriptor->name);
 
-                  free (descriptors);
-                  descriptors = NULL;
-                }
-              else
-                {
-                  sprintf (
-                    prog_str,
-                    /* TRANSLATORS: first argument
-                     * is plugin protocol, 2nd
-                     * argument is path */
-                    _ ("Skipped %1$s plugin at "
-                       "%2$s"),
-                    protocol_str, plugin_path);
-                }
-              zrythm_app_set_progress_status (
-                zrythm_app, prog_str, *progress);
+              PluginDescriptor * clone =
+                plugin_descriptor_clone (descriptor);
+              cached_plugin_descriptors_add (
+                self->cached_plugin_descriptors, clone,
+                F_NO_SERIALIZE);
             }
+          g_debug (
+            "%d descriptors cached for %s", j - 1,
+            job->path);
         }
-      if (plugin_idx > 0 && !ZRYTHM_TESTING)
+      else
         {
-          cached_plugin_descriptors_serialize_to_file (
-            self->cached_plugin_descriptors);
+          g_message (
+            "Blacklisting %s %s", protocol_str, job->path);
+          cached_plugin_descriptors_blacklist (
+            self->cached_plugin_descriptors, job->path,
+            F_NO_SERIALIZE);
         }
-      g_strfreev (plugins);
+
+      (*count)++;
+
+      update_scan_progress (
+        *count, size, progress, start_progress,
+        max_progress, job->protocol, job->path,
+        job->descriptors ? job->descriptors[0]->name : NULL);
     }
-  g_strfreev (paths);
+
+  if (pool)
+    g_thread_pool_free (pool, false, true);
+  g_async_queue_unref (results);
 }
 #endif
 
@@ -1111,12 +1319,27 @@ plugin_manager_scan_plugins (
   if (getenv ("ZRYTHM_SKIP_PLUGIN_SCAN"))
     return;
 
+  /* URIs/paths of the plugins found, to forget the
+   * cached ones that were removed */
+  GHashTable * found_keys =
+    g_hash_table_new (g_str_hash, g_str_equal);
+
   double size = (double) lilv_plugins_size (lilv_plugins);
 #ifdef HAVE_CARLA
-  size += (double) get_vst_count (self);
-  size += (double) get_vst3_count (self);
-  size += (double) get_sf_count (self, PROT_SFZ);
-  size += (double) get_sf_count (self, PROT_SF2);
+  GPtrArray * listings = list_carla_plugin_files (self);
+  for (size_t i = 0; i < listings->len; i++)
+    {
+      PluginFileListing * listing =
+        (PluginFileListing *) g_ptr_array_index (
+          listings, i);
+      size += (double) listing->files->len;
+      for (size_t j = 0; j < listing->files->len; j++)
+        {
+          g_hash_table_add (
+            found_keys,
+            g_ptr_array_index (listing->files, j));
+        }
+    }
 #  ifdef __APPLE__
   size += carla_get_cached_plugin_count (PLUGIN_AU, NULL);
 #  endif
@@ -1125,13 +1348,40 @@ plugin_manager_scan_plugins (
   /* scan LV2 */
   g_message ("%s: Scanning LV2 plugins...", __func__);
   unsigned int count = 0;
+  unsigned int num_lv2_from_cache = 0;
+  bool         cache_changed = false;
   LILV_FOREACH (plugins, i, lilv_plugins)
     {
       const LilvPlugin * p =
         lilv_plugins_get (lilv_plugins, i);
 
-      PluginDescriptor * descriptor =
-        lv2_plugin_create_descriptor_from_lilv (p);
+      const char * uri =
+        lilv_node_as_uri (lilv_plugin_get_uri (p));
+      g_hash_table_add (found_keys, (char *) uri);
+      char * bundle_path = lilv_file_uri_parse (
+        lilv_node_as_uri (lilv_plugin_get_bundle_uri (p)),
+        NULL);
+
+      /* skip the (expensive) descriptor creation if
+       * the bundle hasn't changed since it was
+       * cached */
+      PluginDescriptor *       descriptor = NULL;
+      const PluginDescriptor * cached_descr =
+        bundle_path
+          ? cached_plugin_descriptors_get_lv2 (
+            self->cached_plugin_descriptors, uri,
+            bundle_path)
+          : NULL;
+      if (cached_descr)
+        {
+          descriptor = plugin_descriptor_clone (cached_descr);
+          num_lv2_from_cache++;
+        }
+      else
+        {
+          descriptor =
+            lv2_plugin_create_descriptor_from_lilv (p);
+        }
 
       if (descriptor)
         {
@@ -1141,8 +1391,11 @@ plugin_manager_scan_plugins (
           add_category_and_author (
             self, descriptor->category_str,
             descriptor->author);
+        }
 
-          /* update descriptor in cached */
+      /* update descriptor in cached */
+      if (descriptor && !cached_descr)
+        {
           const PluginDescriptor * found_descr =
             cached_plugin_descriptors_find (
               self->cached_plugin_descriptors, descriptor,
@@ -1163,7 +1416,7 @@ plugin_manager_scan_plugins (
                      != descriptor->num_cv_outs)
                 cached_plugin_descriptors_replace (
                   self->cached_plugin_descriptors, descriptor,
-                  F_SERIALIZE);
+                  F_NO_SERIALIZE);
             }
           else
             {
@@ -1171,7 +1424,15 @@ plugin_manager_scan_plugins (
                 self->cached_plugin_descriptors, descriptor,
                 F_NO_SERIALIZE);
             }
+          if (bundle_path)
+            {
+              cached_plugin_descriptors_stamp_lv2 (
+                self->cached_plugin_descriptors, uri,
+                bundle_path);
+            }
+          cache_changed = true;
         }
+      lilv_free (bundle_path);
 
       count++;
 
@@ -1202,44 +1463,52 @@ plugin_manager_scan_plugins (
             zrythm_app, prog_str, *progress);
         }
     }
-  g_message ("%s: Scanned %d LV2 plugins", __func__, count);
-
-  cached_plugin_descriptors_serialize_to_file (
-    self->cached_plugin_descriptors);
+  g_message (
+    "%s: Scanned %d LV2 plugins (%u unchanged since "
+    "last scan)",
+    __func__, count, num_lv2_from_cache);
 
-#ifdef HAVE_CARLA
+  if (cached_plugin_descriptors_remove_missing (
+        self->cached_plugin_descriptors, found_keys))
+    {
+      cache_changed = true;
+    }
+  g_hash_table_unref (found_keys);
 
-#  if !defined(_WOE32) && !defined(__APPLE__)
-  /* scan ladspa */
-  scan_carla_descriptors_from_paths (
-    self, PROT_LADSPA, &count, size, progress, start_progress,
-    max_progress);
+  if (cache_changed)
+    {
+      cached_plugin_descriptors_serialize_to_file (
+        self->cached_plugin_descriptors);
+    }
 
-  /* scan dssi */
-  scan_carla_descriptors_from_paths (
-    self, PROT_DSSI, &count, size, progress, start_progress,
-    max_progress);
-#  endif /* not apple/woe32 */
+#ifdef HAVE_CARLA
 
-  /* scan vst */
-  scan_carla_descriptors_from_paths (
-    self, PROT_VST, &count, size, progress, start_progress,
-    max_progress);
+  /* collect plugins that need to be scanned and
+   * scan them all together in parallel */
+  GPtrArray * scan_jobs = g_ptr_array_new_with_free_func (
+    (GDestroyNotify) plugin_scan_job_free);
 
-  /* scan vst3 */
-  scan_carla_descriptors_from_paths (
-    self, PROT_VST3, &count, size, progress, start_progress,
-    max_progress);
+  for (size_t i = 0; i < listings->len; i++)
+    {
+      scan_carla_descriptors_from_listing (
+        self,
+        (PluginFileListing *) g_ptr_array_index (
+          listings, i),
+        scan_jobs, &count, size, progress, start_progress,
+        max_progress);
+    }
+  g_ptr_array_unref (listings);
 
-  /* scan sfz */
-  scan_carla_descriptors_from_paths (
-    self, PROT_SFZ, &count, size, progress, start_progress,
+  run_scan_jobs (
+    self, scan_jobs, &count, size, progress, start_progress,
     max_progress);
+  g_ptr_array_unref (scan_jobs);
 
-  /* scan sf2 */
-  scan_carla_descriptors_from_paths (
-    self, PROT_SF2, &count, size, progress, start_progress,
-    max_progress);
+  if (!ZRYTHM_TESTING)
+    {
+      cached_plugin_descriptors_serialize_to_file (
+        self->cached_plugin_descriptors);
+    }
 
 #  ifdef __APPLE__
   /* scan AU plugins */
@@ -1408,6 +1677,9 @@ plugin_manager_free (PluginManager * self)
 {
   g_debug ("%s: Freeing...", __func__);
 
+  object_free_w_func_and_null (
+    lv2_worker_pool_free, self->lv2_worker_pool);
+
   symap_free (self->symap);
   zix_sem_destroy (&self->symap_lock);
 
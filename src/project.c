@@ -48,6 +48,7 @@
 #include "plugins/carla_native_plugin.h"
 #include "plugins/lv2/lv2_state.h"
 #include "plugins/lv2_plugin.h"
+#include "plugins/plugin.h"
 #include "project.h"
 #include "settings/settings.h"
 #include "utils/arrays.h"
@@ -1798,12 +1799,40 @@ project_save (
         }
     }
 
+  /* save the plugin states in parallel so that
+   * cloning the plugins below does not need to */
+  GPtrArray * plugins = g_ptr_array_new ();
+  plugin_get_all (PROJECT, plugins, false);
+  GPtrArray * snapshots =
+    plugin_snapshot_states (plugins, F_NOT_BACKUP);
+
+  /* let the engine run while the states are
+   * written */
+  if (engine_paused)
+    {
+      engine_resume (AUDIO_ENGINE, &state);
+    }
+  plugin_write_state_snapshots (snapshots);
+  if (engine_paused)
+    {
+      engine_wait_for_pause (
+        AUDIO_ENGINE, &state, Z_F_NO_FORCE);
+    }
+
   ProjectSaveData * data = object_new (ProjectSaveData);
   data->project_file_path = project_get_path (
     self, PROJECT_PATH_PROJECT_FILE, is_backup);
   data->show_notification = show_notification;
   data->is_backup = is_backup;
   data->project = project_clone (PROJECT, is_backup);
+
+  for (size_t i = 0; i < plugins->len; i++)
+    {
+      Plugin * pl = (Plugin *) g_ptr_array_index (plugins, i);
+      pl->state_saved = false;
+    }
+  g_ptr_array_unref (plugins);
+
   g_return_val_if_fail (data->project, -1);
   g_return_val_if_fail (
     data->project->tracklist_selections, -1);
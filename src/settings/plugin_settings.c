@@ -193,14 +193,6 @@ plugin_setting_validate (PluginSetting * self)
         }
     }
 
-#  if 0
-  /* force bridge mode */
-  if (self->bridge_mode == CARLA_BRIDGE_NONE)
-    {
-      self->bridge_mode = CARLA_BRIDGE_FULL;
-    }
-#  endif
-
     /*g_debug ("done recalculating bridge mode");*/
 #endif
 
@@ -43,6 +43,7 @@
 #include "gui/widgets/right_dock_edge.h"
 #include "gui/widgets/visibility.h"
 #include "settings/settings.h"
+#include "utils/env.h"
 #include "utils/gtk.h"
 #include "utils/io.h"
 #include "utils/objects.h"
@@ -2164,3 +2165,103 @@ z_graphene_rect_print (const graphene_rect_t * rect)
     "graphene rect: x %f y %f w %f h %f", rect->origin.x,
     rect->origin.y, rect->size.width, rect->size.height);
 }
+
+bool
+z_gtk_widget_queue_draw_if_changed (
+  GtkWidget * widget,
+  guint64     version)
+{
+  static GQuark quark = 0;
+  if (G_UNLIKELY (quark == 0))
+    {
+      quark = g_quark_from_static_string (
+        "z-gtk-widget-draw-version");
+    }
+
+  guint64 * last_version =
+    g_object_get_qdata (G_OBJECT (widget), quark);
+  if (last_version && *last_version == version)
+    return false;
+
+  if (!last_version)
+    {
+      last_version = g_new (guint64, 1);
+      g_object_set_qdata_full (
+        G_OBJECT (widget), quark, last_version, g_free);
+    }
+  *last_version = version;
+  gtk_widget_queue_draw (widget);
+
+  return true;
+}
+
+/**
+ * Redraws of a widget counted by
+ * z_gtk_widget_snapshot_redraw_count().
+ */
+typedef struct RedrawCount
+{
+  /** Start of the current second. */
+  gint64 second_start;
+
+  /** Redraws in the current second. */
+  int count;
+
+  /** Redraws in the previous second. */
+  int last_count;
+} RedrawCount;
+
+void
+z_gtk_widget_snapshot_redraw_count (
+  GtkWidget *   widget,
+  GtkSnapshot * snapshot)
+{
+  static int enabled = -1;
+  if (G_UNLIKELY (enabled < 0))
+    {
+      enabled = env_get_int ("ZRYTHM_DEBUG_REDRAWS", 0);
+    }
+  if (!enabled)
+    return;
+
+  static GQuark quark = 0;
+  if (G_UNLIKELY (quark == 0))
+    {
+      quark = g_quark_from_static_string (
+        "z-gtk-widget-redraw-count");
+    }
+
+  RedrawCount * rc =
+    g_object_get_qdata (G_OBJECT (widget), quark);
+  if (!rc)
+    {
+      rc = g_new0 (RedrawCount, 1);
+      g_object_set_qdata_full (
+        G_OBJECT (widget), quark, rc, g_free);
+    }
+
+  gint64 now = g_get_monotonic_time ();
+  if (now - rc->second_start >= G_USEC_PER_SEC)
+    {
+      /* if there were no redraws in the previous
+       * second, the count is for a longer period */
+      rc->last_count =
+        now - rc->second_start < 2 * G_USEC_PER_SEC
+          ? rc->count
+          : 0;
+      rc->count = 0;
+      rc->second_start = now;
+    }
+  rc->count++;
+
+  char str[40];
+  sprintf (str, "%d/s", rc->last_count);
+  PangoLayout * layout =
+    gtk_widget_create_pango_layout (widget, str);
+  gtk_snapshot_append_color (
+    snapshot, &Z_GDK_RGBA_INIT (0, 0, 0, 0.6f),
+    &GRAPHENE_RECT_INIT (0, 0, 40, 14));
+  gtk_snapshot_append_layout (
+    snapshot, layout, &Z_GDK_RGBA_INIT (1, 0.6f, 0, 1));
+  g_object_unref (layout);
+}
@@ -188,3 +188,15 @@ hash_get_for_struct (const void * const obj, size_t size)
 
   return hash;
 }
+
+uint64_t
+hash_fnv1a (uint64_t hash, const void * data, size_t size)
+{
+  const uint8_t * bytes = (const uint8_t *) data;
+  for (size_t i = 0; i < size; i++)
+    {
+      hash ^= bytes[i];
+      hash *= 0x100000001b3ULL;
+    }
+  return hash;
+}
@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <stdlib.h>
+
+#include "utils/interval_tree.h"
+#include "utils/objects.h"
+
+#include <glib.h>
+
+IntervalTree *
+interval_tree_new (void)
+{
+  IntervalTree * self = object_new (IntervalTree);
+
+  return self;
+}
+
+void
+interval_tree_add (
+  IntervalTree * self,
+  double         start,
+  double         end,
+  void *         data)
+{
+  g_return_if_fail (end >= start);
+
+  if (self->num_entries == self->entries_size)
+    {
+      self->entries_size = MAX (self->entries_size * 2, 64);
+      self->entries = g_realloc_n (
+        self->entries, self->entries_size,
+        sizeof (IntervalTreeEntry));
+    }
+
+  IntervalTreeEntry * entry =
+    &self->entries[self->num_entries];
+  entry->start = start;
+  entry->end = end;
+  entry->idx = self->num_entries;
+  entry->data = data;
+  self->num_entries++;
+  self->needs_build = true;
+}
+
+static int
+cmp_entry_start (const void * a, const void * b)
+{
+  const IntervalTreeEntry * ea = (const IntervalTreeEntry *) a;
+  const IntervalTreeEntry * eb = (const IntervalTreeEntry *) b;
+  if (ea->start < eb->start)
+    return -1;
+  if (ea->start > eb->start)
+    return 1;
+  return (ea->idx > eb->idx) - (ea->idx < eb->idx);
+}
+
+static int
+cmp_entry_idx (const void * a, const void * b)
+{
+  const IntervalTreeEntry * ea =
+    *(const IntervalTreeEntry * const *) a;
+  const IntervalTreeEntry * eb =
+    *(const IntervalTreeEntry * const *) b;
+  return (ea->idx > eb->idx) - (ea->idx < eb->idx);
+}
+
+/**
+ * Stores the max end of the range [lo, hi) at its
+ * middle entry and returns it.
+ */
+static double
+build_range (IntervalTree * self, size_t lo, size_t hi)
+{
+  size_t mid = lo + (hi - lo) / 2;
+  double max_end = self->entries[mid].end;
+  if (lo < mid)
+    {
+      max_end = MAX (max_end, build_range (self, lo, mid));
+    }
+  if (mid + 1 < hi)
+    {
+      max_end =
+        MAX (max_end, build_range (self, mid + 1, hi));
+    }
+  self->max_ends[mid] = max_end;
+
+  return max_end;
+}
+
+static void
+build (IntervalTree * self)
+{
+  qsort (
+    self->entries, self->num_entries,
+    sizeof (IntervalTreeEntry), cmp_entry_start);
+  self->max_ends = g_realloc_n (
+    self->max_ends, MAX (self->num_entries, 1),
+    sizeof (double));
+  if (self->num_entries > 0)
+    {
+      build_range (self, 0, self->num_entries);
+    }
+  self->needs_build = false;
+}
+
+static void
+query_range (
+  IntervalTree * self,
+  size_t         lo,
+  size_t         hi,
+  double         start,
+  double         end,
+  GPtrArray *    entries)
+{
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+
+      /* nothing in this range ends after the
+       * start */
+      if (self->max_ends[mid] < start)
+        return;
+
+      query_range (self, lo, mid, start, end, entries);
+
+      /* everything after the middle starts after
+       * the end */
+      IntervalTreeEntry * entry = &self->entries[mid];
+      if (entry->start > end)
+        return;
+
+      if (entry->end >= start)
+        {
+          g_ptr_array_add (entries, entry);
+        }
+
+      lo = mid + 1;
+    }
+}
+
+void
+interval_tree_query (
+  IntervalTree * self,
+  double         start,
+  double         end,
+  GPtrArray *    arr)
+{
+  if (self->needs_build)
+    {
+      build (self);
+    }
+
+  GPtrArray * entries = g_ptr_array_new ();
+  query_range (
+    self, 0, self->num_entries, start, end, entries);
+  g_ptr_array_sort (entries, cmp_entry_idx);
+  for (guint i = 0; i < entries->len; i++)
+    {
+      IntervalTreeEntry * entry =
+        (IntervalTreeEntry *) g_ptr_array_index (entries, i);
+      g_ptr_array_add (arr, entry->data);
+    }
+  g_ptr_array_unref (entries);
+}
+
+void
+interval_tree_clear (IntervalTree * self)
+{
+  self->num_entries = 0;
+  self->needs_build = true;
+}
+
+void
+interval_tree_free (IntervalTree * self)
+{
+  g_free_and_null (self->entries);
+  g_free_and_null (self->max_ends);
+
+  object_zero_and_free (self);
+}
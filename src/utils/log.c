@@ -946,16 +946,44 @@ handled:
   return G_LOG_WRITER_HANDLED;
 }
 
+/** Set by log_rt_mark_thread(). */
+static _Thread_local bool is_rt_thread = false;
+
+void
+log_rt_mark_thread (void)
+{
+  is_rt_thread = true;
+}
+
 /**
- * Log writer.
+ * Returns whether the queue may be flushed from
+ * the current thread.
  *
- * If a message is logged from the GTK thread,
- * the message is written immediately, otherwise it
- * is saved to the queue.
+ * Flushing writes to the log file and may show
+ * dialogs, so with a UI this is only done from the
+ * GTK thread. Without one (tests, headless runs)
+ * the idle callback may never run, so any thread
+ * flushes except the real-time log thread and the
+ * threads marked with log_rt_mark_thread().
+ */
+static bool
+can_flush_inline (Log * self)
+{
+  if (ZRYTHM_HAVE_UI)
+    return ZRYTHM_APP_IS_GTK_THREAD;
+
+  return self->rt_thread != g_thread_self ()
+         && !is_rt_thread;
+}
+
+/**
+ * Log writer.
  *
- * The queue is only popped when there is a new
- * message in the GTK thread, so the messages will
- * stay in the queue until then.
+ * Messages are saved to the queue, which is
+ * flushed when it is almost full if the current
+ * thread may flush it (see can_flush_inline()).
+ * Otherwise the message is dropped and counted if
+ * the queue is full.
  */
 static GLogWriterOutput
 log_writer (
@@ -969,6 +997,22 @@ log_writer (
 
   if (self->initialized)
     {
+      int num_avail_objs =
+        object_pool_get_num_available (self->obj_pool);
+      if (num_avail_objs < 200)
+        {
+          if (can_flush_inline (self))
+            {
+              log_idle_cb (self);
+            }
+          else if (num_avail_objs < 1)
+            {
+              g_atomic_int_inc (&self->rt_num_dropped);
+              g_free (str);
+              return G_LOG_WRITER_HANDLED;
+            }
+        }
+
       /* queue the message */
       LogEvent * ev =
         (LogEvent *) object_pool_get (self->obj_pool);
@@ -981,13 +1025,6 @@ log_writer (
             backtrace_get_with_lines ("", 100, true);
         }
 
-      int num_avail_objs =
-        object_pool_get_num_available (self->obj_pool);
-      if (num_avail_objs < 200)
-        {
-          log_idle_cb (self);
-        }
-
       mpmc_queue_push_back (self->mqueue, (void *) ev);
     }
   else
@@ -1046,6 +1083,343 @@ log_writer (
     }
 }
 
+/**
+ * Single-producer single-consumer ring of records
+ * logged by one thread.
+ */
+typedef struct LogRtRing
+{
+  LogRtRecord records[LOG_RT_RING_SIZE];
+
+  /** Incremented by the logging thread after
+   * writing a record. */
+  volatile guint write_idx;
+
+  /** Incremented by the log thread after reading a
+   * record. */
+  volatile guint read_idx;
+
+  /** Whether a thread owns this ring. */
+  volatile gint claimed;
+
+  /** Records dropped because the ring was full. */
+  volatile guint num_dropped;
+
+  /** Dropped records already reported (log thread
+   * only). */
+  guint num_dropped_reported;
+} LogRtRing;
+
+/**
+ * Rings for log_rt(), claimed by each thread on its
+ * first message.
+ *
+ * These outlive the Log so that threads can release
+ * their ring when they exit.
+ */
+static LogRtRing rt_rings[LOG_RT_MAX_THREADS];
+
+static void
+release_rt_ring (LogRtRing * ring)
+{
+  g_atomic_int_set (&ring->claimed, 0);
+}
+
+/** Ring claimed by the current thread. */
+static GPrivate rt_ring_key =
+  G_PRIVATE_INIT ((GDestroyNotify) release_rt_ring);
+
+/**
+ * Returns the ring of the current thread, claiming
+ * a free one on the first call.
+ */
+static LogRtRing *
+get_rt_ring (void)
+{
+  LogRtRing * ring =
+    (LogRtRing *) g_private_get (&rt_ring_key);
+  if (ring)
+    return ring;
+
+  for (int i = 0; i < LOG_RT_MAX_THREADS; i++)
+    {
+      ring = &rt_rings[i];
+      if (g_atomic_int_compare_and_exchange (
+            &ring->claimed, 0, 1))
+        {
+          g_private_set (&rt_ring_key, ring);
+          return ring;
+        }
+    }
+
+  return NULL;
+}
+
+void
+log_rt_push (
+  Log *            self,
+  GLogLevelFlags   log_level,
+  const char *     fmt,
+  const LogRtArg * args,
+  int              num_args)
+{
+  if (!self)
+    return;
+
+  LogRtRing * ring = get_rt_ring ();
+  if (!ring)
+    {
+      g_atomic_int_inc (&self->rt_num_dropped);
+      return;
+    }
+
+  guint write_idx = ring->write_idx;
+  if (
+    write_idx - (guint) g_atomic_int_get (&ring->read_idx)
+    >= LOG_RT_RING_SIZE)
+    {
+      g_atomic_int_inc (&ring->num_dropped);
+      return;
+    }
+
+  LogRtRecord * rec =
+    &ring->records[write_idx & (LOG_RT_RING_SIZE - 1)];
+  rec->log_level = log_level;
+  rec->fmt = fmt;
+  rec->num_args = MIN (num_args, LOG_RT_MAX_ARGS);
+  size_t strs_len = 0;
+  for (int i = 0; i < rec->num_args; i++)
+    {
+      LogRtArg * arg = &rec->args[i];
+      *arg = args[i];
+      if (arg->type != LOG_RT_ARG_STR)
+        continue;
+
+      /* copy the string */
+      const char * str =
+        args[i].val.s ? args[i].val.s : "(null)";
+      arg->val.str_offset =
+        MIN (strs_len, LOG_RT_STRS_SIZE - 1);
+      while (*str && strs_len < LOG_RT_STRS_SIZE - 1)
+        {
+          rec->strs[strs_len++] = *str++;
+        }
+      if (strs_len < LOG_RT_STRS_SIZE)
+        {
+          rec->strs[strs_len++] = '\0';
+        }
+    }
+
+  g_atomic_int_set (&ring->write_idx, write_idx + 1);
+}
+
+/**
+ * Appends the conversion spec in [spec, spec_end)
+ * formatted with @p arg.
+ *
+ * The length modifier of the spec is replaced
+ * according to the type of the argument.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+static void
+format_rt_arg (
+  GString *           buf,
+  const char *        spec,
+  const char *        spec_end,
+  const LogRtArg *    arg,
+  const LogRtRecord * rec)
+{
+  /* flags, width and precision */
+  char fmt[32];
+  int  len = 0;
+  for (const char * c = spec;
+       c < spec_end - 1 && len < 24
+       && !strchr ("hlLqjzt", *c);
+       c++)
+    {
+      fmt[len++] = *c;
+    }
+  char conv = *(spec_end - 1);
+
+  if (strchr ("diouxXc", conv))
+    {
+      long long val;
+      if (arg->type == LOG_RT_ARG_INT)
+        val = (long long) arg->val.i;
+      else if (arg->type == LOG_RT_ARG_UINT)
+        val = (long long) arg->val.u;
+      else
+        goto mismatch;
+
+      if (conv == 'c')
+        {
+          fmt[len++] = 'c';
+          fmt[len] = '\0';
+          g_string_append_printf (buf, fmt, (int) val);
+        }
+      else
+        {
+          fmt[len++] = 'l';
+          fmt[len++] = 'l';
+          fmt[len++] = conv;
+          fmt[len] = '\0';
+          g_string_append_printf (buf, fmt, val);
+        }
+    }
+  else if (strchr ("fFeEgGaA", conv))
+    {
+      double val;
+      if (arg->type == LOG_RT_ARG_DOUBLE)
+        val = arg->val.d;
+      else if (arg->type == LOG_RT_ARG_INT)
+        val = (double) arg->val.i;
+      else if (arg->type == LOG_RT_ARG_UINT)
+        val = (double) arg->val.u;
+      else
+        goto mismatch;
+
+      fmt[len++] = conv;
+      fmt[len] = '\0';
+      g_string_append_printf (buf, fmt, val);
+    }
+  else if (conv == 's' && arg->type == LOG_RT_ARG_STR)
+    {
+      fmt[len++] = 's';
+      fmt[len] = '\0';
+      g_string_append_printf (
+        buf, fmt, &rec->strs[arg->val.str_offset]);
+    }
+  else if (
+    conv == 'p'
+    && (arg->type == LOG_RT_ARG_PTR
+        || arg->type == LOG_RT_ARG_STR))
+    {
+      g_string_append_printf (
+        buf, "%p",
+        arg->type == LOG_RT_ARG_PTR
+          ? arg->val.p
+          : (const void *) &rec->strs[arg->val.str_offset]);
+    }
+  else
+    {
+      goto mismatch;
+    }
+
+  return;
+
+mismatch:
+  g_string_append (buf, "(?)");
+}
+#pragma GCC diagnostic pop
+
+void
+log_rt_record_format (
+  const LogRtRecord * rec,
+  GString *           buf)
+{
+  int          arg_idx = 0;
+  const char * c = rec->fmt;
+  while (*c)
+    {
+      if (*c != '%')
+        {
+          g_string_append_c (buf, *c++);
+          continue;
+        }
+
+      if (c[1] == '%')
+        {
+          g_string_append_c (buf, '%');
+          c += 2;
+          continue;
+        }
+
+      /* find the conversion char */
+      const char * spec = c++;
+      while (*c && !strchr ("diouxXcfFeEgGaAsp", *c))
+        {
+          c++;
+        }
+      if (!*c)
+        {
+          g_string_append (buf, spec);
+          break;
+        }
+      c++;
+
+      if (arg_idx < rec->num_args)
+        {
+          format_rt_arg (
+            buf, spec, c, &rec->args[arg_idx++], rec);
+        }
+      else
+        {
+          g_string_append (buf, "(?)");
+        }
+    }
+}
+
+/**
+ * Formats and logs the pending log_rt() messages.
+ */
+static void
+process_rt_rings (Log * self)
+{
+  GString * buf = g_string_new (NULL);
+  for (int i = 0; i < LOG_RT_MAX_THREADS; i++)
+    {
+      LogRtRing * ring = &rt_rings[i];
+      guint       read_idx = ring->read_idx;
+      guint       write_idx =
+        (guint) g_atomic_int_get (&ring->write_idx);
+      while (read_idx != write_idx)
+        {
+          LogRtRecord * rec =
+            &ring->records[read_idx & (LOG_RT_RING_SIZE - 1)];
+          g_string_truncate (buf, 0);
+          log_rt_record_format (rec, buf);
+          g_log (
+            G_LOG_DOMAIN, rec->log_level, "%s", buf->str);
+          read_idx++;
+          g_atomic_int_set (&ring->read_idx, read_idx);
+        }
+
+      guint num_dropped =
+        (guint) g_atomic_int_get (&ring->num_dropped);
+      if (num_dropped != ring->num_dropped_reported)
+        {
+          g_message (
+            "%u real-time log messages dropped",
+            num_dropped - ring->num_dropped_reported);
+          ring->num_dropped_reported = num_dropped;
+        }
+    }
+  g_string_free (buf, true);
+
+  guint num_dropped =
+    (guint) g_atomic_int_get (&self->rt_num_dropped);
+  if (num_dropped != self->rt_num_dropped_reported)
+    {
+      g_message (
+        "%u log messages dropped",
+        num_dropped - self->rt_num_dropped_reported);
+      self->rt_num_dropped_reported = num_dropped;
+    }
+}
+
+static void *
+rt_thread_func (Log * self)
+{
+  while (!g_atomic_int_get (&self->rt_thread_stop))
+    {
+      process_rt_rings (self);
+      g_usleep (20000);
+    }
+
+  return NULL;
+}
+
 /**
  * Initializes logging to a file.
  *
@@ -1337,6 +1711,9 @@ log_new (void)
   g_log_set_writer_func (
     (GLogWriterFunc) log_writer, self, NULL);
 
+  self->rt_thread = g_thread_new (
+    "log_rt", (GThreadFunc) rt_thread_func, self);
+
   /* remove temporary log file if it exists */
   if (tmp_log_file)
     {
@@ -1361,6 +1738,11 @@ log_free (Log * self)
       g_source_remove (self->writer_source_id);
     }
 
+  /* format the remaining real-time messages */
+  g_atomic_int_set (&self->rt_thread_stop, 1);
+  g_thread_join (self->rt_thread);
+  process_rt_rings (self);
+
   /* clear the queue */
   log_idle_cb (self);
 
@@ -102,7 +102,9 @@ mpmc_queue_clear (MPMCQueue * self)
 }
 
 int
-mpmc_queue_push_back (MPMCQueue * self, void * const data)
+mpmc_queue_try_push_back (
+  MPMCQueue * self,
+  void * const data)
 {
   cell_t * cell;
   gint     pos = g_atomic_int_get (&self->enqueue_pos);
@@ -121,7 +123,7 @@ mpmc_queue_push_back (MPMCQueue * self, void * const data)
         }
       else if (G_UNLIKELY (dif < 0))
         {
-          g_return_val_if_reached (0);
+          return 0;
         }
       else
         {
@@ -134,6 +136,17 @@ mpmc_queue_push_back (MPMCQueue * self, void * const data)
   return 1;
 }
 
+int
+mpmc_queue_push_back (MPMCQueue * self, void * const data)
+{
+  if (G_UNLIKELY (!mpmc_queue_try_push_back (self, data)))
+    {
+      g_return_val_if_reached (0);
+    }
+
+  return 1;
+}
+
 int
 mpmc_queue_dequeue (MPMCQueue * self, void ** data)
 {
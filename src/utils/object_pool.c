@@ -37,18 +37,17 @@ object_pool_new (
 
   self->free_func = free_func;
   self->max_objects = max_objects;
-  self->obj_available =
-    object_new_n ((size_t) max_objects, void *);
+  self->obj_available = mpmc_queue_new ();
+  mpmc_queue_reserve (
+    self->obj_available, (size_t) max_objects);
 
   for (int i = 0; i < max_objects; i++)
     {
       void * obj = create_func ();
-      self->obj_available[i] = obj;
+      mpmc_queue_push_back (self->obj_available, obj);
       self->num_obj_available++;
     }
 
-  zix_sem_init (&self->access_sem, 1);
-
   return self;
 }
 
@@ -62,28 +61,23 @@ object_pool_new (
 int
 object_pool_get_num_available (ObjectPool * self)
 {
-  zix_sem_wait (&self->access_sem);
-  int num_available = self->num_obj_available;
-  zix_sem_post (&self->access_sem);
-
-  return num_available;
+  return g_atomic_int_get (&self->num_obj_available);
 }
 
 /**
- * Returns an available object.
+ * Returns an available object, or NULL if all
+ * objects are in use.
  */
 void *
 object_pool_get (ObjectPool * self)
 {
   void * ret = NULL;
-  zix_sem_wait (&self->access_sem);
-  if (self->num_obj_available > 0)
+  if (!mpmc_queue_dequeue (self->obj_available, &ret))
     {
-      ret = self->obj_available[--self->num_obj_available];
+      g_return_val_if_reached (NULL);
     }
-  zix_sem_post (&self->access_sem);
+  g_atomic_int_add (&self->num_obj_available, -1);
 
-  g_return_val_if_fail (ret, NULL);
   return ret;
 }
 
@@ -93,16 +87,12 @@ object_pool_get (ObjectPool * self)
 void
 object_pool_return (ObjectPool * self, void * obj)
 {
-  zix_sem_wait (&self->access_sem);
-  int fail = 0;
-  if (self->num_obj_available == self->max_objects)
-    fail = 1;
-  else
-    {
-      self->obj_available[self->num_obj_available++] = obj;
-    }
-  zix_sem_post (&self->access_sem);
-  g_return_if_fail (fail == 0);
+  g_return_if_fail (
+    g_atomic_int_get (&self->num_obj_available)
+    < self->max_objects);
+
+  g_atomic_int_inc (&self->num_obj_available);
+  mpmc_queue_push_back (self->obj_available, obj);
 }
 
 /**
@@ -111,30 +101,28 @@ object_pool_return (ObjectPool * self, void * obj)
 void
 object_pool_free (ObjectPool * self)
 {
-  zix_sem_wait (&self->access_sem);
-  if (self->num_obj_available != self->max_objects)
+  int num_available =
+    g_atomic_int_get (&self->num_obj_available);
+  if (num_available != self->max_objects)
     {
       g_critical (
         "%s: Cannot free: "
         "There are %d objects in use.",
-        __func__, self->max_objects - self->num_obj_available);
-      zix_sem_post (&self->access_sem);
+        __func__, self->max_objects - num_available);
       return;
     }
 
   /* free each object */
-  for (int i = 0; i < self->num_obj_available; i++)
+  void * obj;
+  while (mpmc_queue_dequeue (self->obj_available, &obj))
     {
-      void * obj = self->obj_available[i];
       self->free_func (obj);
     }
 
-  object_zero_and_free (self->obj_available);
+  object_free_w_func_and_null (
+    mpmc_queue_free, self->obj_available);
   self->num_obj_available = 0;
   self->max_objects = 0;
-  /*zix_sem_post (&self->access_sem);*/
-
-  zix_sem_destroy (&self->access_sem);
 
   free (self);
 }
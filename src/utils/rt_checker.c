@@ -0,0 +1,310 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+/* for RTLD_NEXT */
+#define _GNU_SOURCE
+
+#include "zrythm-config.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "utils/rt_checker.h"
+
+#include <glib.h>
+
+#ifdef __GLIBC__
+#  include <execinfo.h>
+#endif
+
+#if defined(HAVE_RT_CHECKER) && defined(__GLIBC__)
+#  define USE_HOOKS 1
+#  include <dlfcn.h>
+#  include <fcntl.h>
+#  include <pthread.h>
+#  include <semaphore.h>
+#  include <unistd.h>
+#endif
+
+/* these can't use GPrivate, since setting a GPrivate
+ * may allocate */
+static _Thread_local int  rt_depth = 0;
+static _Thread_local int  allow_depth = 0;
+static _Thread_local bool recording = false;
+
+static RtCheckerViolation
+  violations[RT_CHECKER_MAX_VIOLATIONS];
+static volatile gint num_violations = 0;
+
+static const char * violation_type_strings[] = {
+  "allocation",
+  "free",
+  "lock",
+  "file I/O",
+};
+
+void
+rt_checker_enter (void)
+{
+  rt_depth++;
+}
+
+void
+rt_checker_leave (void)
+{
+  g_return_if_fail (rt_depth > 0);
+  rt_depth--;
+}
+
+void
+rt_checker_allow_begin (void)
+{
+  allow_depth++;
+}
+
+void
+rt_checker_allow_end (void)
+{
+  g_return_if_fail (allow_depth > 0);
+  allow_depth--;
+}
+
+bool
+rt_checker_is_active (void)
+{
+  return rt_depth > 0 && allow_depth == 0 && !recording;
+}
+
+void
+rt_checker_record (
+  RtCheckerViolationType type,
+  const char *           func)
+{
+  /* backtrace() may allocate on its first call */
+  recording = true;
+
+  int idx = g_atomic_int_add (&num_violations, 1);
+  if (idx < RT_CHECKER_MAX_VIOLATIONS)
+    {
+      RtCheckerViolation * v = &violations[idx];
+      v->type = type;
+      v->func = func;
+#ifdef __GLIBC__
+      v->num_frames =
+        backtrace (v->frames, RT_CHECKER_MAX_FRAMES);
+#else
+      v->num_frames = 0;
+#endif
+    }
+
+  recording = false;
+}
+
+bool
+rt_checker_is_available (void)
+{
+#ifdef USE_HOOKS
+  return true;
+#else
+  return false;
+#endif
+}
+
+int
+rt_checker_get_num_violations (void)
+{
+  return g_atomic_int_get (&num_violations);
+}
+
+char *
+rt_checker_get_report (void)
+{
+  GString * str = g_string_new (NULL);
+
+  int num = rt_checker_get_num_violations ();
+  g_string_append_printf (
+    str, "%d real-time violation(s)\n", num);
+  num = MIN (num, RT_CHECKER_MAX_VIOLATIONS);
+  for (int i = 0; i < num; i++)
+    {
+      RtCheckerViolation * v = &violations[i];
+      g_string_append_printf (
+        str, "\n%s() (%s):\n", v->func,
+        violation_type_strings[v->type]);
+#ifdef __GLIBC__
+      char ** syms =
+        backtrace_symbols (v->frames, v->num_frames);
+      /* skip rt_checker_record() */
+      for (int j = 1; syms && j < v->num_frames; j++)
+        {
+          g_string_append_printf (str, "  %s\n", syms[j]);
+        }
+      free (syms);
+#endif
+    }
+
+  return g_string_free (str, false);
+}
+
+void
+rt_checker_clear (void)
+{
+  g_atomic_int_set (&num_violations, 0);
+}
+
+#ifdef USE_HOOKS
+
+#  define CHECK(type, func) \
+    if (G_UNLIKELY (rt_checker_is_active ())) \
+      { \
+        rt_checker_record (type, func); \
+      }
+
+#  define NEXT(name) \
+    static __typeof__ (name) * next_##name = NULL; \
+    if (G_UNLIKELY (!next_##name)) \
+      { \
+        next_##name = \
+          (__typeof__ (name) *) dlsym (RTLD_NEXT, #name); \
+      }
+
+/* dlsym() may allocate, so use the glibc
+ * internals for these */
+extern void *
+__libc_malloc (size_t size);
+extern void *
+__libc_calloc (size_t nmemb, size_t size);
+extern void *
+__libc_realloc (void * ptr, size_t size);
+extern void
+__libc_free (void * ptr);
+
+void *
+malloc (size_t size)
+{
+  CHECK (RT_CHECKER_VIOLATION_ALLOC, "malloc");
+  return __libc_malloc (size);
+}
+
+void *
+calloc (size_t nmemb, size_t size)
+{
+  CHECK (RT_CHECKER_VIOLATION_ALLOC, "calloc");
+  return __libc_calloc (nmemb, size);
+}
+
+void *
+realloc (void * ptr, size_t size)
+{
+  CHECK (RT_CHECKER_VIOLATION_ALLOC, "realloc");
+  return __libc_realloc (ptr, size);
+}
+
+void
+free (void * ptr)
+{
+  if (ptr)
+    {
+      CHECK (RT_CHECKER_VIOLATION_FREE, "free");
+    }
+  __libc_free (ptr);
+}
+
+int
+pthread_mutex_lock (pthread_mutex_t * mutex)
+{
+  CHECK (RT_CHECKER_VIOLATION_LOCK, "pthread_mutex_lock");
+  NEXT (pthread_mutex_lock);
+  return next_pthread_mutex_lock (mutex);
+}
+
+int
+pthread_cond_wait (
+  pthread_cond_t *  cond,
+  pthread_mutex_t * mutex)
+{
+  CHECK (RT_CHECKER_VIOLATION_LOCK, "pthread_cond_wait");
+  NEXT (pthread_cond_wait);
+  return next_pthread_cond_wait (cond, mutex);
+}
+
+int
+sem_wait (sem_t * sem)
+{
+  CHECK (RT_CHECKER_VIOLATION_LOCK, "sem_wait");
+  NEXT (sem_wait);
+  return next_sem_wait (sem);
+}
+
+int
+sem_timedwait (
+  sem_t * restrict sem,
+  const struct timespec * restrict abs_timeout)
+{
+  CHECK (RT_CHECKER_VIOLATION_LOCK, "sem_timedwait");
+  NEXT (sem_timedwait);
+  return next_sem_timedwait (sem, abs_timeout);
+}
+
+int
+open (const char * pathname, int flags, ...)
+{
+  CHECK (RT_CHECKER_VIOLATION_FILE_IO, "open");
+  NEXT (open);
+  mode_t mode = 0;
+  if (flags & (O_CREAT | O_TMPFILE))
+    {
+      va_list args;
+      va_start (args, flags);
+      mode = va_arg (args, mode_t);
+      va_end (args);
+    }
+  return next_open (pathname, flags, mode);
+}
+
+FILE *
+fopen (const char * pathname, const char * mode)
+{
+  CHECK (RT_CHECKER_VIOLATION_FILE_IO, "fopen");
+  NEXT (fopen);
+  return next_fopen (pathname, mode);
+}
+
+ssize_t
+read (int fd, void * buf, size_t count)
+{
+  CHECK (RT_CHECKER_VIOLATION_FILE_IO, "read");
+  NEXT (read);
+  return next_read (fd, buf, count);
+}
+
+ssize_t
+write (int fd, const void * buf, size_t count)
+{
+  CHECK (RT_CHECKER_VIOLATION_FILE_IO, "write");
+  NEXT (write);
+  return next_write (fd, buf, count);
+}
+
+size_t
+fwrite (
+  const void * restrict ptr,
+  size_t size,
+  size_t nmemb,
+  FILE * restrict stream)
+{
+  CHECK (RT_CHECKER_VIOLATION_FILE_IO, "fwrite");
+  NEXT (fwrite);
+  return next_fwrite (ptr, size, nmemb, stream);
+}
+
+int
+fflush (FILE * stream)
+{
+  CHECK (RT_CHECKER_VIOLATION_FILE_IO, "fflush");
+  NEXT (fflush);
+  return next_fflush (stream);
+}
+
+#endif /* USE_HOOKS */
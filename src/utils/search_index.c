@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <string.h>
+
+#include "utils/objects.h"
+#include "utils/search_index.h"
+
+#include <glib.h>
+
+#define TRIGRAM(str) \
+  GUINT_TO_POINTER ( \
+    ((guint) (guchar) (str)[0] << 16) \
+    | ((guint) (guchar) (str)[1] << 8) \
+    | (guint) (guchar) (str)[2])
+
+static void
+free_posting_list (gpointer data)
+{
+  g_array_free ((GArray *) data, true);
+}
+
+SearchIndex *
+search_index_new (void)
+{
+  SearchIndex * self = object_new (SearchIndex);
+
+  self->items = g_ptr_array_new ();
+  self->texts = g_ptr_array_new_with_free_func (g_free);
+  self->item_indices =
+    g_hash_table_new (g_direct_hash, g_direct_equal);
+  self->trigrams = g_hash_table_new_full (
+    g_direct_hash, g_direct_equal, NULL, free_posting_list);
+  self->matches = g_byte_array_new ();
+  self->match_indices =
+    g_array_new (false, false, sizeof (guint));
+
+  return self;
+}
+
+static bool
+text_matches (const char * text, char ** tokens)
+{
+  for (char ** token = tokens; *token; token++)
+    {
+      if (!strstr (text, *token))
+        return false;
+    }
+
+  return true;
+}
+
+void
+search_index_add (
+  SearchIndex * self,
+  void *        data,
+  const char *  text)
+{
+  guint  idx = self->items->len;
+  char * folded = g_utf8_casefold (text, -1);
+  g_ptr_array_add (self->items, data);
+  g_ptr_array_add (self->texts, folded);
+  g_hash_table_insert (
+    self->item_indices, data, GUINT_TO_POINTER (idx + 1));
+
+  size_t len = strlen (folded);
+  for (size_t i = 0; i + 3 <= len; i++)
+    {
+      gpointer trigram = TRIGRAM (&folded[i]);
+      GArray * list = (GArray *)
+        g_hash_table_lookup (self->trigrams, trigram);
+      if (!list)
+        {
+          list = g_array_new (false, false, sizeof (guint));
+          g_hash_table_insert (self->trigrams, trigram, list);
+        }
+
+      /* add each item once */
+      if (
+        list->len == 0
+        || g_array_index (list, guint, list->len - 1) != idx)
+        {
+          g_array_append_val (list, idx);
+        }
+    }
+
+  guint8 match =
+    self->tokens && text_matches (folded, self->tokens);
+  g_byte_array_append (self->matches, &match, 1);
+  if (match)
+    {
+      g_array_append_val (self->match_indices, idx);
+    }
+}
+
+/**
+ * Returns the shortest list of the items containing
+ * a trigram of the tokens, or NULL if no token has
+ * trigrams.
+ *
+ * @param[out] empty Set to true if a trigram is not
+ *   contained in any item.
+ */
+static GArray *
+get_shortest_posting_list (SearchIndex * self, bool * empty)
+{
+  GArray * shortest = NULL;
+  *empty = false;
+  for (char ** token = self->tokens; *token; token++)
+    {
+      size_t len = strlen (*token);
+      for (size_t i = 0; i + 3 <= len; i++)
+        {
+          GArray * list = (GArray *) g_hash_table_lookup (
+            self->trigrams, TRIGRAM (&(*token)[i]));
+          if (!list)
+            {
+              *empty = true;
+              return NULL;
+            }
+          if (!shortest || list->len < shortest->len)
+            {
+              shortest = list;
+            }
+        }
+    }
+
+  return shortest;
+}
+
+/**
+ * Recalculates the matches of the current query.
+ *
+ * @param narrowing Whether the query only got more
+ *   strict, so the previous matches can be used as
+ *   candidates.
+ */
+static void
+update_matches (SearchIndex * self, bool narrowing)
+{
+  GArray * prev_matches = self->match_indices;
+  self->match_indices =
+    g_array_new (false, false, sizeof (guint));
+  for (guint i = 0; i < prev_matches->len; i++)
+    {
+      self->matches->data[g_array_index (
+        prev_matches, guint, i)] = 0;
+    }
+
+  if (self->tokens)
+    {
+      bool     empty;
+      GArray * candidates =
+        get_shortest_posting_list (self, &empty);
+      if (
+        narrowing
+        && (!candidates
+            || prev_matches->len < candidates->len))
+        {
+          candidates = prev_matches;
+        }
+
+      guint num_candidates =
+        empty ? 0
+        : candidates ? candidates->len
+                     : self->items->len;
+      for (guint i = 0; i < num_candidates; i++)
+        {
+          guint idx =
+            candidates ? g_array_index (candidates, guint, i)
+                       : i;
+          const char * text = (const char *)
+            g_ptr_array_index (self->texts, idx);
+          if (text_matches (text, self->tokens))
+            {
+              self->matches->data[idx] = 1;
+              g_array_append_val (self->match_indices, idx);
+            }
+        }
+    }
+
+  g_array_free (prev_matches, true);
+}
+
+SearchIndexChange
+search_index_set_query (
+  SearchIndex * self,
+  const char *  text)
+{
+  /* normalize the query to its tokens separated by
+   * single spaces */
+  char *  query = NULL;
+  char ** tokens = NULL;
+  if (text)
+    {
+      char *    folded = g_utf8_casefold (text, -1);
+      char **   parts = g_strsplit_set (folded, " \t\n", -1);
+      GString * str = g_string_new (NULL);
+      for (char ** part = parts; *part; part++)
+        {
+          if (**part == '\0')
+            continue;
+
+          if (str->len > 0)
+            g_string_append_c (str, ' ');
+          g_string_append (str, *part);
+        }
+      g_strfreev (parts);
+      g_free (folded);
+
+      if (str->len > 0)
+        {
+          query = g_string_free (str, false);
+          tokens = g_strsplit (query, " ", -1);
+        }
+      else
+        {
+          g_string_free (str, true);
+        }
+    }
+
+  /* extending the query can only remove matches and
+   * shortening it can only add matches */
+  SearchIndexChange change;
+  if (!query && !self->query)
+    change = SEARCH_INDEX_CHANGE_NONE;
+  else if (!query)
+    change = SEARCH_INDEX_CHANGE_LESS_STRICT;
+  else if (!self->query)
+    change = SEARCH_INDEX_CHANGE_MORE_STRICT;
+  else if (g_str_equal (query, self->query))
+    change = SEARCH_INDEX_CHANGE_NONE;
+  else if (g_str_has_prefix (query, self->query))
+    change = SEARCH_INDEX_CHANGE_MORE_STRICT;
+  else if (g_str_has_prefix (self->query, query))
+    change = SEARCH_INDEX_CHANGE_LESS_STRICT;
+  else
+    change = SEARCH_INDEX_CHANGE_DIFFERENT;
+
+  if (change == SEARCH_INDEX_CHANGE_NONE)
+    {
+      g_free (query);
+      g_strfreev (tokens);
+      return change;
+    }
+
+  bool narrowing =
+    change == SEARCH_INDEX_CHANGE_MORE_STRICT && self->query;
+  g_free (self->query);
+  g_strfreev (self->tokens);
+  self->query = query;
+  self->tokens = tokens;
+  update_matches (self, narrowing);
+
+  return change;
+}
+
+bool
+search_index_matches (SearchIndex * self, const void * data)
+{
+  if (!self->query)
+    return true;
+
+  guint idx = GPOINTER_TO_UINT (
+    g_hash_table_lookup (self->item_indices, data));
+  if (idx == 0)
+    return false;
+
+  return self->matches->data[idx - 1];
+}
+
+void
+search_index_free (SearchIndex * self)
+{
+  g_ptr_array_unref (self->items);
+  g_ptr_array_unref (self->texts);
+  g_hash_table_destroy (self->item_indices);
+  g_hash_table_destroy (self->trigrams);
+  g_free_and_null (self->query);
+  g_strfreev (self->tokens);
+  g_byte_array_unref (self->matches);
+  g_array_free (self->match_indices, true);
+
+  object_zero_and_free (self);
+}
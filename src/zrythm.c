@@ -608,6 +608,9 @@ zrythm_get_dir (ZrythmDirType type)
           res =
             g_build_filename (user_dir, "backtraces", NULL);
           break;
+        case ZRYTHM_DIR_USER_PEAKS:
+          res = g_build_filename (user_dir, "peaks", NULL);
+          break;
         default:
           break;
         }
@@ -642,6 +645,7 @@ zrythm_init_user_dirs_and_files (Zrythm * self)
   MK_USER_DIR (THEMES_CSS);
   MK_USER_DIR (PROFILING);
   MK_USER_DIR (GDB);
+  MK_USER_DIR (PEAKS);
 
 #undef MK_USER_DIR
 }
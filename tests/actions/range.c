@@ -378,12 +378,14 @@ test_insert_silence (void)
   UndoableAction * ua =
     range_action_new_insert_silence (&start, &end, NULL);
 
-  /* verify that number of objects is as expected */
+  /* verify that only the objects intersecting with
+   * the range start are cloned (midi regions 3, 4, 5
+   * and the audio region) */
   RangeAction * ra = (RangeAction *) ua;
   g_assert_cmpint (
     arranger_selections_get_num_objects (
       (ArrangerSelections *) ra->sel_before),
-    ==, 7);
+    ==, 4);
 
   check_before_insert ();
 
@@ -523,7 +525,19 @@ test_remove_range (void)
 
   check_before_insert ();
 
-  range_action_perform_remove (&start, &end, NULL);
+  UndoableAction * ua =
+    range_action_new_remove (&start, &end, NULL);
+
+  /* verify that only the objects that get split or
+   * deleted are cloned (midi regions 3, 4, 5, 6 and
+   * the audio region) */
+  RangeAction * ra = (RangeAction *) ua;
+  g_assert_cmpint (
+    arranger_selections_get_num_objects (
+      (ArrangerSelections *) ra->sel_before),
+    ==, 5);
+
+  undo_manager_perform (UNDO_MANAGER, ua, NULL);
 
   check_after_remove ();
 
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "audio/audio_file_stream.h"
+#include "utils/objects.h"
+
+#include <glib.h>
+
+#include "tests/helpers/zrythm.h"
+
+static void
+stream_file (samplerate_t samplerate)
+{
+  char * filepath =
+    g_build_filename (TESTS_SRCDIR, "test.wav", NULL);
+  GError *          err = NULL;
+  AudioFileStream * stream =
+    audio_file_stream_new (filepath, samplerate, &err);
+  g_assert_no_error (err);
+  g_assert_nonnull (stream);
+  g_free (filepath);
+
+  /* the first chunk is available immediately */
+  float l[256] = { 0 };
+  float r[256] = { 0 };
+  g_assert_cmpuint (
+    audio_file_stream_mix (stream, l, r, 256, 1.f), ==,
+    MIN (256, stream->num_out_frames));
+
+  /* read until finished */
+  unsigned_frame_t total = 256;
+  gint64           start = g_get_monotonic_time ();
+  while (!audio_file_stream_is_finished (stream))
+    {
+      total += audio_file_stream_mix (stream, l, r, 256, 1.f);
+      g_assert_cmpint (
+        g_get_monotonic_time () - start, <, 30000000);
+    }
+
+  /* allow for resampler rounding only - no input
+   * may be dropped */
+  g_assert_cmpfloat_with_epsilon (
+    (double) total, (double) stream->num_out_frames,
+    64);
+
+  audio_file_stream_free (stream);
+}
+
+static void
+test_stream_file (void)
+{
+  test_helper_zrythm_init ();
+
+  stream_file (22050);
+  stream_file (44100);
+  stream_file (48000);
+  stream_file (96000);
+
+  test_helper_zrythm_cleanup ();
+}
+
+static void
+test_nonexistent_file (void)
+{
+  test_helper_zrythm_init ();
+
+  GError *          err = NULL;
+  AudioFileStream * stream =
+    audio_file_stream_new ("/nonexistent.wav", 44100, &err);
+  g_assert_null (stream);
+  g_assert_nonnull (err);
+  g_error_free (err);
+
+  test_helper_zrythm_cleanup ();
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/audio/audio_file_stream/"
+
+  g_test_add_func (
+    TEST_PREFIX "test stream file",
+    (GTestFunc) test_stream_file);
+  g_test_add_func (
+    TEST_PREFIX "test nonexistent file",
+    (GTestFunc) test_nonexistent_file);
+
+  return g_test_run ();
+}
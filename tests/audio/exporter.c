@@ -6,6 +6,7 @@
 #include "actions/tracklist_selections.h"
 #include "audio/encoder.h"
 #include "audio/exporter.h"
+#include "audio/midi_file.h"
 #include "audio/supported_file.h"
 #include "project.h"
 #include "utils/chromaprint.h"
@@ -152,9 +153,12 @@ bounce_region (bool with_bpm_automation)
     MIDILIB_TEST_MIDI_FILES_PATH, "M71.MID", NULL);
   int       lane_pos = 0;
   int       idx_in_lane = 0;
-  ZRegion * region = midi_region_new_from_midi_file (
-    &pos, midi_file, track_get_name_hash (track), lane_pos,
-    idx_in_lane, 0);
+  MidiFile * mf = midi_file_new (midi_file, NULL);
+  g_assert_nonnull (mf);
+  ZRegion * region = midi_region_new_from_midi_file_track (
+    &pos, mf, midi_file_get_nonempty_track (mf, 0),
+    track_get_name_hash (track), lane_pos, idx_in_lane);
+  midi_file_free (mf);
   track_add_region (
     track, region, NULL, lane_pos, F_GEN_NAME,
     F_NO_PUBLISH_EVENTS);
@@ -305,9 +309,12 @@ test_bounce_region_with_first_note (void)
     MIDILIB_TEST_MIDI_FILES_PATH, "M1.MID", NULL);
   int       lane_pos = 0;
   int       idx_in_lane = 0;
-  ZRegion * region = midi_region_new_from_midi_file (
-    &pos, midi_file, track_get_name_hash (track), lane_pos,
-    idx_in_lane, 0);
+  MidiFile * mf = midi_file_new (midi_file, NULL);
+  g_assert_nonnull (mf);
+  ZRegion * region = midi_region_new_from_midi_file_track (
+    &pos, mf, midi_file_get_nonempty_track (mf, 0),
+    track_get_name_hash (track), lane_pos, idx_in_lane);
+  midi_file_free (mf);
   ArrangerObject * r_obj = (ArrangerObject *) region;
   track_add_region (
     track, region, NULL, lane_pos, F_GEN_NAME,
@@ -496,9 +503,12 @@ _test_bounce_instrument_track (
   /* create a MIDI region on the instrument track */
   char * midi_file = g_build_filename (
     MIDILIB_TEST_MIDI_FILES_PATH, "M71.MID", NULL);
-  ZRegion * r = midi_region_new_from_midi_file (
-    PLAYHEAD, midi_file, track_get_name_hash (ins_track), 0,
-    0, 0);
+  MidiFile * mf = midi_file_new (midi_file, NULL);
+  g_assert_nonnull (mf);
+  ZRegion * r = midi_region_new_from_midi_file_track (
+    PLAYHEAD, mf, midi_file_get_nonempty_track (mf, 0),
+    track_get_name_hash (ins_track), 0, 0);
+  midi_file_free (mf);
   g_free (midi_file);
   track_add_region (
     ins_track, r, NULL, 0, F_GEN_NAME, F_NO_PUBLISH_EVENTS);
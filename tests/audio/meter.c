@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "audio/channel.h"
+#include "audio/engine.h"
+#include "audio/master_track.h"
+#include "audio/meter.h"
+#include "audio/port.h"
+#include "project.h"
+#include "zrythm.h"
+
+#include "tests/helpers/zrythm.h"
+
+static void
+test_process (void)
+{
+  test_helper_zrythm_init ();
+
+  /* stop dummy audio engine processing so we can
+   * process manually */
+  AUDIO_ENGINE->stop_dummy_audio_thread = true;
+  g_usleep (1000000);
+
+  Port *  port = P_MASTER_TRACK->channel->stereo_out->l;
+  Meter * meter = meter_new_for_port (port);
+  bool    subscribed = false;
+  for (int i = 0; i < PORT_MAX_METERS; i++)
+    {
+      if (port->meters[i] == meter)
+        subscribed = true;
+    }
+  g_assert_true (subscribed);
+
+  /* nothing published yet */
+  float val, max;
+  meter_get_value (meter, AUDIO_VALUE_AMPLITUDE, &val, &max);
+  g_assert_cmpfloat_with_epsilon (val, 1e-20f, 1e-30f);
+
+  /* processing the engine publishes a snapshot */
+  engine_process (AUDIO_ENGINE, AUDIO_ENGINE->block_length);
+  g_assert_cmpint (meter->snapshot_seq, ==, 2);
+
+  /* constant signal */
+  nframes_t nframes = AUDIO_ENGINE->block_length;
+  float *   buf = g_new (float, nframes);
+  for (nframes_t i = 0; i < nframes; i++)
+    {
+      buf[i] = 0.5f;
+    }
+  meter_process (meter, buf, nframes);
+  meter_get_value (meter, AUDIO_VALUE_AMPLITUDE, &val, &max);
+  g_assert_cmpfloat_with_epsilon (val, 0.5f, 0.0001f);
+  g_assert_cmpfloat_with_epsilon (max, 0.5f, 0.0001f);
+  g_free (buf);
+
+  meter_free (meter);
+  for (int i = 0; i < PORT_MAX_METERS; i++)
+    {
+      g_assert_null (port->meters[i]);
+    }
+
+  test_helper_zrythm_cleanup ();
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/audio/meter/"
+
+  g_test_add_func (
+    TEST_PREFIX "test process", (GTestFunc) test_process);
+
+  return g_test_run ();
+}
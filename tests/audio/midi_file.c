@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "audio/midi_file.h"
+#include "audio/midi_region.h"
+#include "audio/position.h"
+#include "audio/region.h"
+#include "utils/flags.h"
+#include "utils/io.h"
+#include "utils/objects.h"
+
+#include <glib.h>
+
+#include "tests/helpers/zrythm.h"
+
+static void
+test_read (void)
+{
+  test_helper_zrythm_init ();
+
+  char ** midi_files = io_get_files_in_dir_ending_in (
+    TESTS_SRCDIR, F_NO_RECURSIVE, ".mid", false);
+  g_assert_nonnull (midi_files);
+  char * midi_file;
+  int    iter = 0;
+  while ((midi_file = midi_files[iter++]))
+    {
+      GError *   err = NULL;
+      MidiFile * mf = midi_file_new (midi_file, &err);
+      g_assert_no_error (err);
+      g_assert_nonnull (mf);
+
+      /* same tracks as when checking each track */
+      int num_tracks = midi_file_get_num_nonempty_tracks (mf);
+      g_assert_cmpint (
+        num_tracks, ==,
+        midi_file_get_num_tracks (midi_file, true));
+      g_assert_cmpint (
+        mf->num_tracks, ==,
+        midi_file_get_num_tracks (midi_file, false));
+
+      for (int i = 0; i < num_tracks; i++)
+        {
+          const MidiFileTrack * track =
+            midi_file_get_nonempty_track (mf, i);
+          g_assert_nonnull (track);
+          g_assert_true (track->has_data);
+          g_assert_true (midi_file_track_has_data (
+            midi_file, track->idx));
+          for (int j = 0; j < track->num_notes; j++)
+            {
+              const MidiFileNote * note = &track->notes[j];
+              g_assert_true (
+                note->end == -1 || note->end >= note->start);
+            }
+
+          /* regions are created with all the notes */
+          Position pos;
+          position_set_to_bar (&pos, 2);
+          ZRegion * r = midi_region_new_from_midi_file_track (
+            &pos, mf, track, 0, 0, 0);
+          if (r)
+            {
+              g_assert_cmpint (
+                r->num_midi_notes, ==, track->num_notes);
+              for (int j = 0; j < r->num_midi_notes; j++)
+                {
+                  g_assert_cmpint (
+                    r->midi_notes[j]->pos, ==, j);
+                  g_assert_cmpint (
+                    r->midi_notes[j]->val, ==,
+                    track->notes[j].pitch);
+                }
+              arranger_object_free ((ArrangerObject *) r);
+            }
+        }
+      g_assert_null (
+        midi_file_get_nonempty_track (mf, num_tracks));
+
+      midi_file_free (mf);
+    }
+  g_strfreev (midi_files);
+
+  test_helper_zrythm_cleanup ();
+}
+
+static void
+test_num_tracks (void)
+{
+  const char * files[] = {
+    "empty_midi_file_type1.mid",
+    "1_track_with_data.mid",
+    "1_empty_track_1_track_with_data.mid",
+    "format_1_two_tracks_with_data.mid",
+  };
+  const int num_tracks[] = { 0, 1, 1, 2 };
+  for (size_t i = 0; i < G_N_ELEMENTS (files); i++)
+    {
+      char * path =
+        g_build_filename (TESTS_SRCDIR, files[i], NULL);
+      MidiFile * mf = midi_file_new (path, NULL);
+      g_assert_nonnull (mf);
+      g_assert_cmpint (
+        midi_file_get_num_nonempty_tracks (mf), ==,
+        num_tracks[i]);
+      midi_file_free (mf);
+      g_free (path);
+    }
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/audio/midi_file/"
+
+  g_test_add_func (
+    TEST_PREFIX "test read", (GTestFunc) test_read);
+  g_test_add_func (
+    TEST_PREFIX "test num tracks",
+    (GTestFunc) test_num_tracks);
+
+  return g_test_run ();
+}
@@ -3,6 +3,7 @@
 
 #include "zrythm-test-config.h"
 
+#include "audio/control_port.h"
 #include "audio/master_track.h"
 #include "audio/midi_mapping.h"
 #include "project.h"
@@ -45,6 +46,87 @@ test_midi_mappping (void)
     == MIDI_MAPPINGS->mappings[0]->dest);
 }
 
+static void
+test_apply (void)
+{
+  MidiMappings * mappings = midi_mappings_new ();
+  Fader *        fader = P_MASTER_TRACK->channel->fader;
+
+  midi_byte_t balance_buf[3] = { 0xB1, 0x08, 0 };
+  midi_byte_t mute_buf[3] = { 0x91, 0x3C, 0 };
+  midi_mappings_bind_track (
+    mappings, balance_buf, fader->balance,
+    F_NO_PUBLISH_EVENTS);
+  midi_mappings_bind_track (
+    mappings, mute_buf, fader->mute, F_NO_PUBLISH_EVENTS);
+
+  /* other channel/controller does nothing */
+  float       balance = control_port_get_val (fader->balance);
+  midi_byte_t buf[3] = { 0xB2, 0x08, 127 };
+  midi_mappings_apply (mappings, buf);
+  buf[0] = 0xB1;
+  buf[1] = 0x09;
+  midi_mappings_apply (mappings, buf);
+  g_assert_cmpfloat_with_epsilon (
+    control_port_get_val (fader->balance), balance,
+    0.0001f);
+
+  /* 7-bit CC */
+  buf[1] = 0x08;
+  buf[2] = 127;
+  midi_mappings_apply (mappings, buf);
+  g_assert_cmpfloat_with_epsilon (
+    control_port_get_normalized_val (fader->balance),
+    1.f, 0.0001f);
+
+  /* 14-bit CC: MSB then LSB */
+  buf[2] = 64;
+  midi_mappings_apply (mappings, buf);
+  buf[1] = 0x08 + 32;
+  buf[2] = 32;
+  midi_mappings_apply (mappings, buf);
+  g_assert_cmpfloat_with_epsilon (
+    control_port_get_normalized_val (fader->balance),
+    (float) ((64 << 7) | 32) / 16383.f, 0.0001f);
+
+  /* toggle */
+  bool muted = control_port_is_toggled (fader->mute);
+  midi_mappings_apply (mappings, mute_buf);
+  g_assert_true (
+    control_port_is_toggled (fader->mute) != muted);
+
+  /* disabled mappings and unbound mappings are
+   * skipped */
+  midi_mapping_set_enabled (mappings->mappings[1], false);
+  midi_mappings_apply (mappings, mute_buf);
+  g_assert_true (
+    control_port_is_toggled (fader->mute) != muted);
+  midi_mapping_set_enabled (mappings->mappings[1], true);
+  midi_mappings_unbind (mappings, 0, F_NO_PUBLISH_EVENTS);
+  balance = control_port_get_val (fader->balance);
+  buf[1] = 0x08;
+  buf[2] = 0;
+  midi_mappings_apply (mappings, buf);
+  g_assert_cmpfloat_with_epsilon (
+    control_port_get_val (fader->balance), balance,
+    0.0001f);
+  midi_mappings_apply (mappings, mute_buf);
+  g_assert_true (
+    control_port_is_toggled (fader->mute) == muted);
+
+  /* inserting before existing mappings */
+  midi_mappings_bind_at (
+    mappings, balance_buf, NULL, fader->balance, 0,
+    F_NO_PUBLISH_EVENTS);
+  buf[2] = 127;
+  midi_mappings_apply (mappings, buf);
+  g_assert_cmpfloat_with_epsilon (
+    control_port_get_normalized_val (fader->balance),
+    1.f, 0.0001f);
+
+  midi_mappings_free (mappings);
+}
+
 int
 main (int argc, char * argv[])
 {
@@ -57,6 +139,8 @@ main (int argc, char * argv[])
   g_test_add_func (
     TEST_PREFIX "test midi mapping",
     (GTestFunc) test_midi_mappping);
+  g_test_add_func (
+    TEST_PREFIX "test apply", (GTestFunc) test_apply);
 
   return g_test_run ();
 }
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "audio/peak_cache.h"
+#include "utils/io.h"
+#include "utils/objects.h"
+
+#include <glib.h>
+
+#include "tests/helpers/zrythm.h"
+
+#define NUM_FRAMES 100000
+#define CHANNELS 2
+
+static void
+get_min_max_from_frames (
+  const float *    frames,
+  unsigned_frame_t start,
+  unsigned_frame_t end,
+  float *          min,
+  float *          max)
+{
+  for (unsigned_frame_t i = start * CHANNELS;
+       i < MIN (end, NUM_FRAMES) * CHANNELS; i++)
+    {
+      *min = MIN (*min, frames[i]);
+      *max = MAX (*max, frames[i]);
+    }
+}
+
+static void
+test_min_max (void)
+{
+  float * frames =
+    object_new_n (NUM_FRAMES * CHANNELS, float);
+  for (size_t i = 0; i < NUM_FRAMES * CHANNELS; i++)
+    {
+      frames[i] = (float) g_random_double_range (-1.0, 1.0)
+                  * (float) (i % 7919) / 7919.f;
+    }
+
+  PeakCache * peaks =
+    peak_cache_new (frames, NUM_FRAMES, CHANNELS);
+  g_assert_cmpint (peaks->num_levels, >, 1);
+  g_assert_cmpuint (
+    peaks->levels[peaks->num_levels - 1].num_peaks, ==, 1);
+
+  /* the coarsest level covers everything */
+  float min = 0.f, max = 0.f;
+  float expected_min = 0.f, expected_max = 0.f;
+  g_assert_true (peak_cache_get_min_max (
+    peaks, 0, NUM_FRAMES, &min, &max));
+  get_min_max_from_frames (
+    frames, 0, NUM_FRAMES, &expected_min, &expected_max);
+  g_assert_cmpfloat (min, ==, expected_min);
+  g_assert_cmpfloat (max, ==, expected_max);
+
+  /* the result of a range covers the range and at
+   * most one peak on each side */
+  for (unsigned_frame_t span = PEAK_CACHE_BASE_FRAMES;
+       span < NUM_FRAMES; span *= 3)
+    {
+      for (unsigned_frame_t start = 0;
+           start + span < NUM_FRAMES; start += span + 17)
+        {
+          min = max = 0.f;
+          g_assert_true (peak_cache_get_min_max (
+            peaks, start, start + span, &min, &max));
+
+          float inner_min = 0.f, inner_max = 0.f;
+          get_min_max_from_frames (
+            frames, start, start + span, &inner_min,
+            &inner_max);
+          float outer_min = 0.f, outer_max = 0.f;
+          get_min_max_from_frames (
+            frames, start >= span ? start - span : 0,
+            start + span * 2, &outer_min, &outer_max);
+          g_assert_cmpfloat (min, <=, inner_min);
+          g_assert_cmpfloat (max, >=, inner_max);
+          g_assert_cmpfloat (min, >=, outer_min);
+          g_assert_cmpfloat (max, <=, outer_max);
+        }
+    }
+
+  /* ranges narrower than a peak must be scanned */
+  g_assert_false (peak_cache_get_min_max (
+    peaks, 0, PEAK_CACHE_BASE_FRAMES - 1, &min, &max));
+
+  peak_cache_free (peaks);
+  free (frames);
+}
+
+static void
+test_save_and_load (void)
+{
+  float * frames =
+    object_new_n (NUM_FRAMES * CHANNELS, float);
+  for (size_t i = 0; i < NUM_FRAMES * CHANNELS; i++)
+    {
+      frames[i] =
+        (float) g_random_double_range (-1.0, 1.0);
+    }
+  PeakCache * peaks =
+    peak_cache_new (frames, NUM_FRAMES, CHANNELS);
+
+  GError * err = NULL;
+  char *   tmp_dir =
+    g_dir_make_tmp ("zrythm_peak_cache_XXXXXX", &err);
+  g_assert_nonnull (tmp_dir);
+  char * path =
+    g_build_filename (tmp_dir, "test.peaks", NULL);
+  g_assert_true (
+    peak_cache_write_to_file (peaks, path, &err));
+  g_assert_no_error (err);
+
+  PeakCache * loaded =
+    peak_cache_new_from_file (path, NUM_FRAMES, &err);
+  g_assert_no_error (err);
+  g_assert_nonnull (loaded);
+  g_assert_nonnull (loaded->mapped_file);
+  g_assert_cmpint (loaded->num_levels, ==, peaks->num_levels);
+  g_assert_cmpmem (
+    loaded->data, loaded->data_size * sizeof (float),
+    peaks->data, peaks->data_size * sizeof (float));
+
+  float min = 0.f, max = 0.f;
+  float expected_min = 0.f, expected_max = 0.f;
+  g_assert_true (peak_cache_get_min_max (
+    loaded, 1000, 5000, &min, &max));
+  peak_cache_get_min_max (
+    peaks, 1000, 5000, &expected_min, &expected_max);
+  g_assert_cmpfloat (min, ==, expected_min);
+  g_assert_cmpfloat (max, ==, expected_max);
+  peak_cache_free (loaded);
+
+  /* files of other audio are rejected */
+  loaded =
+    peak_cache_new_from_file (path, NUM_FRAMES / 2, &err);
+  g_assert_null (loaded);
+  g_assert_nonnull (err);
+  g_clear_error (&err);
+
+  io_remove (path);
+  io_rmdir (tmp_dir, false);
+  g_free (path);
+  g_free (tmp_dir);
+  peak_cache_free (peaks);
+  free (frames);
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/audio/peak_cache/"
+
+  g_test_add_func (
+    TEST_PREFIX "test min max", (GTestFunc) test_min_max);
+  g_test_add_func (
+    TEST_PREFIX "test save and load",
+    (GTestFunc) test_save_and_load);
+
+  return g_test_run ();
+}
@@ -3,8 +3,10 @@
 
 #include "zrythm-test-config.h"
 
+#include "audio/channel.h"
 #include "audio/track.h"
 #include "project.h"
+#include "plugins/plugin.h"
 #include "utils/flags.h"
 #include "zrythm.h"
 
@@ -28,8 +30,21 @@ test_queue_file (void)
   for (int i = 0; i < 5; i++)
     {
       sample_processor_queue_file (SAMPLE_PROCESSOR, file);
+      g_assert_cmpint (
+        sample_processor_get_requested_set (SAMPLE_PROCESSOR),
+        ==, i % 2);
     }
 
+  /* master and an audio and MIDI track for each
+   * audition set (no instrument when testing) */
+  g_assert_cmpint (
+    SAMPLE_PROCESSOR->tracklist->num_tracks, ==, 5);
+
+  sample_processor_stop_file_playback (SAMPLE_PROCESSOR);
+  g_assert_cmpint (
+    sample_processor_get_requested_set (SAMPLE_PROCESSOR),
+    ==, -1);
+
   supported_file_free (file);
 
   test_helper_zrythm_cleanup ();
@@ -60,8 +75,27 @@ test_queue_midi_and_roll_transport (void)
   g_message ("=============== queueing file =============");
 
   sample_processor_queue_file (SAMPLE_PROCESSOR, file);
+
+  /* master, instrument and an audio and MIDI track
+   * for each audition set */
+  g_assert_cmpint (
+    SAMPLE_PROCESSOR->tracklist->num_tracks, ==, 6);
+  g_assert_nonnull (SAMPLE_PROCESSOR->instrument_track);
+  Plugin * instrument =
+    SAMPLE_PROCESSOR->instrument_track->channel->instrument;
+  g_assert_nonnull (instrument);
+
+  /* queue again and check that the chain and the
+   * instrument are reused */
+  sample_processor_queue_file (SAMPLE_PROCESSOR, file);
+  g_assert_cmpint (
+    SAMPLE_PROCESSOR->tracklist->num_tracks, ==, 6);
+  g_assert_true (
+    SAMPLE_PROCESSOR->instrument_track->channel->instrument
+    == instrument);
   g_assert_cmpint (
-    SAMPLE_PROCESSOR->tracklist->num_tracks, ==, 3);
+    sample_processor_get_requested_set (SAMPLE_PROCESSOR),
+    ==, 1);
 
   g_message ("============= starting process ===========");
 
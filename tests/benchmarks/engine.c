@@ -0,0 +1,313 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __APPLE__
+#  include <mach/mach.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include "actions/channel_send_action.h"
+#include "audio/automation_point.h"
+#include "audio/automation_region.h"
+#include "audio/channel.h"
+#include "audio/channel_send.h"
+#include "audio/engine.h"
+#include "audio/track.h"
+#include "audio/tracklist.h"
+#include "audio/transport.h"
+#include "project.h"
+#include "utils/flags.h"
+#include "zrythm.h"
+
+#include <glib.h>
+
+#include "tests/helpers/plugin_manager.h"
+#include "tests/helpers/project.h"
+#include "tests/helpers/zrythm.h"
+
+#define NUM_CYCLES 2000
+#define NUM_NOTES 32
+
+/**
+ * Parameters of a generated project.
+ */
+typedef struct EngineBenchmarkProject
+{
+  const char * name;
+  int          num_audio_tracks;
+  int          num_midi_tracks;
+  int          num_buses;
+} EngineBenchmarkProject;
+
+static const EngineBenchmarkProject projects[] = {
+  {"small",  4,  4,  2},
+  { "large", 32, 16, 4},
+};
+
+/** Values of ZRYTHM_DSP_THREADS (worker threads
+ * besides the kickoff thread, which always runs the
+ * graph, so 0 still means one graph thread). */
+static const int thread_counts[] = { 0, 1, 3 };
+
+typedef struct EngineBenchmark
+{
+  const EngineBenchmarkProject * prj;
+  int                            num_threads;
+
+  /* microseconds per cycle */
+  gint64 p50;
+  gint64 p95;
+  gint64 p99;
+  gint64 max;
+
+  /* resident set size in KiB after processing,
+   * and its increase since before the project was
+   * created */
+  long rss;
+  long rss_increase;
+} EngineBenchmark;
+
+static EngineBenchmark benchmarks[
+  G_N_ELEMENTS (projects) * G_N_ELEMENTS (thread_counts)];
+static int num_benchmarks = 0;
+
+static void
+add_automation (
+  Track *    track,
+  Position * start,
+  Position * end)
+{
+  AutomationTrack * at = channel_get_automation_track (
+    track->channel, PORT_FLAG_AMPLITUDE);
+  ZRegion * r = automation_region_new (
+    start, end, track_get_name_hash (track), at->index, 0);
+  track_add_region (
+    track, r, at, 0, F_GEN_NAME, F_NO_PUBLISH_EVENTS);
+  AutomationPoint * ap =
+    automation_point_new_float (0.2f, 0.2f, start);
+  automation_region_add_ap (r, ap, F_NO_PUBLISH_EVENTS);
+  ap = automation_point_new_float (0.8f, 0.8f, end);
+  automation_region_add_ap (r, ap, F_NO_PUBLISH_EVENTS);
+}
+
+/**
+ * Returns the current resident set size in KiB, or
+ * -1 if unknown.
+ *
+ * The peak from getrusage() is not used because it
+ * covers the whole process, which runs all the
+ * configurations.
+ */
+static long
+get_current_rss (void)
+{
+#ifdef __APPLE__
+  struct mach_task_basic_info info;
+  mach_msg_type_number_t      count =
+    MACH_TASK_BASIC_INFO_COUNT;
+  if (
+    task_info (
+      mach_task_self (), MACH_TASK_BASIC_INFO,
+      (task_info_t) &info, &count)
+    != KERN_SUCCESS)
+    return -1;
+
+  return (long) (info.resident_size / 1024);
+#else
+  FILE * f = fopen ("/proc/self/statm", "r");
+  if (!f)
+    return -1;
+
+  long size, resident;
+  int  num_read = fscanf (f, "%ld %ld", &size, &resident);
+  fclose (f);
+  if (num_read != 2)
+    return -1;
+
+  return resident * (sysconf (_SC_PAGESIZE) / 1024);
+#endif
+}
+
+/**
+ * Creates audio tracks with clips, instrument tracks
+ * with notes and buses that each track sends to.
+ *
+ * Every track gets a fader automation lane.
+ */
+static void
+generate_project (const EngineBenchmarkProject * prj)
+{
+  Position start, end;
+  position_set_to_bar (&start, 1);
+  position_set_to_bar (&end, 9);
+
+  int first_bus = TRACKLIST->num_tracks;
+  for (int i = 0; i < prj->num_buses; i++)
+    {
+      track_create_empty_with_action (
+        TRACK_TYPE_AUDIO_BUS, NULL);
+    }
+
+  for (int i = 0; i < prj->num_audio_tracks; i++)
+    {
+      Track * track = track_create_empty_with_action (
+        TRACK_TYPE_AUDIO, NULL);
+      g_assert_nonnull (track);
+      test_project_add_audio_region (track);
+    }
+
+  if (prj->num_midi_tracks > 0)
+    {
+      test_plugin_manager_create_tracks_from_plugin (
+        TEST_INSTRUMENT_BUNDLE_URI, TEST_INSTRUMENT_URI,
+        true, false, prj->num_midi_tracks);
+    }
+  for (int i = 0; i < prj->num_midi_tracks; i++)
+    {
+      Track * track =
+        TRACKLIST->tracks
+          [TRACKLIST->num_tracks - prj->num_midi_tracks
+           + i];
+      test_project_add_midi_region_with_notes (
+        track, NUM_NOTES, i);
+    }
+
+  /* automation and sends */
+  for (int i = first_bus; i < TRACKLIST->num_tracks; i++)
+    {
+      Track * track = TRACKLIST->tracks[i];
+      add_automation (track, &start, &end);
+
+      if (track->type == TRACK_TYPE_AUDIO_BUS)
+        continue;
+
+      Track * bus = TRACKLIST->tracks
+        [first_bus + (i % prj->num_buses)];
+      bool ret = channel_send_action_perform_connect_audio (
+        track->channel->sends[0],
+        bus->processor->stereo_in, NULL);
+      g_assert_true (ret);
+    }
+}
+
+static int
+cmp_gint64 (const void * a, const void * b)
+{
+  gint64 va = *(const gint64 *) a;
+  gint64 vb = *(const gint64 *) b;
+  return (va > vb) - (va < vb);
+}
+
+static void
+run_benchmark (
+  const EngineBenchmarkProject * prj,
+  int                            num_threads)
+{
+  char * num_threads_str =
+    g_strdup_printf ("%d", num_threads);
+  g_setenv ("ZRYTHM_DSP_THREADS", num_threads_str, true);
+  g_free (num_threads_str);
+
+  long rss_before = get_current_rss ();
+
+  test_helper_zrythm_init ();
+
+  generate_project (prj);
+
+  /* drive the engine manually */
+  test_project_stop_dummy_engine ();
+  transport_request_roll (TRANSPORT, true);
+
+  /* warm up */
+  for (int i = 0; i < 16; i++)
+    {
+      engine_process (
+        AUDIO_ENGINE, AUDIO_ENGINE->block_length);
+    }
+
+  gint64 * times = g_new (gint64, NUM_CYCLES);
+  for (int i = 0; i < NUM_CYCLES; i++)
+    {
+      gint64 start = g_get_monotonic_time ();
+      engine_process (
+        AUDIO_ENGINE, AUDIO_ENGINE->block_length);
+      times[i] = g_get_monotonic_time () - start;
+    }
+  qsort (times, NUM_CYCLES, sizeof (gint64), cmp_gint64);
+
+  long rss = get_current_rss ();
+
+  EngineBenchmark * benchmark =
+    &benchmarks[num_benchmarks++];
+  benchmark->prj = prj;
+  benchmark->num_threads = num_threads;
+  benchmark->p50 = times[NUM_CYCLES / 2];
+  benchmark->p95 = times[NUM_CYCLES * 95 / 100];
+  benchmark->p99 = times[NUM_CYCLES * 99 / 100];
+  benchmark->max = times[NUM_CYCLES - 1];
+  benchmark->rss = rss;
+  benchmark->rss_increase =
+    rss >= 0 && rss_before >= 0 ? rss - rss_before : -1;
+  g_free (times);
+
+  test_helper_zrythm_cleanup ();
+}
+
+static void
+test_process (void)
+{
+  for (size_t i = 0; i < G_N_ELEMENTS (projects); i++)
+    {
+      for (size_t j = 0; j < G_N_ELEMENTS (thread_counts);
+           j++)
+        {
+          run_benchmark (&projects[i], thread_counts[j]);
+        }
+    }
+}
+
+static void
+print_benchmark_results (void)
+{
+  for (int i = 0; i < num_benchmarks; i++)
+    {
+      EngineBenchmark * benchmark = &benchmarks[i];
+      const EngineBenchmarkProject * prj = benchmark->prj;
+      fprintf (
+        stderr,
+        "---- %s (%d audio, %d MIDI, %d buses), "
+        "%d graph threads (kickoff + %d extra) ----\n"
+        "cycle usec: p50 %" G_GINT64_FORMAT
+        " p95 %" G_GINT64_FORMAT " p99 %" G_GINT64_FORMAT
+        " max %" G_GINT64_FORMAT "\n"
+        "RSS: %ld KiB (+%ld KiB for the project)\n",
+        prj->name, prj->num_audio_tracks,
+        prj->num_midi_tracks, prj->num_buses,
+        benchmark->num_threads + 1, benchmark->num_threads,
+        benchmark->p50,
+        benchmark->p95, benchmark->p99, benchmark->max,
+        benchmark->rss, benchmark->rss_increase);
+    }
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/benchmarks/engine/"
+
+  g_test_add_func (
+    TEST_PREFIX "test process", (GTestFunc) test_process);
+  g_test_add_func (
+    TEST_PREFIX "print benchmark results",
+    (GTestFunc) print_benchmark_results);
+
+  return g_test_run ();
+}
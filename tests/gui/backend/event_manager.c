@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "gui/backend/event.h"
+#include "gui/backend/event_manager.h"
+
+#include <glib.h>
+
+#include "tests/helpers/zrythm.h"
+
+static void
+test_mark_pending (void)
+{
+  EventManager * self = event_manager_new ();
+
+  int a, b;
+  g_assert_true (event_manager_mark_pending (
+    self, ET_PLUGIN_STATE_CHANGED, &a));
+  g_assert_false (event_manager_mark_pending (
+    self, ET_PLUGIN_STATE_CHANGED, &a));
+  g_assert_true (event_manager_mark_pending (
+    self, ET_PLUGIN_STATE_CHANGED, &b));
+  g_assert_true (event_manager_mark_pending (
+    self, ET_PLUGIN_LATENCY_CHANGED, &a));
+  g_assert_true (event_manager_mark_pending (
+    self, ET_PIANO_ROLL_KEY_ON_OFF, NULL));
+  g_assert_false (event_manager_mark_pending (
+    self, ET_PIANO_ROLL_KEY_ON_OFF, NULL));
+
+  /* a storm of distinct events never blocks and
+   * identical ones keep being coalesced */
+  for (int i = 0; i < EVENT_MANAGER_PENDING_SIZE * 2; i++)
+    {
+      event_manager_mark_pending (
+        self, ET_PLUGIN_STATE_CHANGED,
+        GINT_TO_POINTER (i + 1));
+    }
+  g_assert_false (event_manager_mark_pending (
+    self, ET_PLUGIN_STATE_CHANGED, &a));
+
+  event_manager_free (self);
+}
+
+static void
+test_object_pool (void)
+{
+  EventManager * self = event_manager_new ();
+
+  ZEvent * evs[EVENT_MANAGER_MAX_EVENTS];
+  for (int i = 0; i < EVENT_MANAGER_MAX_EVENTS; i++)
+    {
+      evs[i] = (ZEvent *) object_pool_get (self->obj_pool);
+      g_assert_nonnull (evs[i]);
+    }
+  g_assert_cmpint (
+    object_pool_get_num_available (self->obj_pool), ==, 0);
+  for (int i = 0; i < EVENT_MANAGER_MAX_EVENTS; i++)
+    {
+      object_pool_return (self->obj_pool, evs[i]);
+    }
+  g_assert_cmpint (
+    object_pool_get_num_available (self->obj_pool), ==,
+    EVENT_MANAGER_MAX_EVENTS);
+
+  event_manager_free (self);
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/gui/backend/event_manager/"
+
+  g_test_add_func (
+    TEST_PREFIX "test mark pending",
+    (GTestFunc) test_mark_pending);
+  g_test_add_func (
+    TEST_PREFIX "test object pool",
+    (GTestFunc) test_object_pool);
+
+  return g_test_run ();
+}
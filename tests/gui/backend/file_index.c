@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "gui/backend/file_index.h"
+#include "utils/io.h"
+#include "utils/objects.h"
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#ifndef _WOE32
+#  include <unistd.h>
+#endif
+
+#include "tests/helpers/zrythm.h"
+
+static void
+assert_dir_entries (
+  FileIndex *   index,
+  const char *  dir,
+  const char ** labels,
+  guint         num_labels)
+{
+  GPtrArray * entries = g_ptr_array_new_with_free_func (
+    (GDestroyNotify) file_index_entry_free);
+  g_assert_true (file_index_get_dir_entries (
+    index, dir, entries, NULL));
+  g_assert_cmpuint (entries->len, ==, num_labels);
+  for (guint i = 0; i < num_labels; i++)
+    {
+      FileIndexEntry * entry =
+        (FileIndexEntry *) g_ptr_array_index (entries, i);
+      g_assert_cmpstr (entry->label, ==, labels[i]);
+    }
+  g_ptr_array_unref (entries);
+}
+
+static void
+test_index (void)
+{
+  test_helper_zrythm_init ();
+
+  char * tmp_dir =
+    g_dir_make_tmp ("zrythm_file_index_XXXXXX", NULL);
+  g_assert_nonnull (tmp_dir);
+  char * sub_dir = g_build_filename (tmp_dir, "sub", NULL);
+  g_assert_cmpint (g_mkdir (sub_dir, 0700), ==, 0);
+
+  char * src_wav =
+    g_build_filename (TESTS_SRCDIR, "test.wav", NULL);
+  char * wav = g_build_filename (sub_dir, "test.wav", NULL);
+  GFile * src_file = g_file_new_for_path (src_wav);
+  GFile * dest_file = g_file_new_for_path (wav);
+  g_assert_true (g_file_copy (
+    src_file, dest_file, G_FILE_COPY_NONE, NULL, NULL,
+    NULL, NULL));
+  g_object_unref (src_file);
+  g_object_unref (dest_file);
+  char * mid = g_build_filename (tmp_dir, "a.mid", NULL);
+  g_assert_true (g_file_set_contents (mid, "", -1, NULL));
+  char * hidden = g_build_filename (tmp_dir, ".hidden", NULL);
+  g_assert_true (g_file_set_contents (hidden, "", -1, NULL));
+  char * index_path =
+    g_build_filename (tmp_dir, "file_index.yaml", NULL);
+
+  /* index recursively */
+  FileIndex * index = file_index_new (index_path);
+  file_index_add_location (index, tmp_dir, true);
+  file_index_wait_until_idle (index);
+
+  const char * top_labels[] = { ".hidden", "a.mid", "sub" };
+  assert_dir_entries (index, tmp_dir, top_labels, 3);
+  const char * sub_labels[] = { "test.wav" };
+  assert_dir_entries (index, sub_dir, sub_labels, 1);
+
+  FileIndexEntry * entry =
+    file_index_get_entry (index, hidden);
+  g_assert_nonnull (entry);
+  g_assert_true (entry->hidden);
+  file_index_entry_free (entry);
+
+  /* audio info is probed */
+  entry = file_index_get_entry (index, wav);
+  g_assert_nonnull (entry);
+  g_assert_cmpint (entry->type, ==, FILE_TYPE_WAV);
+  g_assert_true (entry->have_info);
+  g_assert_cmpint (entry->samplerate, >, 0);
+  g_assert_cmpint (entry->channels, >, 0);
+  file_index_entry_free (entry);
+
+  /* search is case-insensitive and spans
+   * subdirectories */
+  GPtrArray * entries = g_ptr_array_new_with_free_func (
+    (GDestroyNotify) file_index_entry_free);
+  file_index_search (index, "TEST", entries, 10);
+  g_assert_cmpuint (entries->len, ==, 1);
+  entry = (FileIndexEntry *) g_ptr_array_index (entries, 0);
+  g_assert_cmpstr (entry->abs_path, ==, wav);
+  g_ptr_array_set_size (entries, 0);
+
+  /* the index is saved and loaded */
+  file_index_free (index);
+  g_assert_true (
+    g_file_test (index_path, G_FILE_TEST_EXISTS));
+  index = file_index_new (index_path);
+  file_index_wait_until_idle (index);
+  assert_dir_entries (index, tmp_dir, top_labels, 3);
+  assert_dir_entries (index, sub_dir, sub_labels, 1);
+  entry = file_index_get_entry (index, wav);
+  g_assert_nonnull (entry);
+  g_assert_true (entry->have_info);
+  file_index_entry_free (entry);
+
+  /* removed files are removed from the index */
+  unsigned int generation =
+    file_index_get_dir_generation (index, sub_dir);
+  io_remove (wav);
+  file_index_index_dir (index, sub_dir);
+  file_index_wait_until_idle (index);
+  assert_dir_entries (index, sub_dir, NULL, 0);
+  g_assert_cmpuint (
+    file_index_get_dir_generation (index, sub_dir), !=,
+    generation);
+  g_assert_null (file_index_get_entry (index, wav));
+  file_index_search (index, "TEST", entries, 10);
+  g_assert_cmpuint (entries->len, ==, 0);
+
+  /* a directory replaced by a file loses its
+   * listing */
+  io_rmdir (sub_dir, false);
+  g_assert_true (
+    g_file_set_contents (sub_dir, "", -1, NULL));
+  file_index_index_dir (index, tmp_dir);
+  file_index_wait_until_idle (index);
+  g_assert_false (file_index_get_dir_entries (
+    index, sub_dir, entries, NULL));
+  entry = file_index_get_entry (index, sub_dir);
+  g_assert_nonnull (entry);
+  g_assert_cmpint (entry->type, !=, FILE_TYPE_DIR);
+  file_index_entry_free (entry);
+
+  g_ptr_array_unref (entries);
+  file_index_free (index);
+
+  io_remove (index_path);
+  io_remove (hidden);
+  io_remove (mid);
+  io_remove (sub_dir);
+  io_rmdir (tmp_dir, false);
+  g_free (index_path);
+  g_free (hidden);
+  g_free (mid);
+  g_free (wav);
+  g_free (src_wav);
+  g_free (sub_dir);
+  g_free (tmp_dir);
+
+  test_helper_zrythm_cleanup ();
+}
+
+static void
+test_symlink_loop (void)
+{
+#ifndef _WOE32
+  test_helper_zrythm_init ();
+
+  char * tmp_dir =
+    g_dir_make_tmp ("zrythm_file_index_XXXXXX", NULL);
+  g_assert_nonnull (tmp_dir);
+  char * sub_dir = g_build_filename (tmp_dir, "sub", NULL);
+  g_assert_cmpint (g_mkdir (sub_dir, 0700), ==, 0);
+
+  /* link back to the top directory */
+  char * link = g_build_filename (sub_dir, "loop", NULL);
+  g_assert_cmpint (symlink (tmp_dir, link), ==, 0);
+
+  FileIndex * index = file_index_new (NULL);
+  file_index_add_location (index, tmp_dir, true);
+  file_index_wait_until_idle (index);
+
+  /* the link is listed but not descended into */
+  const char * sub_labels[] = { "loop" };
+  assert_dir_entries (index, sub_dir, sub_labels, 1);
+  GPtrArray * entries = g_ptr_array_new_with_free_func (
+    (GDestroyNotify) file_index_entry_free);
+  g_assert_false (
+    file_index_get_dir_entries (index, link, entries, NULL));
+  g_ptr_array_unref (entries);
+
+  file_index_free (index);
+
+  io_remove (link);
+  io_rmdir (sub_dir, false);
+  io_rmdir (tmp_dir, false);
+  g_free (link);
+  g_free (sub_dir);
+  g_free (tmp_dir);
+
+  test_helper_zrythm_cleanup ();
+#endif
+}
+
+static void
+test_search_ranking (void)
+{
+  test_helper_zrythm_init ();
+
+  char * tmp_dir =
+    g_dir_make_tmp ("zrythm_file_index_XXXXXX", NULL);
+  g_assert_nonnull (tmp_dir);
+  const char * names[] = {
+    "a kick.wav", "b kick.wav", "kick", "kick.wav"
+  };
+  for (size_t i = 0; i < G_N_ELEMENTS (names); i++)
+    {
+      char * path =
+        g_build_filename (tmp_dir, names[i], NULL);
+      g_assert_true (
+        g_file_set_contents (path, "", -1, NULL));
+      g_free (path);
+    }
+
+  FileIndex * index = file_index_new (NULL);
+  file_index_add_location (index, tmp_dir, false);
+  file_index_wait_until_idle (index);
+
+  /* the exact and prefix matches are kept even if
+   * other matches sort before them by label */
+  GPtrArray * entries = g_ptr_array_new_with_free_func (
+    (GDestroyNotify) file_index_entry_free);
+  file_index_search (index, "kick", entries, 2);
+  g_assert_cmpuint (entries->len, ==, 2);
+  FileIndexEntry * entry =
+    (FileIndexEntry *) g_ptr_array_index (entries, 0);
+  g_assert_cmpstr (entry->label, ==, "kick");
+  entry = (FileIndexEntry *) g_ptr_array_index (entries, 1);
+  g_assert_cmpstr (entry->label, ==, "kick.wav");
+  g_ptr_array_unref (entries);
+
+  file_index_free (index);
+
+  for (size_t i = 0; i < G_N_ELEMENTS (names); i++)
+    {
+      char * path =
+        g_build_filename (tmp_dir, names[i], NULL);
+      io_remove (path);
+      g_free (path);
+    }
+  io_rmdir (tmp_dir, false);
+  g_free (tmp_dir);
+
+  test_helper_zrythm_cleanup ();
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/gui/backend/file_index/"
+
+  g_test_add_func (
+    TEST_PREFIX "test index", (GTestFunc) test_index);
+  g_test_add_func (
+    TEST_PREFIX "test symlink loop",
+    (GTestFunc) test_symlink_loop);
+  g_test_add_func (
+    TEST_PREFIX "test search ranking",
+    (GTestFunc) test_search_ranking);
+
+  return g_test_run ();
+}
@@ -20,6 +20,7 @@
 #include "audio/marker_track.h"
 #include "audio/master_track.h"
 #include "audio/midi_note.h"
+#include "audio/midi_region.h"
 #include "audio/modulator_track.h"
 #include "audio/recording_manager.h"
 #include "audio/region.h"
@@ -108,6 +109,27 @@ test_project_rebootstrap_timeline (
   Position * p1,
   Position * p2);
 
+/**
+ * Adds a MIDI region from bar 1 to bar 9 with
+ * @p num_notes consecutive quarter notes to the
+ * track.
+ *
+ * @param pitch_offset Offset of the note pitches,
+ *   so that tracks can have different notes.
+ */
+void
+test_project_add_midi_region_with_notes (
+  Track * track,
+  int     num_notes,
+  int     pitch_offset);
+
+/**
+ * Adds an audio region of test.wav at bar 1 to the
+ * track.
+ */
+void
+test_project_add_audio_region (Track * track);
+
 char *
 test_project_save (void)
 {
@@ -456,6 +478,49 @@ test_project_rebootstrap_timeline (Position * p1, Position * p2)
   test_project_save_and_reload ();
 }
 
+void
+test_project_add_midi_region_with_notes (
+  Track * track,
+  int     num_notes,
+  int     pitch_offset)
+{
+  Position start, end;
+  position_set_to_bar (&start, 1);
+  position_set_to_bar (&end, 9);
+  ZRegion * r = midi_region_new (
+    &start, &end, track_get_name_hash (track), 0, 0);
+  track_add_region (
+    track, r, NULL, 0, F_GEN_NAME, F_NO_PUBLISH_EVENTS);
+  for (int j = 0; j < num_notes; j++)
+    {
+      Position note_start, note_end;
+      position_from_ticks (
+        &note_start, j * TICKS_PER_QUARTER_NOTE);
+      position_from_ticks (
+        &note_end, (j + 1) * TICKS_PER_QUARTER_NOTE - 1);
+      MidiNote * mn = midi_note_new (
+        &r->id, &note_start, &note_end,
+        (uint8_t) (36 + (pitch_offset + j) % 48), 90);
+      midi_region_add_midi_note (
+        r, mn, F_NO_PUBLISH_EVENTS);
+    }
+}
+
+void
+test_project_add_audio_region (Track * track)
+{
+  Position start;
+  position_set_to_bar (&start, 1);
+  char * audio_file_path = g_build_filename (
+    TESTS_SRCDIR, "test.wav", NULL);
+  ZRegion * r = audio_region_new (
+    -1, audio_file_path, true, NULL, 0, NULL, 0, 0,
+    &start, track_get_name_hash (track), 0, 0);
+  g_free (audio_file_path);
+  track_add_region (
+    track, r, NULL, 0, F_GEN_NAME, F_NO_PUBLISH_EVENTS);
+}
+
 /**
  * Stop dummy audio engine processing so we can
  * process manually.
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "audio/engine.h"
+#include "audio/track.h"
+#include "audio/tracklist.h"
+#include "audio/transport.h"
+#include "project.h"
+#include "utils/rt_checker.h"
+#include "zrythm.h"
+
+#include <glib.h>
+
+#include "tests/helpers/project.h"
+#include "tests/helpers/zrythm.h"
+
+#define NUM_MIDI_TRACKS 16
+#define NUM_AUDIO_TRACKS 8
+#define NUM_NOTES 32
+
+static Track *
+create_track (TrackType type)
+{
+  Track * track =
+    track_create_empty_with_action (type, NULL);
+  g_assert_nonnull (track);
+
+  return track;
+}
+
+/**
+ * Creates MIDI tracks with many notes and audio
+ * tracks with audio regions.
+ */
+static void
+generate_project (void)
+{
+  for (int i = 0; i < NUM_MIDI_TRACKS; i++)
+    {
+      Track * track = create_track (TRACK_TYPE_MIDI);
+      test_project_add_midi_region_with_notes (
+        track, NUM_NOTES, i);
+    }
+
+  for (int i = 0; i < NUM_AUDIO_TRACKS; i++)
+    {
+      Track * track = create_track (TRACK_TYPE_AUDIO);
+      test_project_add_audio_region (track);
+    }
+}
+
+/**
+ * Plays a generated project with the dummy engine
+ * and fails on any allocation, lock or file I/O in
+ * the processing threads.
+ */
+static void
+test_no_rt_violations (void)
+{
+  if (!rt_checker_is_available ())
+    {
+      g_test_skip ("zrythm built without rt_checker");
+      return;
+    }
+
+  test_helper_zrythm_init ();
+
+  generate_project ();
+
+  transport_request_roll (TRANSPORT, true);
+
+  /* let first-time setup happen */
+  engine_wait_n_cycles (AUDIO_ENGINE, 8);
+  rt_checker_clear ();
+
+  engine_wait_n_cycles (AUDIO_ENGINE, 200);
+
+  test_project_stop_dummy_engine ();
+
+  int num_violations = rt_checker_get_num_violations ();
+  if (num_violations > 0)
+    {
+      char * report = rt_checker_get_report ();
+      g_message ("%s", report);
+      g_free (report);
+    }
+  g_assert_cmpint (num_violations, ==, 0);
+
+  test_helper_zrythm_cleanup ();
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/integration/rt_checker/"
+
+  g_test_add_func (
+    TEST_PREFIX "test no rt violations",
+    (GTestFunc) test_no_rt_violations);
+
+  return g_test_run ();
+}
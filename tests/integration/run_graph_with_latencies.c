@@ -120,7 +120,17 @@ _test (
   g_assert_cmpint (latency2, >, 0);
   g_assert_cmpint (latency2, >, latency);
 
-  /* recalculate graph to update latencies */
+  /* update only the affected routes */
+  GPtrArray * plugins = g_ptr_array_new ();
+  g_ptr_array_add (plugins, pl);
+  router_update_plugin_latencies (ROUTER, plugins);
+  node = graph_find_node_from_track (
+    ROUTER->graph, P_TEMPO_TRACK, false);
+  g_assert_true (node);
+  g_assert_cmpint (latency2, ==, node->route_playback_latency);
+
+  /* check that a full recalculation gives the same
+   * result */
   router_recalc_graph (ROUTER, F_SOFT);
   node = graph_find_node_from_track (
     ROUTER->graph, P_TEMPO_TRACK, false);
@@ -156,6 +166,17 @@ _test (
   g_usleep (1000000);
   g_assert_cmpint (pl->latency, ==, 0);
 
+  /* update only the affected routes */
+  g_ptr_array_remove_range (plugins, 0, plugins->len);
+  g_ptr_array_add (plugins, pl);
+  g_ptr_array_add (plugins, new_track->channel->inserts[0]);
+  router_update_plugin_latencies (ROUTER, plugins);
+  g_ptr_array_unref (plugins);
+  node = graph_find_node_from_track (
+    ROUTER->graph, P_TEMPO_TRACK, false);
+  g_assert_true (node);
+  g_assert_cmpint (node->route_playback_latency, ==, 0);
+
   /* recalculate graph to update latencies */
   router_recalc_graph (ROUTER, F_SOFT);
   node = graph_find_node_from_track (
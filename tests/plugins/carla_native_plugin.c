@@ -196,6 +196,60 @@ test_process (void)
 #endif
 }
 
+static void
+test_bridge_all_plugins (void)
+{
+#if defined(HAVE_CARLA) && defined(HAVE_LSP_COMPRESSOR)
+  test_helper_zrythm_init ();
+
+  /* stop dummy audio engine processing so we can
+   * process manually */
+  AUDIO_ENGINE->stop_dummy_audio_thread = true;
+  g_usleep (1000000);
+
+  g_setenv ("ZRYTHM_BRIDGE_ALL_PLUGINS", "1", true);
+
+  PluginSetting * setting =
+    test_plugin_manager_get_plugin_setting (
+      LSP_COMPRESSOR_BUNDLE, LSP_COMPRESSOR_URI, false);
+  g_return_if_fail (setting);
+
+  /* validating the setting does not apply the
+   * override */
+  g_assert_false (setting->open_with_carla);
+
+  track_create_for_plugin_at_idx_w_action (
+    TRACK_TYPE_AUDIO_BUS, setting, TRACKLIST->num_tracks,
+    NULL);
+  Plugin * pl =
+    TRACKLIST->tracks[TRACKLIST->num_tracks - 1]
+      ->channel->inserts[0];
+  g_assert_true (IS_PLUGIN_AND_NONNULL (pl));
+  g_assert_true (pl->setting->open_with_carla);
+  g_assert_cmpint (
+    pl->setting->bridge_mode, ==, CARLA_BRIDGE_FULL);
+  g_assert_false (setting->open_with_carla);
+
+  engine_process (AUDIO_ENGINE, AUDIO_ENGINE->block_length);
+  engine_process (AUDIO_ENGINE, AUDIO_ENGINE->block_length);
+  engine_process (AUDIO_ENGINE, AUDIO_ENGINE->block_length);
+
+  /* check the measured round trips */
+  CarlaNativePluginProcessStats stats;
+  carla_native_plugin_get_process_stats (pl->carla, &stats);
+  g_assert_cmpint (stats.num_cycles, >=, 3);
+  g_assert_cmpfloat (stats.avg_us, >=, 0.0);
+  g_assert_cmpfloat (
+    (double) stats.max_us, >=, floor (stats.avg_us));
+  g_assert_cmpint (
+    stats.num_overruns, <=, stats.num_cycles);
+
+  g_unsetenv ("ZRYTHM_BRIDGE_ALL_PLUGINS");
+
+  test_helper_zrythm_cleanup ();
+#endif
+}
+
 int
 main (int argc, char * argv[])
 {
@@ -216,6 +270,9 @@ main (int argc, char * argv[])
   g_test_add_func (
     TEST_PREFIX "test crash handling",
     (GTestFunc) test_crash_handling);
+  g_test_add_func (
+    TEST_PREFIX "test bridge all plugins",
+    (GTestFunc) test_bridge_all_plugins);
 
   return g_test_run ();
 }
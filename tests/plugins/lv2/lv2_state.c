@@ -21,8 +21,11 @@
 
 #include <stdlib.h>
 
+#include "audio/port.h"
 #include "plugins/lv2/lv2_state.h"
 #include "plugins/lv2_plugin.h"
+#include "utils/flags.h"
+#include "utils/math.h"
 #include "utils/string.h"
 
 #include <glib.h>
@@ -70,6 +73,106 @@ test_path_features (void)
 }
 #endif
 
+/**
+ * Replaces the state file with a marker, so that it
+ * can be checked whether the state is rewritten.
+ */
+static char *
+replace_state_file_w_marker (Plugin * pl)
+{
+  char * state_dir =
+    plugin_get_abs_state_dir (pl, F_NOT_BACKUP);
+  char * state_file =
+    g_build_filename (state_dir, "state.ttl", NULL);
+  g_assert_true (
+    g_file_test (state_file, G_FILE_TEST_EXISTS));
+  GError * err = NULL;
+  bool     ret =
+    g_file_set_contents (state_file, "marker", -1, &err);
+  g_assert_no_error (err);
+  g_assert_true (ret);
+  g_free (state_dir);
+
+  return state_file;
+}
+
+static bool
+state_file_has_marker (const char * state_file)
+{
+  char *   contents = NULL;
+  GError * err = NULL;
+  bool     ret = g_file_get_contents (
+        state_file, &contents, NULL, &err);
+  g_assert_no_error (err);
+  g_assert_true (ret);
+  bool has_marker = string_is_equal (contents, "marker");
+  g_free (contents);
+
+  return has_marker;
+}
+
+static void
+test_skip_unchanged_state (void)
+{
+#ifdef HAVE_LSP_COMPRESSOR
+  test_helper_zrythm_init ();
+
+  test_plugin_manager_create_tracks_from_plugin (
+    LSP_COMPRESSOR_BUNDLE, LSP_COMPRESSOR_URI, false,
+    false, 1);
+  Track * track =
+    TRACKLIST->tracks[TRACKLIST->num_tracks - 1];
+  Plugin * pl = track->channel->inserts[0];
+  g_assert_true (IS_PLUGIN_AND_NONNULL (pl));
+
+  LilvState * state =
+    lv2_state_snapshot (pl->lv2, F_NOT_BACKUP);
+  g_assert_nonnull (state);
+  g_assert_true (lv2_state_write_snapshot (
+    pl->lv2, state, F_NOT_BACKUP));
+  char * state_file = replace_state_file_w_marker (pl);
+
+  /* an unchanged state is not rewritten */
+  state = lv2_state_snapshot (pl->lv2, F_NOT_BACKUP);
+  g_assert_nonnull (state);
+  g_assert_true (lv2_state_write_snapshot (
+    pl->lv2, state, F_NOT_BACKUP));
+  g_assert_true (state_file_has_marker (state_file));
+
+  /* change a parameter */
+  Port * port = NULL;
+  for (int i = 0; i < pl->num_in_ports; i++)
+    {
+      Port * cur = pl->in_ports[i];
+      if (
+        cur->id.type == TYPE_CONTROL
+        && !(cur->id.flags & PORT_FLAG_GENERIC_PLUGIN_PORT))
+        {
+          port = cur;
+          break;
+        }
+    }
+  g_assert_nonnull (port);
+  port_set_control_value (
+    port,
+    math_floats_equal (port->control, port->maxf)
+      ? port->minf
+      : port->maxf,
+    F_NOT_NORMALIZED, F_NO_PUBLISH_EVENTS);
+
+  /* a changed state is rewritten */
+  state = lv2_state_snapshot (pl->lv2, F_NOT_BACKUP);
+  g_assert_nonnull (state);
+  g_assert_true (lv2_state_write_snapshot (
+    pl->lv2, state, F_NOT_BACKUP));
+  g_assert_false (state_file_has_marker (state_file));
+
+  g_free (state_file);
+
+  test_helper_zrythm_cleanup ();
+#endif
+}
+
 int
 main (int argc, char * argv[])
 {
@@ -77,6 +180,10 @@ main (int argc, char * argv[])
 
 #define TEST_PREFIX "/plugins/lv2_plugin/"
 
+  g_test_add_func (
+    TEST_PREFIX "test skip unchanged state",
+    (GTestFunc) test_skip_unchanged_state);
+
 #if 0
   g_test_add_func (
     TEST_PREFIX "test path features",
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "plugins/lv2/lv2_worker.h"
+#include "plugins/lv2_plugin.h"
+#include "plugins/plugin.h"
+#include "settings/plugin_settings.h"
+
+#include <glib.h>
+
+#include "helpers/zrythm.h"
+
+#define NUM_REQUESTS 20
+
+/** Values passed to work(), in order. */
+static int  worked_vals[NUM_REQUESTS];
+static gint num_worked = 0;
+static int  num_responses = 0;
+static int  last_response = -1;
+
+static LV2_Worker_Status
+work (
+  LV2_Handle                  instance,
+  LV2_Worker_Respond_Function respond,
+  LV2_Worker_Respond_Handle   handle,
+  uint32_t                    size,
+  const void *                data)
+{
+  g_assert_cmpuint (size, ==, sizeof (int));
+  int val = *(const int *) data;
+  worked_vals[g_atomic_int_get (&num_worked)] = val;
+  respond (handle, size, data);
+  g_atomic_int_inc (&num_worked);
+  return LV2_WORKER_SUCCESS;
+}
+
+static LV2_Worker_Status
+work_response (
+  LV2_Handle   instance,
+  uint32_t     size,
+  const void * body)
+{
+  int val = *(const int *) body;
+  g_assert_cmpint (val, ==, last_response + 1);
+  last_response = val;
+  num_responses++;
+  return LV2_WORKER_SUCCESS;
+}
+
+static void
+test_pool (void)
+{
+  test_helper_zrythm_init ();
+
+  /* minimal plugin for the worker */
+  PluginDescriptor descr = { 0 };
+  descr.name = "Worker test";
+  PluginSetting setting = { 0 };
+  setting.descr = &descr;
+  Plugin pl = { 0 };
+  pl.setting = &setting;
+  LilvInstance instance = { 0 };
+  Lv2Plugin lv2 = { 0 };
+  lv2.plugin = &pl;
+  lv2.instance = &instance;
+  zix_sem_init (&lv2.work_lock, 1);
+  lv2.worker.plugin = &lv2;
+
+  const LV2_Worker_Interface iface = {
+    .work = work,
+    .work_response = work_response,
+  };
+
+  Lv2WorkerPool * pool = lv2_worker_pool_new (2);
+  lv2_worker_init (&lv2, &lv2.worker, &iface, pool, true);
+
+  for (int i = 0; i < NUM_REQUESTS; i++)
+    {
+      LV2_Worker_Status status = lv2_worker_schedule (
+        &lv2.worker, sizeof (int), &i);
+      g_assert_cmpint (status, ==, LV2_WORKER_SUCCESS);
+    }
+
+  /* wait for the pool to service all requests */
+  gint64 end_time =
+    g_get_monotonic_time () + 10 * G_USEC_PER_SEC;
+  while (g_atomic_int_get (&num_worked) < NUM_REQUESTS)
+    {
+      g_assert_cmpint (
+        g_get_monotonic_time (), <, end_time);
+      g_usleep (1000);
+    }
+
+  /* requests of an instance are run in order */
+  for (int i = 0; i < NUM_REQUESTS; i++)
+    {
+      g_assert_cmpint (worked_vals[i], ==, i);
+    }
+
+  lv2_worker_emit_responses (&lv2.worker, &instance);
+  g_assert_cmpint (num_responses, ==, NUM_REQUESTS);
+
+  Lv2WorkerPoolStats stats;
+  lv2_worker_pool_get_stats (pool, &stats);
+  g_assert_cmpint (stats.queue_depth, ==, 0);
+  g_assert_cmpint (stats.num_serviced, ==, NUM_REQUESTS);
+  g_assert_cmpint (stats.avg_latency_us, >=, 0);
+  g_assert_cmpint (
+    stats.max_latency_us, >=, stats.avg_latency_us);
+  g_assert_cmpint (stats.num_dropped, ==, 0);
+
+  lv2.exit = true;
+  lv2_worker_finish (&lv2.worker);
+  lv2_worker_pool_free (pool);
+  zix_sem_destroy (&lv2.work_lock);
+
+  test_helper_zrythm_cleanup ();
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/plugins/lv2/lv2_worker/"
+
+  g_test_add_func (
+    TEST_PREFIX "test pool", (GTestFunc) test_pool);
+
+  return g_test_run ();
+}
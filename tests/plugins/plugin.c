@@ -199,6 +199,76 @@ test_bypass_state_after_project_load (void)
 #endif
 }
 
+static void
+test_control_changes_batched (void)
+{
+#ifdef HAVE_LSP_COMPRESSOR
+  test_helper_zrythm_init ();
+
+  /* stop dummy audio engine processing so we can
+   * process manually */
+  test_project_stop_dummy_engine ();
+
+  for (int i = 0;
+#  ifdef HAVE_CARLA
+       i < 2;
+#  else
+       i < 1;
+#  endif
+       i++)
+    {
+      test_plugin_manager_create_tracks_from_plugin (
+        LSP_COMPRESSOR_BUNDLE, LSP_COMPRESSOR_URI, false,
+        i == 1, 1);
+      Track * track =
+        TRACKLIST->tracks[TRACKLIST->num_tracks - 1];
+      Plugin * pl = track->channel->inserts[0];
+      g_assert_true (IS_PLUGIN_AND_NONNULL (pl));
+
+      engine_process (
+        AUDIO_ENGINE, AUDIO_ENGINE->block_length);
+
+      /* change all plugin parameters a few times */
+      for (int j = 0; j < 4; j++)
+        {
+          for (size_t k = 0; k < pl->ctrl_in_ports->len; k++)
+            {
+              Port * port =
+                g_ptr_array_index (pl->ctrl_in_ports, k);
+              if (
+                port->id.flags
+                & PORT_FLAG_GENERIC_PLUGIN_PORT)
+                continue;
+
+              port_set_control_value (
+                port, (float) j / 4.f, F_NORMALIZED,
+                F_PUBLISH_EVENTS);
+              g_assert_true (g_atomic_int_get (
+                &port->plugin_change_pending));
+            }
+        }
+      g_assert_true (
+        g_atomic_int_get (&pl->control_changes_pending));
+
+      /* check that they are all delivered in the
+       * next cycle */
+      engine_process (
+        AUDIO_ENGINE, AUDIO_ENGINE->block_length);
+      g_assert_false (
+        g_atomic_int_get (&pl->control_changes_pending));
+      for (size_t k = 0; k < pl->ctrl_in_ports->len; k++)
+        {
+          Port * port =
+            g_ptr_array_index (pl->ctrl_in_ports, k);
+          g_assert_false (g_atomic_int_get (
+            &port->plugin_change_pending));
+        }
+    }
+
+  test_helper_zrythm_cleanup ();
+#endif
+}
+
 int
 main (int argc, char * argv[])
 {
@@ -208,6 +278,9 @@ main (int argc, char * argv[])
 
 #define TEST_PREFIX "/plugins/plugin/"
 
+  g_test_add_func (
+    TEST_PREFIX "test control changes batched",
+    (GTestFunc) test_control_changes_batched);
   g_test_add_func (
     TEST_PREFIX "test bypass state after project load",
     (GTestFunc) test_bypass_state_after_project_load);
@@ -19,7 +19,10 @@
 
 #include "zrythm-test-config.h"
 
+#include "plugins/cached_plugin_descriptors.h"
 #include "plugins/plugin_manager.h"
+#include "utils/flags.h"
+#include "utils/io.h"
 
 #include "tests/helpers/plugin_manager.h"
 #include "tests/helpers/zrythm.h"
@@ -46,6 +49,106 @@ test_find_plugins (void)
 #endif
 }
 
+static void
+test_cached_descriptors_invalidation (void)
+{
+  CachedPluginDescriptors * cache =
+    PLUGIN_MANAGER->cached_plugin_descriptors;
+
+  char * tmp_dir =
+    g_dir_make_tmp ("zrythm_cached_descr_XXXXXX", NULL);
+  char * path =
+    g_build_filename (tmp_dir, "plugin.so", NULL);
+  g_assert_true (g_file_set_contents (path, "abc", -1, NULL));
+
+  PluginDescriptor * descr = plugin_descriptor_new ();
+  descr->protocol = PROT_VST;
+  descr->path = g_strdup (path);
+  descr->name = g_strdup ("Test plugin");
+  cached_plugin_descriptors_add (
+    cache, descr, F_NO_SERIALIZE);
+
+  /* unchanged file returns the cached descriptor */
+  PluginDescriptor ** descrs =
+    cached_plugin_descriptors_get (cache, path);
+  g_assert_nonnull (descrs);
+  g_assert_nonnull (descrs[0]);
+  g_assert_null (descrs[1]);
+  g_assert_cmpstr (descrs[0]->name, ==, "Test plugin");
+  free (descrs);
+
+  /* changed file invalidates the cached
+   * descriptor */
+  g_assert_true (
+    g_file_set_contents (path, "abcdef", -1, NULL));
+  g_assert_null (cached_plugin_descriptors_get (cache, path));
+
+  /* same for blacklisted plugins */
+  cached_plugin_descriptors_blacklist (
+    cache, path, F_NO_SERIALIZE);
+  g_assert_true (
+    cached_plugin_descriptors_is_blacklisted (cache, path));
+  g_assert_true (g_file_set_contents (path, "a", -1, NULL));
+  g_assert_false (
+    cached_plugin_descriptors_is_blacklisted (cache, path));
+
+  plugin_descriptor_free (descr);
+  io_rmdir (tmp_dir, true);
+  g_free (path);
+  g_free (tmp_dir);
+}
+
+static void
+test_cached_descriptors_remove_missing (void)
+{
+  CachedPluginDescriptors * cache =
+    cached_plugin_descriptors_new ();
+  g_assert_nonnull (cache);
+
+  char * tmp_dir =
+    g_dir_make_tmp ("zrythm_cached_descr_XXXXXX", NULL);
+  char * path =
+    g_build_filename (tmp_dir, "plugin.so", NULL);
+  char * removed_path =
+    g_build_filename (tmp_dir, "removed.so", NULL);
+  g_assert_true (g_file_set_contents (path, "abc", -1, NULL));
+  g_assert_true (
+    g_file_set_contents (removed_path, "abc", -1, NULL));
+
+  PluginDescriptor * descr = plugin_descriptor_new ();
+  descr->protocol = PROT_VST;
+  descr->path = g_strdup (path);
+  descr->name = g_strdup ("Test plugin");
+  cached_plugin_descriptors_add (
+    cache, descr, F_NO_SERIALIZE);
+  cached_plugin_descriptors_blacklist (
+    cache, removed_path, F_NO_SERIALIZE);
+
+  /* only the plugin at path was found */
+  GHashTable * found_keys =
+    g_hash_table_new (g_str_hash, g_str_equal);
+  g_hash_table_add (found_keys, path);
+  g_assert_true (cached_plugin_descriptors_remove_missing (
+    cache, found_keys));
+  g_assert_false (cached_plugin_descriptors_remove_missing (
+    cache, found_keys));
+  g_hash_table_unref (found_keys);
+
+  PluginDescriptor ** descrs =
+    cached_plugin_descriptors_get (cache, path);
+  g_assert_nonnull (descrs);
+  free (descrs);
+  g_assert_false (cached_plugin_descriptors_is_blacklisted (
+    cache, removed_path));
+
+  cached_plugin_descriptors_free (cache);
+  plugin_descriptor_free (descr);
+  io_rmdir (tmp_dir, true);
+  g_free (path);
+  g_free (removed_path);
+  g_free (tmp_dir);
+}
+
 int
 main (int argc, char * argv[])
 {
@@ -59,6 +162,12 @@ main (int argc, char * argv[])
   g_test_add_func (
     TEST_PREFIX "test find plugins",
     (GTestFunc) test_find_plugins);
+  g_test_add_func (
+    TEST_PREFIX "test cached descriptors invalidation",
+    (GTestFunc) test_cached_descriptors_invalidation);
+  g_test_add_func (
+    TEST_PREFIX "test cached descriptors remove missing",
+    (GTestFunc) test_cached_descriptors_remove_missing);
 
   return g_test_run ();
 }
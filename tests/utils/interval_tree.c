@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "utils/interval_tree.h"
+
+#include <glib.h>
+
+#define NUM_INTERVALS 5000
+
+static void
+test_query (void)
+{
+  IntervalTree * tree = interval_tree_new ();
+
+  double * starts = g_new (double, NUM_INTERVALS);
+  double * ends = g_new (double, NUM_INTERVALS);
+  for (size_t i = 0; i < NUM_INTERVALS; i++)
+    {
+      starts[i] = g_random_double_range (0.0, 10000.0);
+      ends[i] =
+        starts[i]
+        + (i % 10 == 0
+             ? g_random_double_range (0.0, 3000.0)
+             : g_random_double_range (0.0, 20.0));
+      interval_tree_add (
+        tree, starts[i], ends[i], GSIZE_TO_POINTER (i));
+    }
+
+  GPtrArray * arr = g_ptr_array_new ();
+  for (int i = 0; i < 200; i++)
+    {
+      double start =
+        g_random_double_range (-100.0, 10100.0);
+      double end =
+        start
+        + (i % 2 == 0
+             ? 0.0
+             : g_random_double_range (0.0, 500.0));
+      g_ptr_array_set_size (arr, 0);
+      interval_tree_query (tree, start, end, arr);
+
+      /* same results and order as a linear scan */
+      guint num_found = 0;
+      for (size_t j = 0; j < NUM_INTERVALS; j++)
+        {
+          if (starts[j] > end || ends[j] < start)
+            continue;
+
+          g_assert_cmpuint (num_found, <, arr->len);
+          g_assert_cmpuint (
+            GPOINTER_TO_SIZE (
+              g_ptr_array_index (arr, num_found)),
+            ==, j);
+          num_found++;
+        }
+      g_assert_cmpuint (num_found, ==, arr->len);
+    }
+
+  /* clearing and adding again */
+  interval_tree_clear (tree);
+  g_ptr_array_set_size (arr, 0);
+  interval_tree_query (tree, 0.0, 10000.0, arr);
+  g_assert_cmpuint (arr->len, ==, 0);
+  interval_tree_add (tree, 5.0, 5.0, GSIZE_TO_POINTER (1));
+  interval_tree_query (tree, 5.0, 6.0, arr);
+  g_assert_cmpuint (arr->len, ==, 1);
+
+  g_ptr_array_unref (arr);
+  g_free (starts);
+  g_free (ends);
+  interval_tree_free (tree);
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/utils/interval_tree/"
+
+  g_test_add_func (
+    TEST_PREFIX "test query", (GTestFunc) test_query);
+
+  return g_test_run ();
+}
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include <string.h>
+
+#include "utils/log.h"
+
+#include <glib.h>
+
+#include "helpers/zrythm.h"
+
+static void
+test_format_rt_record (void)
+{
+  LogRtRecord rec = { 0 };
+  rec.fmt = "%s: %5.1f %zu%% %d %s";
+  rec.num_args = 4;
+  strcpy (rec.strs, "Audio 1");
+  rec.args[0] = log_rt_arg_str (NULL);
+  rec.args[0].val.str_offset = 0;
+  rec.args[1] = log_rt_arg_double (2.5);
+  rec.args[2] = log_rt_arg_uint (100);
+  /* mismatched type */
+  rec.args[3] = log_rt_arg_double (1.0);
+
+  GString * buf = g_string_new (NULL);
+  log_rt_record_format (&rec, buf);
+  g_assert_cmpstr (
+    buf->str, ==, "Audio 1:   2.5 100% (?) (?)");
+  g_string_free (buf, true);
+}
+
+static void *
+log_from_thread (void * data)
+{
+  const char * name = "Audio 1";
+  size_t       idx = 3;
+  log_rt_message ("rt message from %s (%zu)", name, idx);
+
+  /* overflow the ring */
+  for (int i = 0; i < 1000; i++)
+    {
+      log_rt_message ("rt flood %d", i);
+    }
+
+  return NULL;
+}
+
+static void
+test_log_rt (void)
+{
+  test_helper_zrythm_init ();
+
+  GThread * thread =
+    g_thread_new ("rt", log_from_thread, NULL);
+  g_thread_join (thread);
+
+  /* wait for the log thread to format the
+   * messages */
+  gint64 end_time =
+    g_get_monotonic_time () + 10 * G_USEC_PER_SEC;
+  while (true)
+    {
+      char * lines = log_get_last_n_lines (LOG, 2000);
+      bool   found =
+        strstr (lines, "rt message from Audio 1 (3)")
+        && strstr (lines, "rt flood 0")
+        && strstr (lines, "real-time log messages dropped");
+      g_free (lines);
+      if (found)
+        break;
+
+      g_assert_cmpint (
+        g_get_monotonic_time (), <, end_time);
+      g_usleep (10000);
+    }
+
+  test_helper_zrythm_cleanup ();
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/utils/log/"
+
+  g_test_add_func (
+    TEST_PREFIX "test format rt record",
+    (GTestFunc) test_format_rt_record);
+  g_test_add_func (
+    TEST_PREFIX "test log rt", (GTestFunc) test_log_rt);
+
+  return g_test_run ();
+}
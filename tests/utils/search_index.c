@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: © 2022 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "zrythm-test-config.h"
+
+#include "utils/search_index.h"
+#include "utils/string.h"
+
+#include <glib.h>
+
+#define NUM_ITEMS 2000
+
+static const char * words[] = {
+  "Reverb", "Delay", "Synth", "Compressor", "EQ",
+  "Chorus", "Piano", "Drum", "Bass",       "Limiter",
+};
+
+/**
+ * Checks the matches against a linear scan.
+ */
+static void
+assert_matches (
+  SearchIndex * index,
+  char **       texts,
+  const char *  query)
+{
+  char ** tokens = g_strsplit (query, " ", -1);
+  for (size_t i = 0; i < NUM_ITEMS; i++)
+    {
+      bool expected = true;
+      for (char ** token = tokens; *token; token++)
+        {
+          if (
+            **token
+            && !string_contains_substr_case_insensitive (
+              texts[i], *token))
+            {
+              expected = false;
+            }
+        }
+      g_assert_cmpint (
+        search_index_matches (index, texts[i]), ==,
+        expected);
+    }
+  g_strfreev (tokens);
+}
+
+static void
+test_search (void)
+{
+  SearchIndex * index = search_index_new ();
+
+  char ** texts = g_new (char *, NUM_ITEMS);
+  for (size_t i = 0; i < NUM_ITEMS; i++)
+    {
+      texts[i] = g_strdup_printf (
+        "%s %s %zu\nAuthor %zu\n%s",
+        words[i % G_N_ELEMENTS (words)],
+        words[(i / 10) % G_N_ELEMENTS (words)], i, i % 7,
+        words[(i / 100) % G_N_ELEMENTS (words)]);
+      search_index_add (index, texts[i], texts[i]);
+    }
+
+  /* no query matches everything */
+  g_assert_true (search_index_matches (index, texts[0]));
+  g_assert_cmpint (
+    search_index_set_query (index, ""), ==,
+    SEARCH_INDEX_CHANGE_NONE);
+
+  /* typing narrows the matches */
+  const char * typed[] = {
+    "r", "re", "rev", "reve", "reverb", "reverb ",
+    "reverb d", "reverb dela", "reverb delay 1",
+  };
+  for (size_t i = 0; i < G_N_ELEMENTS (typed); i++)
+    {
+      SearchIndexChange change =
+        search_index_set_query (index, typed[i]);
+      g_assert_cmpint (
+        change, ==,
+        i == 5
+          ? SEARCH_INDEX_CHANGE_NONE
+          : SEARCH_INDEX_CHANGE_MORE_STRICT);
+      assert_matches (index, texts, typed[i]);
+    }
+
+  /* case-insensitive and across fields */
+  g_assert_cmpint (
+    search_index_set_query (index, "AUTHOR 3"), ==,
+    SEARCH_INDEX_CHANGE_DIFFERENT);
+  assert_matches (index, texts, "AUTHOR 3");
+  g_assert_cmpint (
+    search_index_set_query (index, "AUTHOR"), ==,
+    SEARCH_INDEX_CHANGE_LESS_STRICT);
+  assert_matches (index, texts, "AUTHOR");
+
+  /* no matches */
+  search_index_set_query (index, "xyz");
+  assert_matches (index, texts, "xyz");
+  g_assert_false (search_index_matches (index, texts[0]));
+
+  /* clearing the query matches everything again */
+  g_assert_cmpint (
+    search_index_set_query (index, NULL), ==,
+    SEARCH_INDEX_CHANGE_LESS_STRICT);
+  assert_matches (index, texts, "");
+
+  /* items added after the query are matched */
+  search_index_set_query (index, "Piano");
+  char * extra = g_strdup ("Grand Piano");
+  search_index_add (index, extra, extra);
+  g_assert_true (search_index_matches (index, extra));
+  g_free (extra);
+
+  search_index_free (index);
+  for (size_t i = 0; i < NUM_ITEMS; i++)
+    {
+      g_free (texts[i]);
+    }
+  g_free (texts);
+}
+
+int
+main (int argc, char * argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+#define TEST_PREFIX "/utils/search_index/"
+
+  g_test_add_func (
+    TEST_PREFIX "test search", (GTestFunc) test_search);
+
+  return g_test_run ();
+}